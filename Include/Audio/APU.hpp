@@ -1,23 +1,55 @@
 #pragma once
 #include <array>
+#include <atomic>
 #include <map>
-#include "SDL.h"
+#include <memory>
 #include "Audio/ToneSoundChannel.hpp"
 #include "Audio/SweepSoundChannel.hpp"
 #include "Audio/WaveSoundChannel.hpp"
 #include "Audio/NoiseSoundChannel.hpp"
 #include "Audio/AudioTimer.hpp"
+#include "Audio/BlipBuffer.hpp"
+#include "Audio/AudioSink.hpp"
+#include "Audio/AudioCaptureBuffer.hpp"
+#include "Audio/AudioMetrics.hpp"
 
 namespace ModestGB
 {
+	// Capture sources 0 to 3 are the individual channels.
+	const uint8_t AUDIO_CAPTURE_MIXED_OUTPUT = 4;
+	const uint8_t AUDIO_CAPTURE_SOURCE_COUNT = 5;
+
 	class APU
 	{
 	public:
-		void Initialize();
+		// Number of samples (not frames) handed to the sink at once.
+		static const uint32_t SAMPLE_BLOCK_SIZE = 4096;
+		// Maximum number of frames each blip buffer can hold, i.e. produce in one blip frame.
+		static const uint32_t BLIP_BUFFER_CAPACITY = 512;
+
+		// Falls back to discarding the audio if [audioSink] can't be opened.
+		void Initialize(std::unique_ptr<AudioSink> audioSink);
+		void Quit();
+
+		// Only records the elapsed cycles. The channels are run in bulk by CatchUp().
 		void Tick(uint32_t cycles);
+
+		// Runs the APU up to the current cycle. Must be called before any sound register is accessed, 
+		// and at the end of every frame so the samples are delivered on time.
+		void CatchUp();
 		void RefreshOutputDevices();
+
+		// While the output is suspended, the channels keep running but don't produce any sound, and the blip buffers 
+		// are left as they are. Used to emulate frames that are thrown away afterwards (by restoring a state).
+		void SetOutputSuspended(bool isSuspended);
+		bool IsOutputSuspended() const;
 		void Reset();
 
+		// Saves the emulated state only. Any cycles that haven't been caught up on are saved as well, so a state 
+		// can be taken at any point. The output (volume, sink, capture) is configuration and isn't included.
+		void Serialize(StateWriter& writer) const;
+		void Deserialize(StateReader& reader);
+
 		const std::vector<std::string>& GetAllOutputDeviceNames() const;
 		void SetOutputDevice(const std::string& audioDeviceName);
 		const std::string& GetCurrentOutputDeviceName() const;
@@ -38,6 +70,14 @@ namespace ModestGB
 		bool IsChannel3Connected() const;
 		bool IsChannel4Connected() const;
 
+		// While enabled, the output of each channel and the mixed output are kept in capture buffers for 
+		// inspection. Capturing costs nothing while disabled. Can be called from any thread.
+		void SetCaptureEnabled(bool isEnabled);
+		void ReadCapturedSamples(uint8_t source, float* destination, uint32_t count) const;
+
+		// Only up to date on the emulation thread. The UI reads it through the state snapshot.
+		const AudioMetrics& GetMetrics() const;
+
 		void WriteToNR10(uint8_t value);
 		void WriteToNR11(uint8_t value);
 		void WriteToNR12(uint8_t value);
@@ -86,6 +126,7 @@ namespace ModestGB
 
 	private:
 		bool isMuted = false;
+		bool isOutputSuspended = false;
 		float masterVolume = 1;
 		bool isSoundControllerEnabled = false;
 
@@ -94,24 +135,62 @@ namespace ModestGB
 
 		AudioTimer frameSequencerTimer;
 		uint8_t frameSequencerStep = 0;
-		AudioTimer sampleCollectionTimer;
-
-		SweepSoundChannel channel1;
-		ToneSoundChannel channel2;
-		WaveSoundChannel channel3;
-		NoiseSoundChannel channel4;
-
-		std::array<SoundChannel*, 4> channels = { &channel1, &channel2, &channel3, &channel4 };
-		std::array<uint8_t, 4> connectionStates = { true, true, true, true };
-
-		SDL_AudioDeviceID currentAudioDeviceID = 0;
-		std::string currentAudioDeviceName;
-		SDL_AudioSpec currentAudioSpec;
-		std::vector<std::string> audioDeviceNames;
-
-		std::vector<float> samples;
 
-		void MixChannels();
-		void RefreshAudioDeviceNames();
+		// Each channel reports changes of its output level to these, instead of being sampled every cycle.
+		BlipBuffer leftBlipBuffer = BlipBuffer(BLIP_BUFFER_CAPACITY);
+		BlipBuffer rightBlipBuffer = BlipBuffer(BLIP_BUFFER_CAPACITY);
+		uint32_t blipFrameElapsedCycles = 0;
+		uint32_t pendingCycles = 0;
+		double smoothedFillError = 0;
+		std::array<float, 4> leftChannelAmplitudes = {};
+		std::array<float, 4> rightChannelAmplitudes = {};
+
+		// Scale applied to each channel's output for each side, refreshed whenever NR50, NR51 
+		// or the connection states change rather than decoded for every change of the output.
+		std::array<float, 4> leftChannelGains = {};
+		std::array<float, 4> rightChannelGains = {};
+		std::array<float, 4> captureChannelGains = {};
+
+		SoundChannelStates channelStates;
+		SweepSoundChannel channel1 = SweepSoundChannel(channelStates, 0);
+		ToneSoundChannel channel2 = ToneSoundChannel(channelStates, 1);
+		WaveSoundChannel channel3 = WaveSoundChannel(channelStates, 2);
+		NoiseSoundChannel channel4 = NoiseSoundChannel(channelStates, 3);
+		// Toggled from the UI thread.
+		std::array<std::atomic<bool>, 4> connectionStates = { true, true, true, true };
+		std::atomic<bool> isCaptureEnabled = false;
+
+		// Only follows isCaptureEnabled between blip frames.
+		bool isCapturing = false;
+		std::array<BlipBuffer, 4> channelCaptureBlipBuffers = { BlipBuffer(BLIP_BUFFER_CAPACITY), BlipBuffer(BLIP_BUFFER_CAPACITY), BlipBuffer(BLIP_BUFFER_CAPACITY), BlipBuffer(BLIP_BUFFER_CAPACITY) };
+		std::array<float, 4> capturedChannelAmplitudes = {};
+		std::array<AudioCaptureBuffer, AUDIO_CAPTURE_SOURCE_COUNT> captureBuffers;
+		std::array<float, BLIP_BUFFER_CAPACITY> captureSamples = {};
+
+		std::unique_ptr<AudioSink> sink = AudioSink::Create(AudioSinkType::Null, "");
+
+		AudioMetrics metrics;
+		// Whether the sink has been given samples since it was last cleared. An empty queue only counts as an underrun then.
+		bool isOutputPrimed = false;
+
+		// Interleaved stereo samples waiting to be handed to the sink. Filled one blip frame at a time, and 
+		// large enough to hold a whole block plus the frame that completes it, so it never has to grow.
+		std::array<float, SAMPLE_BLOCK_SIZE + BLIP_BUFFER_CAPACITY * 2> sampleBlock = {};
+		uint32_t sampleBlockSize = 0;
+
+		void StepFrameSequencer();
+		void SkipPendingCycles();
+		void RunChannels(uint32_t cycles);
+		template <typename Channel> void RunChannel(Channel& channel, uint8_t channelIndex, uint32_t cycles);
+		void UpdateChannelOutput(uint8_t channelIndex, uint32_t clockTime);
+		void UpdateChannelOutputs();
+		bool IsChannelAudible(uint8_t channelIndex) const;
+		void RefreshChannelGains();
+		void EndBlipFrame();
+		void CaptureBlipFrame(const float* mixedSamples, uint32_t sampleCount);
+		void SetSampleRateRatio(double ratio);
+		void QueueSamples();
+		void WriteSamplesToSink();
+		void RecordQueueFill(uint32_t queuedSampleCount);
 	};
 }
\ No newline at end of file
@@ -0,0 +1,27 @@
+#pragma once
+#include <cstdint>
+#include <array>
+#include <atomic>
+
+namespace ModestGB
+{
+	// Must be a power of 2.
+	const uint32_t AUDIO_CAPTURE_BUFFER_SIZE = 4096;
+
+	// Ring of the most recent samples of a signal. It's written by the emulation thread and read by the UI thread 
+	// without any locking. A reader may see a few samples being overwritten while it copies them, which is fine 
+	// since the samples are only displayed.
+	class AudioCaptureBuffer
+	{
+	public:
+		void Write(const float* source, uint32_t count, uint32_t stride = 1);
+		void Clear();
+
+		// Copies the [count] most recent samples into [destination], oldest first.
+		void ReadLatest(float* destination, uint32_t count) const;
+
+	private:
+		std::array<std::atomic<float>, AUDIO_CAPTURE_BUFFER_SIZE> samples = {};
+		std::atomic<uint32_t> writeIndex = 0;
+	};
+}
\ No newline at end of file
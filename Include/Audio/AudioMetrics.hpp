@@ -0,0 +1,42 @@
+#pragma once
+#include <cstdint>
+#include <array>
+
+namespace ModestGB
+{
+	const uint8_t AUDIO_QUEUE_FILL_HISTOGRAM_SIZE = 16;
+	const uint8_t AUDIO_WRITE_TIME_HISTOGRAM_SIZE = 16;
+
+	// Health of the audio output, collected by the APU every time a batch of samples is handed to the sink.
+	struct AudioMetrics
+	{
+		uint32_t sampleRate = 0;
+		uint8_t channelCount = 0;
+
+		// In samples (not frames), as seen right before the last batch was written.
+		uint32_t queuedSampleCount = 0;
+		uint32_t targetQueuedSampleCount = 0;
+		uint32_t maxQueuedSampleCount = 0;
+
+		// Times the queue had run dry before a batch arrived, i.e. the listener heard a gap.
+		uint64_t underrunCount = 0;
+		// Samples that weren't written because the queue was already over its maximum.
+		uint64_t droppedSampleCount = 0;
+		uint64_t writtenBatchCount = 0;
+
+		// Ratio applied to the sample rate to keep the queue near its target.
+		double sampleRateRatio = 1.0;
+
+		// Estimated time from a sample being produced to it being heard.
+		double latencyMilliseconds = 0;
+
+		// Time the emulation thread spent handing samples to the sink.
+		double lastWriteMicroseconds = 0;
+		double maxWriteMicroseconds = 0;
+
+		// Each bucket covers 1/16th of the maximum queue size.
+		std::array<uint32_t, AUDIO_QUEUE_FILL_HISTOGRAM_SIZE> queueFillHistogram = {};
+		// Bucket N counts the writes that took less than 2^N microseconds. The last one also counts anything slower.
+		std::array<uint32_t, AUDIO_WRITE_TIME_HISTOGRAM_SIZE> writeTimeHistogram = {};
+	};
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace ModestGB
+{
+	enum class AudioSinkType
+	{
+		SDL,
+		Null,
+		WAVFile,
+		RawPCM
+	};
+
+	// Destination of the APU's output. Samples are 32-bit floats, with the channels interleaved.
+	class AudioSink
+	{
+	public:
+		// [path] is only used by the sinks that write to a file.
+		static std::unique_ptr<AudioSink> Create(AudioSinkType type, const std::string& path);
+
+		virtual ~AudioSink() = default;
+
+		virtual bool Open(uint32_t sampleRate, uint8_t channelCount) = 0;
+		virtual void Close() = 0;
+		virtual void Write(const float* samples, uint32_t sampleCount) = 0;
+
+		// Drops the samples that were written but haven't been played yet.
+		virtual void Clear();
+
+		// Real-time sinks play the samples as they're written, so the APU has to keep their queue filled. 
+		// The others accept samples as fast as they're produced.
+		virtual bool IsRealTime() const;
+
+		// Number of samples (not frames) waiting to be played.
+		virtual uint32_t GetQueuedSampleCount() const;
+
+		// Number of samples the output device holds on to while it plays them, on top of the queue.
+		virtual uint32_t GetDeviceBufferSampleCount() const;
+
+		// Only sinks backed by an audio device have outputs to choose from.
+		virtual void RefreshOutputDevices();
+		virtual const std::vector<std::string>& GetAllOutputDeviceNames() const;
+		virtual bool SetOutputDevice(const std::string& deviceName);
+		virtual const std::string& GetCurrentOutputDeviceName() const = 0;
+	};
+}
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 #include <cstdint>
+#include "Utils/StateSerialization.hpp"
 
 namespace ModestGB
 {
@@ -7,11 +8,20 @@ namespace ModestGB
 	{
 	public:
 		bool Tick();
+
+		// Advances the timer by [ticks] ticks at once. Returns true if the timer reached 0.
+		bool Tick(uint32_t ticks);
+
+		// Returns the number of ticks until the timer reaches 0, or 0 if the timer is stopped or disabled.
+		uint32_t GetRemainingTicks() const;
 		void Restart(uint16_t period);
 		bool IsStopped();
 		void Disable();
 		void Enable();
 
+		void Serialize(StateWriter& writer) const;
+		void Deserialize(StateReader& reader);
+
 	private:
 		uint16_t period = 0;
 		uint16_t counter = 0;
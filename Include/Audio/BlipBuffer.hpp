@@ -0,0 +1,44 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace ModestGB
+{
+	// Band-limited synthesis buffer. Instead of being point sampled, a sound source reports each change of its 
+	// output level (a "delta") together with the clock cycle it happened on. Every delta is added to the buffer 
+	// as a band-limited step, and the output samples are produced by integrating the buffer. This way, the cost 
+	// depends on how often the output changes rather than on the clock rate, and there's no aliasing.
+	class BlipBuffer
+	{
+	public:
+		// [capacity] is the maximum number of output samples that can be waiting to be read.
+		BlipBuffer(uint32_t capacity);
+
+		void SetRates(double clockRate, double sampleRate);
+		void Clear();
+
+		// Adds a change of [delta] in the output level at [clockTime] cycles from the start of the current frame.
+		void AddDelta(uint32_t clockTime, float delta);
+
+		// Ends the current frame, which makes the samples generated during the frame available for reading. 
+		// Clock times of the next frame are relative to the end of this one.
+		void EndFrame(uint32_t clockDuration);
+
+		uint32_t GetSamplesAvailable() const;
+
+		// Reads up to [count] samples into [destination], [stride] floats apart. Returns the number of samples read.
+		uint32_t ReadSamples(float* destination, uint32_t count, uint32_t stride = 1);
+
+	private:
+		std::vector<float> buffer;
+		uint32_t capacity = 0;
+		uint32_t samplesAvailable = 0;
+
+		// Output samples per clock cycle, and the position of the current frame's start in the buffer. 
+		// Both are 32.32 fixed point numbers.
+		uint64_t factor = 0;
+		uint64_t offset = 0;
+
+		float integrator = 0;
+	};
+}
\ No newline at end of file
@@ -1,37 +1,59 @@
 #pragma once
 #include "Audio/SoundChannel.hpp"
-#include "Memory/Register16.hpp"
 
 namespace ModestGB
 {
-	class NoiseSoundChannel : public SoundChannel
+	class NoiseSoundChannel final : public SoundChannel<NoiseSoundChannel>
 	{
 	public:
-		NoiseSoundChannel();
+		NoiseSoundChannel(SoundChannelStates& states, uint8_t index);
 
-		void Reset() override;
-		void WriteToNRX1(uint8_t value) override;
-		void WriteToNRX2(uint8_t value) override;
+		void Reset();
+		void WriteToNRX1(uint8_t value);
+		void WriteToNRX2(uint8_t value);
+		void WriteToNRX3(uint8_t value);
 
-		uint8_t ReadNRX0() const override;
-		uint8_t ReadNRX1() const override;
-		uint8_t ReadNRX4() const override;
+		void Serialize(StateWriter& writer) const;
+		void Deserialize(StateReader& reader);
+
+		uint8_t ReadNRX0() const;
+		uint8_t ReadNRX1() const;
+		uint8_t ReadNRX4() const;
 
 	protected:
-		float GenerateSample() const override;
-		void OnTrigger() override;
-		uint16_t GetFrequencyTimerPeriod() const override;
-		uint16_t GetLengthTimerPeriod() const override;
-		ModifierDirection GetVolumeEnvelopeDirection() const override;
-		uint16_t GetVolumeEnvelopeTimerPeriod() const override;
-		bool IsConstrainedByLength() const override;
-		void OnFrequencyTimerReachedZero() override;
-		uint8_t GetInitialEnvelopeVolume() const override;
+		friend class SoundChannel<NoiseSoundChannel>;
+
+		void OnTrigger();
+		uint32_t GetFrequencyTimerPeriod() const;
+		uint16_t GetLengthTimerPeriod() const;
+		ModifierDirection GetVolumeEnvelopeDirection() const;
+		uint16_t GetVolumeEnvelopeTimerPeriod() const;
+		uint8_t GetInitialEnvelopeVolume() const;
+
+		void AdvanceWaveform(uint32_t steps)
+		{
+			shiftRegisterPosition = (shiftRegisterPosition + steps) % shiftRegisterPeriod;
+		}
+
+		bool IsSilent() const
+		{
+			return volume == 0;
+		}
+
+		float GenerateSample() const
+		{
+			return static_cast<float>(((~shiftRegisterStates[shiftRegisterPosition]) & 1) * volume);
+		}
 
 	private:
-		Register16 shiftRegister;
+		// The shift register always goes through the same sequence of states, so instead of being shifted, 
+		// it's represented by its position in the precomputed sequence of the current width (15 or 7 bits).
+		const uint16_t* shiftRegisterStates = nullptr;
+		uint16_t shiftRegisterPeriod = 1;
+		uint16_t shiftRegisterPosition = 0;
 
-		uint8_t GetShiftRegisterSize() const;
+		bool IsShiftRegisterShort() const;
+		void RefreshShiftRegisterWidth();
 		uint8_t GetFrequencyShift() const;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,15 @@
+#pragma once
+#include "Audio/AudioSink.hpp"
+
+namespace ModestGB
+{
+	// Discards every sample. Used when there's no audio device, e.g. on headless machines.
+	class NullAudioSink : public AudioSink
+	{
+	public:
+		bool Open(uint32_t sampleRate, uint8_t channelCount) override;
+		void Close() override;
+		void Write(const float* samples, uint32_t sampleCount) override;
+		const std::string& GetCurrentOutputDeviceName() const override;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,24 @@
+#pragma once
+#include <fstream>
+#include "Audio/AudioSink.hpp"
+
+namespace ModestGB
+{
+	// Writes the samples as they are (interleaved 32-bit little-endian floats, no header) to a file or a named pipe, 
+	// e.g. to be played or encoded by another program.
+	class RawPCMAudioSink : public AudioSink
+	{
+	public:
+		RawPCMAudioSink(const std::string& path);
+		~RawPCMAudioSink();
+
+		bool Open(uint32_t sampleRate, uint8_t channelCount) override;
+		void Close() override;
+		void Write(const float* samples, uint32_t sampleCount) override;
+		const std::string& GetCurrentOutputDeviceName() const override;
+
+	private:
+		std::string path;
+		std::ofstream stream;
+	};
+}
\ No newline at end of file
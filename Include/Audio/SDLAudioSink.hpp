@@ -0,0 +1,35 @@
+#pragma once
+#include "SDL.h"
+#include "Audio/AudioSink.hpp"
+
+namespace ModestGB
+{
+	// Plays the samples on one of the system's audio devices.
+	class SDLAudioSink : public AudioSink
+	{
+	public:
+		~SDLAudioSink();
+
+		bool Open(uint32_t sampleRate, uint8_t channelCount) override;
+		void Close() override;
+		void Write(const float* samples, uint32_t sampleCount) override;
+		void Clear() override;
+		bool IsRealTime() const override;
+		uint32_t GetQueuedSampleCount() const override;
+		uint32_t GetDeviceBufferSampleCount() const override;
+
+		void RefreshOutputDevices() override;
+		const std::vector<std::string>& GetAllOutputDeviceNames() const override;
+		bool SetOutputDevice(const std::string& deviceName) override;
+		const std::string& GetCurrentOutputDeviceName() const override;
+
+	private:
+		bool isAudioSubsystemInitialized = false;
+		SDL_AudioDeviceID currentAudioDeviceID = 0;
+		std::string currentAudioDeviceName;
+		SDL_AudioSpec currentAudioSpec;
+		std::vector<std::string> audioDeviceNames;
+
+		void RefreshAudioDeviceNames();
+	};
+}
\ No newline at end of file
@@ -1,46 +1,137 @@
 #pragma once
 #include <cstdint>
-#include <functional>
 #include "Audio/AudioTimer.hpp"
+#include "Audio/SoundChannelStates.hpp"
 #include "Memory/Register8.hpp"
+#include "Audio/SoundRegisters.hpp"
 
 namespace ModestGB
 {
+	enum class ModifierDirection
+	{
+		Increase = 1,
+		Decrease = -1
+	};
+
+	// Behavior shared by all sound channels. The concrete channel type is passed in as [Derived], so calls 
+	// to channel specific behavior are resolved at compile time, and the per-step functions below can be 
+	// inlined into the APU. The channel types provide:
+	//
+	//  - void Reset(), which must call SoundChannel::Reset()
+	//  - void OnTrigger(), which must call SoundChannel::OnTrigger()
+	//  - void AdvanceWaveform(uint32_t steps)
+	//  - bool IsSilent() const
+	//  - float GenerateSample() const, between 0 and 15
+	//  - uint32_t GetFrequencyTimerPeriod() const
+	//  - uint16_t GetLengthTimerPeriod() const
+	//  - uint16_t GetVolumeEnvelopeTimerPeriod() const
+	//  - ModifierDirection GetVolumeEnvelopeDirection() const
+	//  - uint8_t GetInitialEnvelopeVolume() const
+	template <typename Derived>
 	class SoundChannel
 	{
 	public:
-		SoundChannel();
+		SoundChannel(SoundChannelStates& states, uint8_t index);
 
-		void TickFrequencyTimer();
 		void TickVolumeEnvelopeTimer();
 		void TickLengthControlTimer();
 
+		// Advances the frequency timer by [cycles] cycles, which must not exceed GetRemainingFrequencyTimerCycles(). 
+		// The waveform steps if the timer reaches 0.
+		void TickFrequencyTimer(uint32_t cycles)
+		{
+			uint32_t& counter = states.frequencyTimerCounters[index];
+
+			if (counter == 0)
+				return;
+
+			if (cycles < counter)
+			{
+				counter -= cycles;
+				return;
+			}
+
+			counter = states.frequencyTimerPeriods[index];
+			Self().AdvanceWaveform(1);
+			RefreshOutput();
+		}
+
+		// Returns the number of cycles until the waveform steps, or 0 if the frequency timer is stopped.
+		uint32_t GetRemainingFrequencyTimerCycles() const
+		{
+			return states.frequencyTimerCounters[index];
+		}
+
+		// Advances the frequency timer by any number of cycles at once. The waveform position is updated 
+		// arithmetically, without visiting every step in between.
+		void SkipFrequencyTimer(uint32_t cycles)
+		{
+			uint32_t& counter = states.frequencyTimerCounters[index];
+
+			if (counter == 0)
+				return;
+
+			if (cycles < counter)
+			{
+				counter -= cycles;
+				return;
+			}
+
+			cycles -= counter;
+
+			// The timer reaches 0 once within the remaining cycles, and then once for every full period after that.
+			uint32_t period = states.frequencyTimerPeriods[index];
+			if (period == 0)
+			{
+				counter = 0;
+				Self().AdvanceWaveform(1);
+			}
+			else
+			{
+				counter = period - (cycles % period);
+				Self().AdvanceWaveform(1 + cycles / period);
+			}
+
+			RefreshOutput();
+		}
+
+		// Returns true if the output level stays the same no matter how far the waveform advances.
+		bool HasConstantOutput() const
+		{
+			return !isEnabled || !isSoundControllerEnabled || Self().IsSilent();
+		}
+
+		float GetSample() const
+		{
+			return states.outputs[index];
+		}
+
 		bool IsEnabled() const;
 
 		void EnableSoundController();
 		void DisableSoundController();
-		float GetSample() const;
 
-		virtual void Reset();
+		void Reset();
+
+		// The frequency timers and the output live in SoundChannelStates, which is saved by the APU.
+		void Serialize(StateWriter& writer) const;
+		void Deserialize(StateReader& reader);
 
-		virtual void WriteToNRX0(uint8_t value);
-		virtual void WriteToNRX1(uint8_t value);
-		virtual void WriteToNRX2(uint8_t value);
-		virtual void WriteToNRX3(uint8_t value);
-		virtual void WriteToNRX4(uint8_t value);
+		void WriteToNRX0(uint8_t value);
+		void WriteToNRX1(uint8_t value);
+		void WriteToNRX2(uint8_t value);
+		void WriteToNRX3(uint8_t value);
+		void WriteToNRX4(uint8_t value);
 
-		virtual uint8_t ReadNRX0() const;
-		virtual uint8_t ReadNRX1() const;
-		virtual uint8_t ReadNRX2() const;
-		virtual uint8_t ReadNRX3() const;
-		virtual uint8_t ReadNRX4() const;
+		uint8_t ReadNRX0() const;
+		uint8_t ReadNRX1() const;
+		uint8_t ReadNRX2() const;
+		uint8_t ReadNRX3() const;
+		uint8_t ReadNRX4() const;
 
 	protected:
-		enum class ModifierDirection
-		{
-			Increase = 1,
-			Decrease = -1
-		};
+		SoundChannelStates& states;
+		const uint8_t index;
 
 		bool isEnabled = false;
 		bool isSoundControllerEnabled = true;
@@ -57,21 +148,29 @@ namespace ModestGB
 		void ReloadFrequencyTimer();
 		void ReloadEnvelopeTimer();
 		void ReloadLengthTimer();
+		void RefreshFrequencyTimerPeriod();
+		bool IsConstrainedByLength() const;
 
-		virtual void OnTrigger();
-		virtual void OnFrequencyTimerReachedZero();
+		void OnTrigger();
 
-		virtual ModifierDirection GetVolumeEnvelopeDirection() const = 0;
-		virtual uint8_t GetInitialEnvelopeVolume() const = 0;
-		virtual bool IsConstrainedByLength() const = 0;
-		virtual float GenerateSample() const = 0;
+		// Recalculates the output of this channel. Must be called whenever anything that affects the output changes.
+		void RefreshOutput()
+		{
+			// Outputs an amplitude between -1 and 1.
+			states.outputs[index] = isEnabled && isSoundControllerEnabled ? ((Self().GenerateSample() / 15.0f) * 2) - 1 : 0;
+		}
 
-		virtual uint16_t GetFrequencyTimerPeriod() const = 0;
-		virtual uint16_t GetLengthTimerPeriod() const = 0;
-		virtual uint16_t GetVolumeEnvelopeTimerPeriod() const = 0;
+		Derived& Self()
+		{
+			return static_cast<Derived&>(*this);
+		}
+
+		const Derived& Self() const
+		{
+			return static_cast<const Derived&>(*this);
+		}
 
 	private:
-		AudioTimer frequencyTimer;
 		AudioTimer lengthTimer;
 		AudioTimer envelopeTimer;
 	};
@@ -0,0 +1,22 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+namespace ModestGB
+{
+	const uint8_t SOUND_CHANNEL_COUNT = 4;
+
+	// The part of the sound channels' state that is touched on every waveform step, stored as parallel arrays 
+	// indexed by channel, so the APU can run and mix all 4 channels out of a single compact block.
+	struct SoundChannelStates
+	{
+		// Cycles until the waveform of each channel steps, or 0 while the frequency timer is stopped.
+		std::array<uint32_t, SOUND_CHANNEL_COUNT> frequencyTimerCounters = {};
+
+		// Reload values of the frequency timers. Refreshed whenever a channel's registers are written.
+		std::array<uint32_t, SOUND_CHANNEL_COUNT> frequencyTimerPeriods = {};
+
+		// Current output of each channel, between -1 and 1, or 0 while the channel is disabled.
+		std::array<float, SOUND_CHANNEL_COUNT> outputs = {};
+	};
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+#pragma once
+#include "Utils/BitField.hpp"
+
+namespace ModestGB
+{
+	// Sound Channel Register Fields (NRx0 - NRx4)
+	// ------------------------------
+	// Not every channel implements every field, e.g. only channel 1 has a sweep and only channel 4 has
+	// a shift register. Channel 3 reuses NRx0 and NRx2 for its DAC switch and its output level.
+
+	// NRx0
+	constexpr BitField<4, 6> NRX0_SWEEP_PERIOD{};
+	constexpr BitField<3> NRX0_SWEEP_DIRECTION{};
+	constexpr BitField<0, 2> NRX0_SWEEP_SHIFT{};
+	constexpr BitField<7> NRX0_WAVE_DAC_ENABLE{};
+
+	// NRx1
+	constexpr BitField<6, 7> NRX1_DUTY_CYCLE{};
+	constexpr BitField<0, 5> NRX1_LENGTH_TIMER{};
+
+	// NRx2
+	constexpr BitField<4, 7> NRX2_ENVELOPE_INITIAL_VOLUME{};
+	constexpr BitField<3> NRX2_ENVELOPE_DIRECTION{};
+	constexpr BitField<0, 2> NRX2_ENVELOPE_PERIOD{};
+	// The DAC is off when both the initial volume and the envelope direction are 0.
+	constexpr BitField<3, 7> NRX2_DAC_ENABLE{};
+	constexpr BitField<5, 6> NRX2_WAVE_OUTPUT_LEVEL{};
+
+	// NRx3
+	constexpr BitField<4, 7> NRX3_NOISE_CLOCK_SHIFT{};
+	constexpr BitField<3> NRX3_NOISE_SHIFT_REGISTER_WIDTH{};
+	constexpr BitField<0, 2> NRX3_NOISE_CLOCK_DIVIDER{};
+
+	// NRx4
+	constexpr BitField<7> NRX4_TRIGGER{};
+	constexpr BitField<6> NRX4_LENGTH_ENABLE{};
+	constexpr BitField<0, 2> NRX4_FREQUENCY_HIGH{};
+
+	// Master Volume and Panning (NR50 - NR52)
+	// ------------------------------
+	constexpr BitField<4, 6> NR50_LEFT_VOLUME{};
+	constexpr BitField<0, 2> NR50_RIGHT_VOLUME{};
+	constexpr BitField<7> NR52_SOUND_ENABLE{};
+}
\ No newline at end of file
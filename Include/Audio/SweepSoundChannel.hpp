@@ -3,16 +3,21 @@
 
 namespace ModestGB
 {
-	class SweepSoundChannel : public ToneSoundChannel
+	class SweepSoundChannel final : public BasicToneSoundChannel<SweepSoundChannel>
 	{
 	public:
-		SweepSoundChannel();
+		SweepSoundChannel(SoundChannelStates& states, uint8_t index);
 		void TickSweepTimer();
-		void Reset() override;
-		uint8_t ReadNRX0() const override;
+		void Reset();
+		uint8_t ReadNRX0() const;
+
+		void Serialize(StateWriter& writer) const;
+		void Deserialize(StateReader& reader);
 
 	protected:
-		void OnTrigger() override;
+		friend class SoundChannel<SweepSoundChannel>;
+
+		void OnTrigger();
 
 	private:
 		bool isSweepEnabled = false;
@@ -3,35 +3,66 @@
 
 namespace ModestGB
 {
-	class ToneSoundChannel : public SoundChannel
+	const uint8_t DUTY_CYCLE_LENGTH = 8;
+	extern const uint8_t DUTY_CYCLE_WAVEFORMS[4][DUTY_CYCLE_LENGTH];
+
+	// Square wave channel. Shared by channel 1 (which adds a frequency sweep) and channel 2.
+	template <typename Derived>
+	class BasicToneSoundChannel : public SoundChannel<Derived>
 	{
 	public:
-		ToneSoundChannel();
+		BasicToneSoundChannel(SoundChannelStates& states, uint8_t index);
+
+		void Reset();
+		void WriteToNRX1(uint8_t value);
+		void WriteToNRX2(uint8_t value);
 
-		void Reset() override;
-		virtual void WriteToNRX1(uint8_t value) override;
-		virtual void WriteToNRX2(uint8_t value) override;
+		void Serialize(StateWriter& writer) const;
+		void Deserialize(StateReader& reader);
 
-		uint8_t ReadNRX0() const override;
-		uint8_t ReadNRX1() const override;
-		uint8_t ReadNRX3() const override;
-		uint8_t ReadNRX4() const override;
+		uint8_t ReadNRX0() const;
+		uint8_t ReadNRX1() const;
+		uint8_t ReadNRX3() const;
+		uint8_t ReadNRX4() const;
 
 	protected:
-		uint16_t GetFrequency() const;
-		void OnFrequencyTimerReachedZero() override;
-		float GenerateSample() const override;
-		ModifierDirection GetVolumeEnvelopeDirection() const override;
-		uint8_t GetInitialEnvelopeVolume() const override;
-		bool IsConstrainedByLength() const override;
-		virtual void OnTrigger() override;
-
-	private:
+		friend class SoundChannel<Derived>;
+
 		uint8_t waveformPosition = 0;
 
-		uint16_t GetFrequencyTimerPeriod() const override;
-		uint16_t GetVolumeEnvelopeTimerPeriod() const override;
-		uint16_t GetLengthTimerPeriod() const override;
-		uint8_t GetWaveformIndex() const;
+		uint16_t GetFrequency() const;
+		void OnTrigger();
+
+		void AdvanceWaveform(uint32_t steps)
+		{
+			waveformPosition = (waveformPosition + steps) % DUTY_CYCLE_LENGTH;
+		}
+
+		bool IsSilent() const
+		{
+			return this->volume == 0;
+		}
+
+		float GenerateSample() const
+		{
+			return static_cast<float>(DUTY_CYCLE_WAVEFORMS[GetWaveformIndex()][waveformPosition] * this->volume);
+		}
+
+		ModifierDirection GetVolumeEnvelopeDirection() const;
+		uint8_t GetInitialEnvelopeVolume() const;
+		uint32_t GetFrequencyTimerPeriod() const;
+		uint16_t GetVolumeEnvelopeTimerPeriod() const;
+		uint16_t GetLengthTimerPeriod() const;
+
+		uint8_t GetWaveformIndex() const
+		{
+			return this->nrx1.Read(NRX1_DUTY_CYCLE);
+		}
+	};
+
+	class ToneSoundChannel final : public BasicToneSoundChannel<ToneSoundChannel>
+	{
+	public:
+		ToneSoundChannel(SoundChannelStates& states, uint8_t index);
 	};
 }
\ No newline at end of file
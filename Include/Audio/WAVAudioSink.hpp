@@ -0,0 +1,27 @@
+#pragma once
+#include <fstream>
+#include "Audio/AudioSink.hpp"
+
+namespace ModestGB
+{
+	// Records the samples to a 16-bit PCM WAV file. The sizes in the header are filled in when the sink is closed.
+	class WAVAudioSink : public AudioSink
+	{
+	public:
+		WAVAudioSink(const std::string& path);
+		~WAVAudioSink();
+
+		bool Open(uint32_t sampleRate, uint8_t channelCount) override;
+		void Close() override;
+		void Write(const float* samples, uint32_t sampleCount) override;
+		const std::string& GetCurrentOutputDeviceName() const override;
+
+	private:
+		std::string path;
+		std::ofstream stream;
+		uint32_t dataSize = 0;
+		std::vector<uint8_t> convertedSamples;
+
+		void WriteHeader(uint32_t sampleRate, uint8_t channelCount);
+	};
+}
\ No newline at end of file
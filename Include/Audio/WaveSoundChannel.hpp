@@ -1,41 +1,71 @@
 #pragma once
 #include <cstdint>
-#include <vector>
+#include <array>
 #include "Audio/SoundChannel.hpp"
 
 namespace ModestGB
 {
-	class WaveSoundChannel : public SoundChannel
+	class WaveSoundChannel final : public SoundChannel<WaveSoundChannel>
 	{
 	public:
-		void Reset() override;
-		WaveSoundChannel();
+		WaveSoundChannel(SoundChannelStates& states, uint8_t index);
+		void Reset();
 		void WriteToWavePatternRAM(uint16_t address, uint8_t value);
 		uint8_t ReadWavePatternRAM() const;
 
-		void WriteToNRX0(uint8_t value) override;
+		void WriteToNRX0(uint8_t value);
+		void WriteToNRX2(uint8_t value);
 
-		uint8_t ReadNRX0() const override;
-		uint8_t ReadNRX1() const override;
-		uint8_t ReadNRX2() const override;
-		uint8_t ReadNRX3() const override;
-		uint8_t ReadNRX4() const override;
+		void Serialize(StateWriter& writer) const;
+		void Deserialize(StateReader& reader);
+
+		uint8_t ReadNRX0() const;
+		uint8_t ReadNRX1() const;
+		uint8_t ReadNRX2() const;
+		uint8_t ReadNRX3() const;
+		uint8_t ReadNRX4() const;
 
 	protected:
-		uint16_t GetLengthTimerPeriod() const override;
-		uint16_t GetFrequencyTimerPeriod() const override;
-		float GenerateSample() const override;
-		bool IsConstrainedByLength() const override;
-		void OnFrequencyTimerReachedZero() override;
-		void OnTrigger() override;
+		friend class SoundChannel<WaveSoundChannel>;
+
+		uint16_t GetLengthTimerPeriod() const;
+		uint32_t GetFrequencyTimerPeriod() const;
+		void OnTrigger();
 		ModifierDirection GetVolumeEnvelopeDirection() const;
 		uint8_t GetInitialEnvelopeVolume() const;
 		uint16_t GetVolumeEnvelopeTimerPeriod() const;
 
+		void AdvanceWaveform(uint32_t steps)
+		{
+			sampleIndex = (sampleIndex + steps) % WAVE_SAMPLE_COUNT;
+		}
+
+		bool IsSilent() const
+		{
+			// A shift of 4 mutes the channel.
+			return volumeControlShift == 4;
+		}
+
+		float GenerateSample() const
+		{
+			return sampleLevels[sampleIndex];
+		}
+
 	private:
+		static const uint8_t WAVE_PATTERN_RAM_SIZE = 16;
+		static const uint8_t WAVE_SAMPLE_COUNT = WAVE_PATTERN_RAM_SIZE * 2;
+
 		uint8_t sampleIndex = 0;
-		std::vector<uint8_t> samples;
+		// Decoded from NRX2 whenever it's written.
+		uint8_t volumeControlShift = 4;
+		std::array<uint8_t, WAVE_PATTERN_RAM_SIZE> wavePatternRAM = {};
+
+		// The output level of every sample of the wave pattern, with the volume control already applied. 
+		// Decoded whenever the wave pattern RAM or NRX2 is written.
+		std::array<float, WAVE_SAMPLE_COUNT> sampleLevels = {};
 
-		uint8_t GetVolumeControlShift() const;
+		void RefreshVolumeControlShift();
+		void DecodeSample(uint8_t ramIndex);
+		void DecodeSamples();
 	};
 }
\ No newline at end of file
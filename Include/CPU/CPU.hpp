@@ -8,6 +8,7 @@
 #include "CPU/CPUInstruction.hpp"
 #include "Memory/Memory.hpp"
 #include "Memory/Register16.hpp"
+#include "Utils/StateSerialization.hpp"
 
 namespace ModestGB
 {
@@ -34,6 +35,9 @@ namespace ModestGB
 		void PrintRegisterInfo();
 		void Reset();
 
+		void Serialize(StateWriter& writer) const;
+		void Deserialize(StateReader& reader);
+
 		uint16_t ReadRegisterAF() const;
 		uint16_t ReadRegisterBC() const;
 		uint16_t ReadRegisterDE() const;
@@ -1,5 +1,10 @@
 #pragma once
 #include <string>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <queue>
+#include <chrono>
 #include "SDL.h"
 #include "Memory/MemoryMap.hpp"
 #include "CPU/CPU.hpp"
@@ -11,50 +16,150 @@
 #include "Logger.hpp"
 #include "Input/Joypad.hpp"
 #include "Input/InputManager.hpp"
+#include "Input/InputMapping.hpp"
 #include "Utils/MemoryUtils.hpp"
+#include "EmulatorCommand.hpp"
+#include "EmulatorStateSnapshot.hpp"
+#include "LaunchOptions.hpp"
+#include "RewindBuffer.hpp"
+#include "InputMovie.hpp"
 
 namespace ModestGB
 {
 	class Emulator
 	{
 	public:
+		Emulator(const LaunchOptions& launchOptions);
 		~Emulator();
 		int Run();
 
 	private:
+		LaunchOptions launchOptions;
 		EmulatorWindow window;
 		InputManager inputManager;
+		InputMapping inputMapping;
 		MemoryMap memoryMap;
 		Cartridge cartridge;
 		CPU processor = CPU(memoryMap);
 		PPU ppu = PPU(memoryMap);
 		APU apu;
 		Timer timer = Timer(memoryMap);
+		// Memory budget of the emulated machine: 8 KiB of WRAM, 8 KiB of VRAM, 160 B of OAM, 127 B of HRAM 
+		// and 0-128 KiB of cartridge RAM depending on the game, all in copy-on-write pages. Echo RAM mirrors 
+		// WRAM and the unusable region reads as a constant, so neither has any storage. The ROM, the 
+		// framebuffers and the frontend's buffers come on top of that.
 		BasicMemory wram = BasicMemory(8 * KiB);
 		BasicMemory hram = BasicMemory(127);
-		BasicMemory echoRam = BasicMemory(122368);
-		BasicMemory restrictedMemory = BasicMemory(130464);
-		BasicMemory ioRegisters = BasicMemory(128);
+		Register8 serialTransferDataRegister;
+		Register8 serialTransferControlRegister;
 		Register8 interruptEnableRegister;
 		Register8 interruptFlagRegister;
-		Joypad joypad = Joypad(inputManager, memoryMap);
+		Joypad joypad = Joypad(memoryMap);
 
-		bool isRunning = false;
+		std::atomic<bool> isRunning = false;
+
+		// Only accessed by the emulation thread.
 		bool isPaused = false;
 		bool isStepRequested = false;
 		uint32_t cyclesPerSecond = 0;
+		uint32_t excessCyclesFromLastFrame = 0;
+
+		// Set while emulating the frames that run ahead of the real one, which are thrown away afterwards.
+		bool isRunningAhead = false;
+		MachineSnapshot runAheadSnapshot;
+
+		// Debug views drawn by the PPU, mirrored from the window by the UI thread every frame.
+		std::atomic<bool> isTilesDebugViewVisible = false;
+		std::atomic<bool> isSpritesDebugViewVisible = false;
+		std::atomic<bool> isBackgroundTileMapDebugViewVisible = false;
+		std::atomic<bool> isWindowTileMapDebugViewVisible = false;
+
+		// Mirrored from the rewind button by the UI thread every frame.
+		std::atomic<bool> isRewindRequested = false;
+
+		std::thread emulationThread;
+
+		std::mutex commandQueueMutex;
+		std::queue<EmulatorCommand> commandQueue;
+
+		// Reused by every save, so that saving a state doesn't allocate once the buffer has grown to fit.
+		std::vector<uint8_t> saveStateBuffer;
+
+		RewindBuffer rewindBuffer;
+		std::vector<uint8_t> rewindStateBuffer;
+		uint32_t framesSinceLastRewindCapture = 0;
+
+		MovieMode movieMode = MovieMode::None;
+		InputMovie movie;
+		size_t movieFrameIndex = 0;
 
+		// The buttons held by the player while recording, only applied to the joypad when the next frame starts.
+		uint8_t movieButtonStates = 0;
+		std::chrono::steady_clock::time_point moviePlaybackStartTime;
+
+		std::mutex stateSnapshotMutex;
+		EmulatorStateSnapshot stateSnapshot;
+
+		// Log entries can be added from either thread, so they are queued and moved over by the UI thread.
+		std::mutex pendingLogEntriesMutex;
+		std::vector<std::string> pendingLogEntries;
 		std::vector<std::string> logEntries;
 
+		void RunEmulation();
+		void RunFrame();
+		void RunFrameWithRunAhead();
+		uint32_t RunCycles(uint32_t cycles);
+		uint32_t Tick();
+		void ProcessCommands();
+		void PushCommand(const EmulatorCommand& command);
+		void PublishStateSnapshot();
+
 		void OnInputEventReceived(SDL_Event e);
+		void OnKeyPressed(KeyCode keyCode);
+		void OnKeyReleased(KeyCode keyCode);
+		void OnControllerButtonPressed(ControllerButtonCode buttonCode);
+		void OnControllerButtonReleased(ControllerButtonCode buttonCode);
+		void PushButtonStateCommands(const std::vector<GBButton>& buttons, bool isPressed);
 		void OnPauseButtonPressed();
 		void OnStepButtonPressed();
 		void OnClearButtonPressed();
+		void OnSaveStateButtonPressed();
+		void OnLoadStateButtonPressed();
+		void OnRecordMovieFromPowerOnButtonPressed();
+		void OnRecordMovieFromCurrentStateButtonPressed();
+		void OnMovieFileSelected(const std::string& path);
+		void OnStopMovieButtonPressed();
 
 		void AddLogEntry(const std::string& logEntry, LogMessageType messageType);
 		void OnFileSelected(const std::string& path);
 
 		bool LoadROM(const std::string& romFilePath);
+		void ResetMachine();
+
+		// Saves and restores the state of the whole machine. Only called from the emulation thread.
+		void SaveState(std::vector<uint8_t>& buffer);
+		bool LoadState(const uint8_t* data, size_t size);
+
+		// Forks the machine. The memories are shared with the snapshot until they're written to, 
+		// so taking and restoring a snapshot is much cheaper than a save state.
+		void SaveSnapshot(MachineSnapshot& snapshot);
+		bool LoadSnapshot(const MachineSnapshot& snapshot);
+
+		void WriteState(StateWriter& writer);
+		bool ReadState(StateReader& reader);
+		std::string GetStateFilePath() const;
+		void SaveStateToFile();
+		void LoadStateFromFile();
+
+		void CaptureRewindState();
+		void RewindFrame();
+
+		// Movies are recorded and played by the emulation thread, one frame of input at a time.
+		void StartMovieRecording(bool startsAtPowerOn);
+		void StartMoviePlayback(const std::string& path);
+		void StopMovie();
+		void AdvanceMovie();
+		std::string GetMovieFilePath() const;
 
 		void SetupMemoryMap();
 	};
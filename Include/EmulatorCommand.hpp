@@ -0,0 +1,78 @@
+#pragma once
+#include <string>
+#include <functional>
+#include "Input/GBButtons.hpp"
+#include "Graphics/Color.hpp"
+#include "Memory/Cartridge.hpp"
+
+namespace ModestGB
+{
+	enum class EmulatorCommandType
+	{
+		LoadROM,
+		TogglePause,
+		Step,
+		SetButtonState,
+		SaveState,
+		LoadState,
+		RecordMovie,
+		PlayMovie,
+		StopMovie,
+		SetPaletteTint,
+		SetFrameSkip,
+		SetRenderingEnabled,
+		SetOutputDevice,
+		SetMasterVolume,
+		SetMuted,
+		SetChannelConnected,
+		SetSavedDataSearchType,
+		SetRTCWallClockCatchUpEnabled,
+		SetGlobalChecksumVerificationEnabled
+	};
+
+	// Requests sent from the UI thread to the emulation thread. The emulation thread 
+	// is the only one that touches the emulated hardware, so anything that changes its state goes through here.
+	struct EmulatorCommand
+	{
+		EmulatorCommandType type;
+
+		// LoadROM
+		std::string romFilePath;
+
+		// SetButtonState
+		GBButton button = GBButton::A;
+		bool isPressed = false;
+
+		// RecordMovie
+		bool startsAtPowerOn = false;
+
+		// PlayMovie
+		std::string moviePath;
+
+		// SetPaletteTint
+		uint16_t paletteAddress = 0;
+		uint8_t colorIndex = 0;
+		Color color = RGBA_WHITE;
+
+		// SetFrameSkip
+		uint32_t framesToSkip = 0;
+		uint32_t frameSkipInterval = 1;
+
+		// SetOutputDevice
+		std::string audioDeviceName;
+
+		// SetMasterVolume
+		float volume = 0.0f;
+
+		// SetChannelConnected
+		uint8_t channelIndex = 0;
+
+		// SetRenderingEnabled, SetMuted, SetChannelConnected, SetRTCWallClockCatchUpEnabled and SetGlobalChecksumVerificationEnabled
+		bool isEnabled = false;
+
+		// SetSavedDataSearchType
+		SavedDataSearchType savedDataSearchType = SavedDataSearchType::EMULATOR_DIRECTORY;
+	};
+
+	using EmulatorCommandCallback = std::function<void(const EmulatorCommand&)>;
+}
\ No newline at end of file
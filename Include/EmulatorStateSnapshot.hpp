@@ -0,0 +1,124 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <array>
+#include "Audio/AudioMetrics.hpp"
+#include "Graphics/Color.hpp"
+#include "Memory/Cartridge.hpp"
+
+namespace ModestGB
+{
+	struct CPUStateSnapshot
+	{
+		uint16_t registerAF = 0;
+		uint16_t registerBC = 0;
+		uint16_t registerDE = 0;
+		uint16_t registerHL = 0;
+		uint16_t programCounter = 0;
+		uint16_t stackPointer = 0;
+		uint8_t interruptFlagRegister = 0;
+		uint8_t interruptEnableRegister = 0;
+		bool interruptMasterEnableFlag = false;
+	};
+
+	struct VideoStateSnapshot
+	{
+		uint8_t lcdc = 0;
+		uint8_t stat = 0;
+		uint8_t scy = 0;
+		uint8_t scx = 0;
+		uint8_t ly = 0;
+		uint8_t lyc = 0;
+		uint8_t wy = 0;
+		uint8_t wx = 0;
+	};
+
+	struct SoundStateSnapshot
+	{
+		uint8_t nr10 = 0;
+		uint8_t nr11 = 0;
+		uint8_t nr12 = 0;
+		uint8_t nr13 = 0;
+		uint8_t nr14 = 0;
+		uint8_t nr21 = 0;
+		uint8_t nr22 = 0;
+		uint8_t nr23 = 0;
+		uint8_t nr24 = 0;
+		uint8_t nr30 = 0;
+		uint8_t nr31 = 0;
+		uint8_t nr32 = 0;
+		uint8_t nr33 = 0;
+		uint8_t nr34 = 0;
+		uint8_t nr41 = 0;
+		uint8_t nr42 = 0;
+		uint8_t nr43 = 0;
+		uint8_t nr44 = 0;
+		uint8_t nr50 = 0;
+		uint8_t nr51 = 0;
+		uint8_t nr52 = 0;
+
+		AudioMetrics metrics;
+	};
+
+	struct JoypadStateSnapshot
+	{
+		uint8_t joypadRegister = 0;
+		bool isDownOrStartPressed = false;
+		bool isUpOrSelectPressed = false;
+		bool isLeftOrBPressed = false;
+		bool isRightOrAPressed = false;
+	};
+
+	struct TimerStateSnapshot
+	{
+		uint8_t dividerRegister = 0;
+		uint8_t timerCounter = 0;
+		uint8_t timerModulo = 0;
+		uint8_t timerControlRegister = 0;
+	};
+
+	// The settings that belong to the hardware, shown by the settings windows. They are 
+	// changed by sending commands to the emulation thread, never by the window directly.
+	struct SettingsSnapshot
+	{
+		std::array<Color, 4> backgroundPaletteTints = { RGBA_WHITE, RGBA_WHITE, RGBA_WHITE, RGBA_WHITE };
+		std::array<Color, 4> spritePalette0Tints = { RGBA_WHITE, RGBA_WHITE, RGBA_WHITE, RGBA_WHITE };
+		std::array<Color, 4> spritePalette1Tints = { RGBA_WHITE, RGBA_WHITE, RGBA_WHITE, RGBA_WHITE };
+		uint32_t framesToSkip = 0;
+		uint32_t frameSkipInterval = 1;
+		bool isRenderingEnabled = true;
+
+		std::vector<std::string> outputDeviceNames;
+		std::string currentOutputDeviceName;
+		float masterVolume = 1.0f;
+		bool isMuted = false;
+		std::array<bool, 4> channelConnectionStates = { true, true, true, true };
+
+		SavedDataSearchType savedDataSearchType = SavedDataSearchType::EMULATOR_DIRECTORY;
+		bool isRTCWallClockCatchUpEnabled = true;
+		bool isGlobalChecksumVerificationEnabled = false;
+	};
+
+	// Copy of the emulated hardware's state, published by the emulation thread once per frame 
+	// so that the debug windows never have to read from the hardware while it is running.
+	struct EmulatorStateSnapshot
+	{
+		bool isROMLoaded = false;
+		bool isPaused = false;
+		uint32_t cyclesPerSecond = 0;
+		std::string romTitle;
+
+		bool isRewindEnabled = false;
+		double rewindHistoryDuration = 0.0;
+		size_t rewindBufferUsage = 0;
+		size_t rewindBufferCapacity = 0;
+
+		CPUStateSnapshot cpu;
+		VideoStateSnapshot video;
+		SoundStateSnapshot sound;
+		JoypadStateSnapshot joypad;
+		TimerStateSnapshot timer;
+		SettingsSnapshot settings;
+	};
+}
\ No newline at end of file
@@ -8,6 +8,9 @@
 #include "CPU/CPU.hpp"
 #include "Memory/MemoryMap.hpp"
 #include "Utils/Callbacks.hpp"
+#include "EmulatorStateSnapshot.hpp"
+#include "EmulatorCommand.hpp"
+#include "Input/InputMapping.hpp"
 
 namespace ModestGB
 {
@@ -30,18 +33,30 @@ namespace ModestGB
 		bool Initialize();
 		void Quit();
 		SDL_Window* GetSDLWindow();
-		void Render(const MemoryMap& memoryMap, PPU& ppu, const CPU& processor, APU& apu, Joypad& joypad, InputManager& inputManager, Cartridge& cartridge, const Timer& timer, uint32_t cyclesPerSecond, const std::vector<std::string>& logEntries);
+		void Render(const EmulatorStateSnapshot& snapshot, const PPU& ppu, const APU& apu, InputMapping& inputMapping, InputManager& inputManager, const std::vector<std::string>& logEntries);
 	
 		void RegisterFileSelectionCallback(FileSelectionCallback callback);
 		void RegisterPauseButtonCallback(SimpleCallback callback);
 		void RegisterStepButtonCallback(SimpleCallback callback);
 		void RegisterClearButtonCallback(SimpleCallback callback);
 		void RegisterQuitButtonCallback(SimpleCallback callback);
+		void RegisterSaveStateButtonCallback(SimpleCallback callback);
+		void RegisterLoadStateButtonCallback(SimpleCallback callback);
+		void RegisterRecordMovieFromPowerOnButtonCallback(SimpleCallback callback);
+		void RegisterRecordMovieFromCurrentStateButtonCallback(SimpleCallback callback);
+		void RegisterMovieFileSelectionCallback(FileSelectionCallback callback);
+		void RegisterStopMovieButtonCallback(SimpleCallback callback);
+
+		// The settings of the hardware are applied by the emulation thread, so changing one sends a command.
+		void RegisterSettingChangedCallback(EmulatorCommandCallback callback);
 
 		void SetPauseButtonLabel(const std::string& label);
+		bool IsRewindButtonHeld() const;
 
 		bool IsMaximized();
 		void SetMaximizedValue(bool value, bool modifyWindow);
+		bool IsVSyncEnabled() const;
+		void SetVSyncEnabled(bool value);
 		void Show();
 
 	private:
@@ -53,39 +68,54 @@ namespace ModestGB
 		SimpleCallback stepButtonPressedCallback;
 		SimpleCallback clearButtonPressedCallback;
 		SimpleCallback quitButtonPressedCallback;
+		SimpleCallback saveStateButtonPressedCallback;
+		SimpleCallback loadStateButtonPressedCallback;
+		SimpleCallback recordMovieFromPowerOnButtonPressedCallback;
+		SimpleCallback recordMovieFromCurrentStateButtonPressedCallback;
+		FileSelectionCallback movieFileSelectionCallback;
+		SimpleCallback stopMovieButtonPressedCallback;
+		EmulatorCommandCallback settingChangedCallback;
 
 		std::string pauseButtonLabel = "Pause";
+		bool isRewindButtonHeld = false;
 		bool isMaximized = false;
+		bool isVSyncEnabled = false;
 
 		ImGuiID dockspaceID = 0;
 
+		std::vector<float> capturedSamples;
+		std::vector<float> spectrum;
+		uint8_t spectrumSource = AUDIO_CAPTURE_MIXED_OUTPUT;
+
 		void StartFrame();
 		void ClearScreen();
 		void EndFrame();
 		void RenderMainWindow();
-		void RenderGameView(const PPU& ppu, const Cartridge& cartridge);
+		void RenderGameView(const PPU& ppu, const std::string& romTitle);
 		void RenderWindowWithFramebuffer(const std::string& title, const Framebuffer& framebuffer, bool* isOpen = nullptr);
-		void RenderCPUDebugWindow(const CPU& processor, const MemoryMap& memoryMap, uint32_t cyclesPerSecond);
-		void RenderSoundDebugWindow(APU& apu);
-		void RenderJoypadDebugWindow(const Joypad& joypad);
-		void RenderVideoRegistersDebugWindow(const PPU& ppu);
+		void RenderCPUDebugWindow(const EmulatorStateSnapshot& snapshot);
+		void RenderSoundDebugWindow(const APU& apu, const SoundStateSnapshot& sound, const SettingsSnapshot& settings);
+		void RenderSoundOutputBuffer(const AudioMetrics& metrics);
+		void RenderSoundOutput(const APU& apu);
+		void RenderJoypadDebugWindow(const JoypadStateSnapshot& joypad);
+		void RenderVideoRegistersDebugWindow(const VideoStateSnapshot& video);
 		void RenderTilesDebugWindow(const PPU& ppu);
 		void RenderSpritesDebugWindow(const PPU& ppu);
 		void RenderBackgroundTileMapDebugWindow(const PPU& ppu);
 		void RenderWindowTileMapDebugWindow(const PPU& ppu);
-		void RenderTimerDebugWindow(const Timer& timer);
+		void RenderTimerDebugWindow(const TimerStateSnapshot& timer);
 		void RenderLogWindow(const std::vector<std::string>& logEntries);
 		
-		void RenderSettingsWindow(PPU& ppu, APU& apu, Joypad& joypad, InputManager& inputManager, Cartridge& cartridge);
+		void RenderSettingsWindow(const SettingsSnapshot& settings, InputMapping& inputMapping, InputManager& inputManager);
 		void RenderSettingsWindowSelectableItem(const std::string& label, int selectableID, int& selectedWindowID);
 
-		void RenderVideoSettingsWindow(PPU& ppu);
-		void RenderAudioSettingsWindow(APU& apu);
-		void RenderControllerAndKeyboardSettingsWindow(Joypad& joypad, InputManager&);
-		void RenderControllerButtonComboBox(Joypad& joypad, GBButton gbButton, int row, float width);
-		void RenderKeyCodeComboBox(Joypad& joypad, GBButton gbButton, int row, float width);
-		void RenderColorPaletteButton(PPU& ppu, const std::string& label, uint16_t paletteAddress, uint8_t colorIndex, uint16_t& outPaletteAddress, uint8_t& outColorIndex, std::string& outLabel, bool& isColorPickerOpened);
-		void RenderSavedDataSettingsWindow(Cartridge& cartridge);
+		void RenderVideoSettingsWindow(const SettingsSnapshot& settings);
+		void RenderAudioSettingsWindow(const SettingsSnapshot& settings);
+		void RenderControllerAndKeyboardSettingsWindow(InputMapping& inputMapping, InputManager& inputManager);
+		void RenderControllerButtonComboBox(InputMapping& inputMapping, GBButton gbButton, int row, float width);
+		void RenderKeyCodeComboBox(InputMapping& inputMapping, GBButton gbButton, int row, float width);
+		void RenderColorPaletteButton(const SettingsSnapshot& settings, const std::string& label, uint16_t paletteAddress, uint8_t colorIndex, uint16_t& outPaletteAddress, uint8_t& outColorIndex, std::string& outLabel, bool& isColorPickerOpened);
+		void RenderSavedDataSettingsWindow(const SettingsSnapshot& settings);
 
 		void RenderRegister8(const std::string& label, uint8_t data, int column);
 		void RenderRegister16(const std::string& label, uint16_t data, int column);
@@ -100,6 +130,7 @@ namespace ModestGB
 
 		std::string GetPathFromFileBrowser(const std::string& filterFriendlyName, const std::string& filters);
 
+		Color GetPaletteTint(const SettingsSnapshot& settings, uint16_t paletteAddress, uint8_t colorIndex) const;
 		ImVec4 ConvertColorToImVec4(Color& color) const;
 		Color ConvertImVec4ToColor(ImVec4& vec) const;
 	};
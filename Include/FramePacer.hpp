@@ -0,0 +1,26 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+
+namespace ModestGB
+{
+	// Paces a loop to a fixed frame rate. Every deadline is derived from the time the pacer was started, 
+	// so rounding errors don't accumulate and the long term rate stays at the target frame rate.
+	class FramePacer
+	{
+	public:
+		FramePacer(double framesPerSecond);
+		void Reset();
+		void SetFrameRate(double framesPerSecond);
+
+		// Sleeps until the next frame is due. Returns immediately if the deadline was already missed.
+		void WaitForNextFrame();
+
+	private:
+		double secondsPerFrame;
+		std::chrono::steady_clock::time_point startTime;
+		uint64_t frameCount = 0;
+
+		std::chrono::steady_clock::time_point GetFrameDeadline(uint64_t frame) const;
+	};
+}
\ No newline at end of file
@@ -28,6 +28,9 @@ namespace ModestGB
 		void Tick() override;
 		void Reset() override;
 
+		void Serialize(StateWriter& writer) const;
+		void Deserialize(StateReader& reader);
+
 	private:
 		BackgroundPixelFetcherState currentState = BackgroundPixelFetcherState::FetchingTileIndex;
 		BackgroundPixelFetcherMode currentMode = BackgroundPixelFetcherMode::Background;
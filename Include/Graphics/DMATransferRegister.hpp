@@ -1,5 +1,6 @@
 #pragma once
 #include <cstdint>
+#include "Utils/StateSerialization.hpp"
 
 namespace ModestGB
 {
@@ -14,6 +15,9 @@ namespace ModestGB
 		uint16_t GetSourceEndAddress() const;
 		void Reset();
 
+		void Serialize(StateWriter& writer) const;
+		void Deserialize(StateReader& reader);
+
 	private:
 		bool isTransferPending = false;
 		uint8_t data = 0;
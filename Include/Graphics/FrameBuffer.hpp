@@ -1,10 +1,14 @@
 #pragma once
 #include <vector>
+#include <array>
+#include <atomic>
 #include "SDL.h"
 #include "Graphics/Color.hpp"
 
 namespace ModestGB
 {
+	// Triple-buffered framebuffer. The emulation writes pixels into the back buffer and publishes it once a frame is complete,
+	// while the presentation side uploads the most recently published buffer to the texture. Neither side ever waits on the other.
 	class Framebuffer
 	{
 	public:
@@ -16,17 +20,33 @@ namespace ModestGB
 		uint16_t GetWidth() const;
 		uint16_t GetHeight() const;
 		float GetAspectRatio() const;
-		void UploadData();
 		void Clear(const Color& color = RGBA_WHITE);
 		void Destroy();
 		const SDL_Texture* GetTexture() const;
 
+		// Called by the emulation when the back buffer contains a complete frame.
+		void Publish();
+
+		// Called by the presentation side, uploads the latest published frame to the texture if it hasn't been uploaded yet.
+		void UploadData();
+
 	private:
+		static const uint8_t BUFFER_COUNT = 3;
+
 		SDL_Texture* texture = nullptr;
 		SDL_PixelFormat* pixelFormat = nullptr;
 		uint16_t width = 0;
 		uint16_t height = 0;
 		float aspectRatio = 0;
-		std::vector<uint32_t> pixels;
+		std::array<std::vector<uint32_t>, BUFFER_COUNT> buffers;
+
+		// Only accessed by the emulation.
+		uint8_t backBufferIndex = 0;
+
+		// Only accessed by the presentation side.
+		uint8_t frontBufferIndex = 1;
+
+		// Index of the most recently published buffer, combined with a flag that is set until the buffer has been uploaded.
+		std::atomic<uint8_t> publishedBufferState = 2;
 	};
 }
\ No newline at end of file
@@ -27,9 +27,22 @@ namespace ModestGB
 		void DebugDrawSprites(uint32_t cycles);
 		void DebugDrawTiles(uint32_t cycles);
 
+		// Skips pixel output for the first [framesToSkip] frames of every [frameInterval] frames.
+		// Timing (mode lengths, STAT/LYC and VBlank interrupts) is unaffected. Whether a frame is drawn is 
+		// only decided as it starts (when VBlank starts), so both settings take effect from the next frame 
+		// and the frame being drawn is never cut short.
+		void SetFrameSkip(uint32_t framesToSkip, uint32_t frameInterval);
+		uint32_t GetFramesToSkip() const;
+		uint32_t GetFrameSkipInterval() const;
+		void SetRenderingEnabled(bool isEnabled);
+		bool IsRenderingEnabled() const;
+
 		void SetPaletteTint(uint16_t paletteAddress, uint8_t colorIndex, Color color);
 		Color GetPaletteTint(uint16_t paletteAddress, uint8_t colorIndex) const;
 
+		// Uploads the most recently completed frame of each framebuffer to its texture. Must be called from the thread that owns the renderer.
+		void UploadFramebuffers();
+
 		const Framebuffer& GetPrimaryFramebuffer() const;
 		const Framebuffer& GetTileDebugFramebuffer() const;
 		const Framebuffer& GetSpriteDebugFramebuffer() const;
@@ -45,6 +58,9 @@ namespace ModestGB
 		void WriteWY(uint8_t value);
 		void WriteWX(uint8_t value);
 		void WriteDMA(uint8_t value);
+		void WriteBGP(uint8_t value);
+		void WriteOBP0(uint8_t value);
+		void WriteOBP1(uint8_t value);
 		void WriteToVRAM(uint16_t address, uint8_t value);
 		void WriteToOAM(uint16_t address, uint8_t value);
 
@@ -57,9 +73,18 @@ namespace ModestGB
 		uint8_t ReadWY() const;
 		uint8_t ReadWX() const;
 		uint8_t ReadDMA() const;
+		uint8_t ReadBGP() const;
+		uint8_t ReadOBP0() const;
+		uint8_t ReadOBP1() const;
 		uint8_t ReadVRAM(uint16_t address) const;
 		uint8_t ReadOAM(uint16_t address) const;
 
+		bool IsDMATransferInProgress() const;
+
+		// Saves the emulated state only. The palette tints, frame skipping and the framebuffers are left untouched.
+		void Serialize(StateWriter& writer) const;
+		void Deserialize(StateReader& reader);
+
 	private:
 		enum class Mode
 		{
@@ -94,6 +119,9 @@ namespace ModestGB
 		Register8 lyc;
 		Register8 wy;
 		Register8 wx;
+		Register8 bgp;
+		Register8 obp0;
+		Register8 obp1;
 		BasicMemory oam = BasicMemory(160);
 		BasicMemory vram = BasicMemory(8 * KiB);
 		Register8 statInterruptLine;
@@ -110,6 +138,13 @@ namespace ModestGB
 		uint8_t numberOfPixelsToIgnore = 0;
 		uint8_t ignoredPixels = 0;
 
+		bool isRenderingEnabled = true;
+		bool isCurrentFrameRendered = true;
+		uint32_t framesToSkip = 0;
+		uint32_t frameSkipInterval = 1;
+		uint32_t frameSkipCounter = 0;
+		bool isFrameSkipRestartPending = false;
+
 		bool wasWYConditionTriggered = false;
 		bool wasWXConditionTriggered = false;
 		uint8_t windowLineCounter = 0;
@@ -130,9 +165,12 @@ namespace ModestGB
 		void UpdateLCDTransferMode(uint32_t& cycles);
 
 		void RefreshLYCFlag();
+		void AdvanceFrameSkipCounter();
 		void GetSpriteAtIndex(uint8_t index, Sprite& sprite) const;
 
 		void UpdateDMATransferProcess(uint32_t cycles);
+		void CopyDMASourceToOAM();
+		uint8_t ReadPalette(uint16_t paletteAddress) const;
 		void RenderPixel(Framebuffer& framebuffer, const Pixel& pixel, uint16_t scanlineX, uint16_t scanlineY);
 		
 		uint8_t NormalizedReadFromOAM(uint16_t address) const;
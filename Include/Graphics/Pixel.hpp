@@ -3,6 +3,7 @@
 #include "Utils/GBSpecs.hpp"
 #include "Utils/GraphicsUtils.hpp"
 #include "Utils/MemoryUtils.hpp"
+#include "Utils/StateSerialization.hpp"
 
 namespace ModestGB
 {
@@ -19,5 +20,23 @@ namespace ModestGB
 		// Use to determine priority of sprite pixels. When comparing sprite pixels, 
 		// the pixel that belongs to the sprite that appears first in OAM has priority.
 		uint8_t spriteOAMIndex = MAX_SPRITE_COUNT;
+
+		void Serialize(StateWriter& writer) const
+		{
+			writer.Write(colorIndex);
+			writer.Write(paletteAddress);
+			writer.Write(backgroundOverSprite);
+			writer.Write(spriteX);
+			writer.Write(spriteOAMIndex);
+		}
+
+		void Deserialize(StateReader& reader)
+		{
+			reader.Read(colorIndex);
+			reader.Read(paletteAddress);
+			reader.Read(backgroundOverSprite);
+			reader.Read(spriteX);
+			reader.Read(spriteOAMIndex);
+		}
 	};
 }
\ No newline at end of file
@@ -17,6 +17,9 @@ namespace ModestGB
 		void SetX(int16_t x);
 		void SetY(int16_t y);
 
+		void Serialize(StateWriter& writer) const;
+		void Deserialize(StateReader& reader);
+
 	protected:
 		int16_t x = 0;
 		int16_t y = 0;
@@ -1,5 +1,6 @@
 #pragma once
 #include <cstdint>
+#include "Utils/StateSerialization.hpp"
 
 namespace ModestGB
 {
@@ -29,5 +30,29 @@ namespace ModestGB
 		bool backgroundOverSprite = false;
 
 		uint8_t oamIndex = 0;
+
+		void Serialize(StateWriter& writer) const
+		{
+			writer.Write(x);
+			writer.Write(y);
+			writer.Write(tileIndex);
+			writer.Write(xFlip);
+			writer.Write(yFlip);
+			writer.Write(palette);
+			writer.Write(backgroundOverSprite);
+			writer.Write(oamIndex);
+		}
+
+		void Deserialize(StateReader& reader)
+		{
+			reader.Read(x);
+			reader.Read(y);
+			reader.Read(tileIndex);
+			reader.Read(xFlip);
+			reader.Read(yFlip);
+			reader.Read(palette);
+			reader.Read(backgroundOverSprite);
+			reader.Read(oamIndex);
+		}
 	};
 }
\ No newline at end of file
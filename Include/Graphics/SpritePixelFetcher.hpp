@@ -24,6 +24,9 @@ namespace ModestGB
 		void Tick() override;
 		void Reset() override;
 
+		void Serialize(StateWriter& writer) const;
+		void Deserialize(StateReader& reader);
+
 	private:
 		SpritePixelFetcherState currentState = SpritePixelFetcherState::Idle;
 		Sprite* currentSprite = nullptr;
@@ -0,0 +1,33 @@
+#pragma once
+#include <vector>
+#include <map>
+#include "Input/InputManager.hpp"
+#include "Input/GBButtons.hpp"
+
+namespace ModestGB
+{
+	struct ButtonKeyPair
+	{
+		ControllerButtonCode button;
+		KeyCode key;
+	};
+
+	// Which key and controller button press each button of the Game Boy. This is part of the 
+	// frontend, not of the emulated joypad, so it's only ever used by the UI thread.
+	class InputMapping
+	{
+	public:
+		InputMapping();
+		void LoadMapping(const std::map<GBButton, ButtonKeyPair>& mapping);
+		const std::map<GBButton, ButtonKeyPair>& GetMapping() const;
+		ControllerButtonCode GetControllerButtonCode(GBButton button) const;
+		KeyCode GetKeyCode(GBButton button) const;
+		void SetControllerButtonCode(GBButton button, ControllerButtonCode buttonCode);
+		void SetKeyCode(GBButton button, KeyCode keyCode);
+		std::vector<GBButton> GetButtonsMappedToKeyCode(KeyCode keyCode) const;
+		std::vector<GBButton> GetButtonsMappedToControllerButtonCode(ControllerButtonCode buttonCode) const;
+
+	private:
+		std::map<GBButton, ButtonKeyPair> mapping;
+	};
+}
\ No newline at end of file
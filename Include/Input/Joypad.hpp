@@ -1,33 +1,31 @@
 #pragma once
 #include <vector>
 #include <map>
-#include "Input/InputManager.hpp"
 #include "Input/GBButtons.hpp"
 #include "Memory/Memory.hpp"
+#include "Utils/StateSerialization.hpp"
 
 namespace ModestGB
 {
-	struct ButtonKeyPair
-	{
-		ControllerButtonCode button;
-		KeyCode key;
-	};
-
 	class Joypad
 	{
 	public:
-		Joypad(InputManager& inputManager, Memory& memoryMap);
-		void LoadInputMapping(const std::map<GBButton, ButtonKeyPair>& mapping);
-		const std::map<GBButton, ButtonKeyPair>& GetInputMapping() const;
-		ControllerButtonCode GetControllerButtonCode(GBButton button) const;
-		KeyCode GetKeyCode(GBButton button)const;
-		void SetControllerButtonCode(GBButton button, ControllerButtonCode buttonCode);
-		void SetKeyCode(GBButton button, KeyCode keyCode);
+		Joypad(Memory& memoryMap);
+
+		void SetButtonState(GBButton button, bool isPressed);
+
+		// The state of every button as a bit mask, with one bit per button in GBButton order.
+		uint8_t GetButtonStates() const;
+		void SetButtonStates(uint8_t states);
 
 		uint8_t Read() const;
 		void Write(uint8_t value);
 		void Reset();
 
+		// Only the state of the joypad itself is saved, the input mapping is part of the configuration.
+		void Serialize(StateWriter& writer) const;
+		void Deserialize(StateReader& reader);
+
 		bool IsActionButtonsSelected() const;
 		bool IsDirectionButtonsSelected() const;
 		bool IsDownOrStartPressed() const;
@@ -38,22 +36,10 @@ namespace ModestGB
 	private:
 		Memory* memoryMap;
 
-		std::map<GBButton, ButtonKeyPair> inputMapping;
-
 		std::map<GBButton, bool> buttonStates;
 		bool isActionButtonsSelected = false;
 		bool isDirectionButtonsSelected = false;
 
-		void OnKeyPressed(KeyCode keyCode);
-		void OnKeyReleased(KeyCode keyCode);
-		void SetButtonStateWithKeyCode(KeyCode keyCode, bool isPressed);
-
-		void OnControllerButtonPressed(ControllerButtonCode buttonCode);
-		void OnControllerButtonReleased(ControllerButtonCode buttonCode);
-		void SetButtonStateWithControllerButtonCode(ControllerButtonCode buttonCode, bool isPressed);
-
-		void SetButtonState(GBButton button, bool isPressed);
-
 		void ResetButtonStates();
 	};
 }
\ No newline at end of file
@@ -0,0 +1,38 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ModestGB
+{
+	// "MGBM"
+	const uint32_t INPUT_MOVIE_MAGIC = 0x4D42474D;
+	const uint32_t INPUT_MOVIE_VERSION = 2;
+
+	enum class MovieMode
+	{
+		None,
+		Recording,
+		Playing
+	};
+
+	// Recording of a play session that can be replayed exactly. A movie starts from a save state (taken right after a reset 
+	// for the movies that start at power-on), and stores the state of the joypad at the start of every frame, which is the 
+	// only point where the input changes. The save state is tied to the ROM it was made with, and so is the movie.
+	struct InputMovie
+	{
+		uint64_t romHash = 0;
+		bool startsAtPowerOn = false;
+
+		// Cycles the first frame is already ahead by, carried over from the frame before the movie started.
+		uint32_t initialExcessCycles = 0;
+
+		std::vector<uint8_t> initialState;
+
+		// The buttons held during each frame, see Joypad::GetButtonStates.
+		std::vector<uint8_t> frames;
+
+		bool SaveToFile(const std::string& path) const;
+		bool LoadFromFile(const std::string& path);
+	};
+}
\ No newline at end of file
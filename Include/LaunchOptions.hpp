@@ -0,0 +1,34 @@
+#pragma once
+#include <string>
+#include "Audio/AudioSink.hpp"
+
+namespace ModestGB
+{
+	// Options that can only be chosen when the emulator is launched, through the command line:
+	//   --audio=sdl|null|wav|raw    Where the audio goes (SDL by default).
+	//   --audio-output=<path>       File (or named pipe) written by the wav and raw audio sinks.
+	//   --rewind-buffer=<MiB>       Memory set aside for the rewind history (32 MiB by default, 0 disables rewinding).
+	//   --rewind-interval=<frames>  Number of frames between two states of the rewind history (2 by default).
+	//   --run-ahead=<frames>        Number of frames emulated ahead of the one shown, to hide the game's input lag (0 by default).
+	//   --frame-skip=<N>/<M>        Skips drawing the first N of every M frames, to save time on slow machines (0/1 by default).
+	//   --no-render                 Emulates without drawing any frame, e.g. to play movies headless.
+	//   --rom=<path>                ROM loaded on startup.
+	//   --movie=<path>              Movie played on startup, once the ROM given with --rom is loaded.
+	//   --uncapped                  Runs the emulation as fast as possible, without sound.
+	struct LaunchOptions
+	{
+		AudioSinkType audioSinkType = AudioSinkType::SDL;
+		std::string audioOutputPath;
+		uint32_t rewindBufferSizeInMiB = 32;
+		uint32_t rewindInterval = 2;
+		uint32_t runAheadFrames = 0;
+		uint32_t framesToSkip = 0;
+		uint32_t frameSkipInterval = 1;
+		bool isRenderingDisabled = false;
+		std::string romPath;
+		std::string moviePath;
+		bool isSpeedUncapped = false;
+	};
+
+	LaunchOptions ParseLaunchOptions(int argc, char* argv[]);
+}
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
-#include <vector>
 #include "Memory/Memory.hpp"
+#include "Memory/PagedBuffer.hpp"
+#include "Utils/StateSerialization.hpp"
 
 namespace ModestGB
 {
@@ -13,8 +14,16 @@ namespace ModestGB
 		uint8_t Read(uint16_t address) const override;
 		void Write(uint16_t address, uint8_t value) override;
 		void Reset() override;
+
+		void ReadBlock(uint16_t address, uint8_t* destination, uint16_t length) const override;
+		void WriteBlock(uint16_t address, const uint8_t* source, uint16_t length);
+
+		void Serialize(StateWriter& writer) const;
+		void Deserialize(StateReader& reader);
 	private:
 		int size = 0;
-		std::vector<uint8_t> data;
+
+		// Paged, so that forking the machine (see MachineSnapshot) shares the memory instead of copying it.
+		PagedBuffer data;
 	};
 }
\ No newline at end of file
@@ -3,8 +3,12 @@
 #include <string>
 #include <map>
 #include <vector>
+#include <span>
+#include <memory>
 #include "Utils/Arithmetic.hpp"
 #include "Memory/MemoryBankController.hpp"
+#include "Memory/ROMCache.hpp"
+#include "Memory/CartridgeHeader.hpp"
 
 namespace ModestGB
 {
@@ -14,30 +18,27 @@ namespace ModestGB
 		EMULATOR_DIRECTORY
 	};
 
-	enum class MemoryBankControllerType
-	{
-		None,
-		MBC1,
-		MBC2,
-		MBC3,
-		MBC5,
-		MBC6,
-		MBC7,
-		MMM01,
-		HuC1,
-		HuC3
-	};
-
 	class Cartridge : public Memory
 	{
 	public:
+		~Cartridge();
+
+		// Also accepts zip and gzip archives containing the ROM.
 		bool Load(const std::string& romFilePath);
 
+		// Loads a ROM, or an archive containing it, from memory. [romName] stands in for the path of the 
+		// ROM file when looking for its saved data.
+		bool Load(const uint8_t* data, size_t size, const std::string& romName);
+
 		MemoryBankControllerType GetMemoryBankControllerType();
 		uint32_t GetROMSize();
 		uint32_t GetRAMSize();
 		bool IsROMLoaded();
 		const std::string& GetROMTitle() const;
+		const CartridgeHeader& GetHeader() const;
+
+		// Hash of the whole ROM, computed when it is first loaded.
+		uint64_t GetROMHash() const;
 
 		void SetSavedDataSearchType(SavedDataSearchType searchType);
 		SavedDataSearchType GetSavedDataSearchType() const;
@@ -46,28 +47,59 @@ namespace ModestGB
 		void Write(uint16_t address, uint8_t value) override;
 		void Reset() override;
 
+		// Keeps the hardware on the cartridge that runs on its own (e.g. a real-time clock) in step with the CPU.
+		void Tick(uint32_t cycles);
+
+		// Saves the cartridge RAM and the banking state, along with enough of the header to tell whether 
+		// a state belongs to the loaded ROM. Loading a state made with a different ROM fails.
+		void Serialize(StateWriter& writer) const;
+		void Deserialize(StateReader& reader);
+
+		const std::string& GetSavedDataPath() const;
+
+		// While suspended, writes to the cartridge RAM aren't written to the saved data file. 
+		// Used for frames that are thrown away afterwards (by restoring a state).
+		void SetSavedDataWritesSuspended(bool isSuspended);
+		bool AreSavedDataWritesSuspended() const;
+
+		// Whether a real-time clock loaded from the saved data file is moved forward by the time the emulator was closed for. 
+		// Without it, the clock only counts the emulated time, and resumes where it was when the game was last played.
+		void SetRTCWallClockCatchUpEnabled(bool isEnabled);
+		bool IsRTCWallClockCatchUpEnabled() const;
+
+		// Verifying the global checksum means reading the whole ROM when it is loaded. A wrong checksum only 
+		// produces a warning, since the hardware never checks it and many homebrew ROMs don't set it.
+		void SetGlobalChecksumVerificationEnabled(bool isEnabled);
+		bool IsGlobalChecksumVerificationEnabled() const;
+
 	private:
 		std::fstream savedDataStream;
 		std::string savedDataPath;
 		bool isROMLoaded = false;
+		bool areSavedDataWritesSuspended = false;
+		bool isRTCWallClockCatchUpEnabled = true;
+		bool isGlobalChecksumVerificationEnabled = false;
+		bool hasRTC = false;
 		SavedDataSearchType savedDataSearchType = SavedDataSearchType::EMULATOR_DIRECTORY;
 
 		std::unique_ptr<MemoryBankController> memoryBankController;
 		MemoryBankControllerType memoryBankControllerType;
 
-		std::vector<uint8_t> ram;
-		std::vector<uint8_t> rom;
-		std::string romTitle;
+		PagedBuffer ram;
+		std::shared_ptr<const ROMImage> romImage;
+		std::span<const uint8_t> rom;
+		CartridgeHeader header;
 
-		bool Load(const std::vector<uint8_t>& romData);
+		bool Load(std::shared_ptr<const ROMImage> image);
+		void UpdateSavedDataPath(const std::string& romFilePath);
 
 		void InitializeMemoryBankController(uint8_t byte);
-		void DecodeROMSize(uint8_t byte);
-		void InitializeRAM(uint8_t byte);
+		void InitializeRAM(uint32_t ramSize);
 		bool IsRAMAddress(uint16_t address) const;
 		void WriteUnsupportedMBCMesage();
 
 		void OpenSavedDataFile();
+		void SaveRTC();
 
 		void OnRAMWrite(uint16_t address, uint8_t value);
 	};
@@ -0,0 +1,106 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <span>
+
+namespace ModestGB
+{
+	enum class MemoryBankControllerType
+	{
+		None,
+		MBC1,
+		MBC2,
+		MBC3,
+		MBC5,
+		MBC6,
+		MBC7,
+		MMM01,
+		HuC1,
+		HuC3
+	};
+
+	// Catridge header memory bank controller type codes
+
+	const uint8_t ROM_ONLY_CODE = 0x00;
+	const uint8_t MBC1_CODE = 0x01;
+	const uint8_t MBC1_RAM_CODE = 0x02;
+	const uint8_t MBC1_RAM_BATTERY_CODE = 0x03;
+	const uint8_t MBC2_CODE = 0x05;
+	const uint8_t MBC2_BATTERY_CODE = 0x06;
+	const uint8_t ROM_RAM_CODE = 0x08;
+	const uint8_t ROM_RAM_BATTERY_CODE = 0x09;
+	const uint8_t MMM01_CODE = 0x0B;
+	const uint8_t MMM01_RAM_CODE = 0x0C;
+	const uint8_t MMM01_RAM_BATTERY_CODE = 0x0D;
+	const uint8_t MBC3_TIMER_BATTERY_CODE = 0x0F;
+	const uint8_t MBC3_TIMER_RAM_BATTERY_CODE = 0x10;
+	const uint8_t MBC3_CODE = 0x11;
+	const uint8_t MBC3_RAM_CODE = 0x12;
+	const uint8_t MBC3_RAM_BATTERY_CODE = 0x13;
+	const uint8_t MBC5_CODE = 0x19;
+	const uint8_t MBC5_RAM_CODE = 0x1A;
+	const uint8_t MBC5_RAM_BATTERY_CODE = 0x1B;
+	const uint8_t MBC5_RUMBLE_CODE = 0x1C;
+	const uint8_t MBC5_RUMBLE_RAM_CODE = 0x1D;
+	const uint8_t MBC5_RUMBLE_RAM_BATTERY_CODE = 0x1E;
+	const uint8_t MBC6_CODE = 0x20;
+	const uint8_t MBC7_SENSOR_RUMBLE_RAM_BATTERY_CODE = 0x22;
+	const uint8_t HuC3_CODE = 0xFE;
+	const uint8_t HuC1_RAM_BATTERY_CODE = 0xFF;
+
+	// Catridge header RAM type codes
+
+	const uint8_t NO_RAM_CODE = 0x00; // No RAM
+	const uint8_t UNUSED_RAM_CODE = 0x01; // Unused
+	const uint8_t RAM_8KB_CODE = 0x02; // 1 bank
+	const uint8_t RAM_32KB_CODE = 0x03; // 4 banks of 8 KiB each 
+	const uint8_t RAM_128KB_CODE = 0x04; // 16 banks of 8 KiB each 
+	const uint8_t RAM_64KB_CODE = 0x05; // 8 banks of 8 KiB each
+
+	// Catridge header ROM type codes
+
+	const uint8_t ROM_32KB_CODE = 0x00; // 2 banks of 16 KiB each
+	const uint8_t ROM_64KB_CODE = 0x01; // 4 banks of 16 KiB each
+	const uint8_t ROM_128KB_CODE = 0x02; // 8 banks of 16 KiB each
+	const uint8_t ROM_256KB_CODE = 0x03; // 16 banks of 16 KiB each
+	const uint8_t ROM_512KB_CODE = 0x04; // 32 banks of 16 KiB each
+	const uint8_t ROM_1MB_CODE = 0x05; // 64 banks of 16 KiB each
+	const uint8_t ROM_2MB_CODE = 0x06; // 128 banks of 16 KiB each
+	const uint8_t ROM_4MB_CODE = 0x07; // 256 banks of 16 KiB each
+	const uint8_t ROM_8MB_CODE = 0x08; // 512 banks of 16 KiB each
+
+	// The cartridge header, at 0x0100 - 0x014F of every ROM. Parsing it only reads those bytes, 
+	// except for the optional global checksum verification, which reads the whole ROM.
+	struct CartridgeHeader
+	{
+		// ROMs must be at least large enough to contain the whole header.
+		static const uint16_t MIN_ROM_SIZE;
+
+		// The title exactly as stored: padded with zeros, and on CGB cartridges the last byte is the CGB flag.
+		std::string title;
+		uint8_t cartridgeType = 0;
+		uint8_t romSizeCode = 0;
+		uint8_t ramSizeCode = 0;
+		uint8_t headerChecksum = 0;
+		uint16_t globalChecksum = 0;
+
+		bool isLogoValid = false;
+
+		// The boot ROM refuses to start a cartridge whose header checksum is wrong.
+		bool isHeaderChecksumValid = false;
+
+		// Only set if the verification was requested.
+		bool isGlobalChecksumVerified = false;
+		bool isGlobalChecksumValid = false;
+
+		uint32_t GetROMSize() const;
+		uint32_t GetRAMSize() const;
+
+		// The controller the cartridge actually has, which isn't necessarily one the emulator supports.
+		MemoryBankControllerType GetMemoryBankControllerType() const;
+		bool HasRTC() const;
+
+		// Returns false if the ROM is too small to contain a header.
+		static bool Parse(std::span<const uint8_t> rom, CartridgeHeader& header, bool shouldVerifyGlobalChecksum);
+	};
+}
\ No newline at end of file
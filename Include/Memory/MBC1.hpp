@@ -14,6 +14,9 @@ namespace ModestGB
 		void Write(uint16_t address, uint8_t value) override;
 		void Reset() override;
 
+		void Serialize(StateWriter& writer) const override;
+		void Deserialize(StateReader& reader) override;
+
 	protected:
 		std::string GetName() const override;
 
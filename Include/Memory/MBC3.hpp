@@ -1,6 +1,5 @@
 #pragma once
 #include <array>
-#include <map>
 #include "Memory/MemoryBankController.hpp"
 #include "Memory/Register8.hpp"
 
@@ -9,12 +8,23 @@ namespace ModestGB
 	class MBC3 : public MemoryBankController
 	{
 	public:
-		MBC3();
+		MBC3(bool hasRTC);
 
 		uint8_t Read(uint16_t address) const override;
 		void Write(uint16_t address, uint8_t value) override;
 		void Reset() override;
 
+		void Serialize(StateWriter& writer) const override;
+		void Deserialize(StateReader& reader) override;
+
+		void Tick(uint32_t cycles) override;
+
+		// The clock is saved in the 48 bytes format shared by most emulators (the live registers, the latched 
+		// ones, then the time it was saved at). The older 44 bytes variant, with a 32-bit time, is also loaded.
+		bool HasRTC() const override;
+		void SaveRTC(std::vector<uint8_t>& data) const override;
+		bool LoadRTC(const std::vector<uint8_t>& data, bool shouldCatchUpWithWallClock) override;
+
 	protected:
 		std::string GetName() const override;
 
@@ -25,6 +35,19 @@ namespace ModestGB
 		bool isLatchingReady = false;
 		uint8_t romBankNumber = 1;
 		uint8_t ramBankNumber = 0;
-		std::map<uint8_t, uint8_t> rtcRegisters;
+
+		// The clock counts emulated cycles rather than reading the wall clock, so it stays in step with 
+		// the game at any speed, and save states, rewinding and movies restore it like the rest of the machine.
+		bool hasRTC = false;
+		uint32_t rtcCycles = 0;
+
+		// Seconds, minutes, hours, lower 8 bits of the day counter, then the upper bit of the day counter 
+		// along with the halt and carry flags. The game reads the latched copy.
+		std::array<uint8_t, 5> rtcRegisters{};
+		std::array<uint8_t, 5> latchedRTCRegisters{};
+
+		bool IsRTCHalted() const;
+		void AdvanceRTCBySecond();
+		void AdvanceRTC(uint64_t seconds);
 	};
 }
\ No newline at end of file
@@ -14,5 +14,9 @@ namespace ModestGB
 		virtual uint8_t Read(uint16_t address) const = 0;
 		virtual void Write(uint16_t address, uint8_t value) = 0;
 		virtual void Reset() = 0;
+
+		// Copies [length] bytes starting at [address] into [destination]. By default this falls back 
+		// to one Read() per byte, implementations backed by contiguous storage can copy the block directly.
+		virtual void ReadBlock(uint16_t address, uint8_t* destination, uint16_t length) const;
 	};
 }
\ No newline at end of file
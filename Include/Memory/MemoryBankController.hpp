@@ -1,11 +1,14 @@
 #pragma once
 #include <cstdint>
 #include <vector>
+#include <span>
 #include <string>
 #include <functional>
 #include "Utils/DataConversions.hpp"
 #include "Utils/MemoryUtils.hpp"
 #include "Memory/Memory.hpp"
+#include "Memory/PagedBuffer.hpp"
+#include "Utils/StateSerialization.hpp"
 
 namespace ModestGB
 {
@@ -19,13 +22,25 @@ namespace ModestGB
 
 		void SetRAMWriteCallback(RAMWriteCallback callback);
 			
-		void AttachRAM(std::vector<uint8_t>& ram);
-		void AttachROM(std::vector<uint8_t>& rom);
+		void AttachRAM(PagedBuffer& ram);
+		void AttachROM(std::span<const uint8_t> rom);
 
 		void Reset() override;
 		virtual uint8_t Read(uint16_t address) const override = 0;
 		virtual void Write(uint16_t address, uint8_t value) override = 0;
 
+		// Saves the banking state. The RAM itself belongs to the cartridge.
+		virtual void Serialize(StateWriter& writer) const = 0;
+		virtual void Deserialize(StateReader& reader) = 0;
+
+		// Advances the hardware that keeps running on its own (e.g. a real-time clock) by the given number of cycles.
+		virtual void Tick(uint32_t cycles);
+
+		// The real-time clock (if the cartridge has one) is stored after the RAM in the saved data file.
+		virtual bool HasRTC() const;
+		virtual void SaveRTC(std::vector<uint8_t>& data) const;
+		virtual bool LoadRTC(const std::vector<uint8_t>& data, bool shouldCatchUpWithWallClock);
+
 		// Calculates the physical ROM address using the RAM bank number, and distance from the beginning of 
 		// the ROM bank's address (in the virtual address range) to the target virtual address
 		static uint32_t CalculatePhysicalROMAddress(uint16_t romBankNumber, uint16_t virtualAddressRangeStart, uint16_t targetVirtualAddress);
@@ -37,8 +52,9 @@ namespace ModestGB
 	protected:
 		RAMWriteCallback ramWriteCallback;
 
-		std::vector<uint8_t>* ram{};
-		std::vector<uint8_t>* rom{};
+		PagedBuffer* ram{};
+		// The ROM is shared by every instance running the same game, and is read-only.
+		std::span<const uint8_t> rom;
 
 		virtual std::string GetName() const = 0;
 		void PrintMissingROMMessage() const;
@@ -48,7 +64,6 @@ namespace ModestGB
 
 		void WriteToRAM(uint32_t address, uint8_t value);
 		uint8_t ReadFromRAM(uint32_t address) const;
-		void WriteToROM(uint32_t address, uint8_t value);
 		uint8_t ReadFromROM(uint32_t address) const;
 
 		std::string GetMessageHeader() const;
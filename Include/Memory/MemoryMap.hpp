@@ -23,6 +23,7 @@ namespace ModestGB
 		uint8_t Read(uint16_t address) const override;
 		void Write(uint16_t address, uint8_t value) override;
 		void Reset() override;
+		void ReadBlock(uint16_t address, uint8_t* destination, uint16_t length) const override;
 
 		void AttachCartridge(Cartridge* cartridge);
 		void AttachPPU(PPU* ppu);
@@ -31,12 +32,10 @@ namespace ModestGB
 		void AttachVRAM(BasicMemory* vram);
 		void AttachWRAM(BasicMemory* wram);
 		void AttachHRAM(BasicMemory* hram);
-		void AttachEchoRAM(BasicMemory* echoRam);
-		void AttachGenericIO(BasicMemory* ioRegisters);
 		void AttachInterruptEnableRegister(Register8* interruptEnableRegister);
 		void AttachInterruptFlagRegister(Register8* interruptFlagRegister);
 		void AttachJoypadRegister(Joypad* joypadRegister);
-		void AttachRestrictedMemory(BasicMemory* restrictedMem);
+		void AttachSerialRegisters(Register8* dataRegister, Register8* controlRegister);
 
 	private:
 		Cartridge* cartridge;
@@ -45,13 +44,13 @@ namespace ModestGB
 		Timer* timer;
 		BasicMemory* wram;
 		BasicMemory* hram;
-		BasicMemory* echoRam;
-		BasicMemory* ioRegisters;
 		Register8* interruptEnableRegister;
 		Register8* interruptFlagRegister;
 		Joypad* joypad;
-		BasicMemory* restrictedMemory;
+		Register8* serialTransferDataRegister;
+		Register8* serialTransferControlRegister;
 
+		bool IsAccessibleDuringDMATransfer(uint16_t address) const;
 		uint8_t ReadIO(uint16_t address) const;
 		void WriteIO(uint16_t address, uint8_t value);
 		uint8_t WriteWithReadOnlyBits(uint8_t destination, uint8_t value, uint8_t bitMask);
@@ -0,0 +1,57 @@
+#pragma once
+#include <cstdint>
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace ModestGB
+{
+	// Byte buffer split into fixed size pages that are shared between copies. Copying a buffer only copies its 
+	// page table, and a page is only duplicated when one of the buffers sharing it writes to it (copy-on-write). 
+	// Pages that were never written to all share the same zeroed page.
+	class PagedBuffer
+	{
+	public:
+		static const size_t PAGE_SIZE = 256;
+
+		PagedBuffer(size_t size = 0);
+
+		size_t GetSize() const;
+
+		uint8_t Read(size_t address) const
+		{
+			return (*pages[address / PAGE_SIZE])[address % PAGE_SIZE];
+		}
+
+		void Write(size_t address, uint8_t value)
+		{
+			GetWritablePage(address / PAGE_SIZE)[address % PAGE_SIZE] = value;
+		}
+
+		void ReadBlock(size_t address, uint8_t* destination, size_t length) const;
+		void WriteBlock(size_t address, const uint8_t* source, size_t length);
+
+		// Zeroes the whole buffer. This doesn't copy anything, every page goes back to the shared zeroed page.
+		void Clear();
+
+	private:
+		using Page = std::array<uint8_t, PAGE_SIZE>;
+
+		size_t size = 0;
+		std::vector<std::shared_ptr<Page>> pages;
+
+		static const std::shared_ptr<Page>& GetZeroPage();
+
+		Page& GetWritablePage(size_t pageIndex)
+		{
+			// The page table of a buffer is only copied by the thread that owns it, so a page used by this 
+			// buffer alone can't become shared in the middle of a write.
+			std::shared_ptr<Page>& page = pages[pageIndex];
+
+			if (page.use_count() > 1)
+				page = std::make_shared<Page>(*page);
+
+			return *page;
+		}
+	};
+}
\ No newline at end of file
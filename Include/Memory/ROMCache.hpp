@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Utils/FileStamp.hpp"
+
+namespace ModestGB
+{
+	struct ROMImage
+	{
+		std::vector<uint8_t> data;
+		uint64_t hash = 0;
+	};
+
+	// Process-wide cache of the loaded ROMs. Every emulator instance running the same game shares one read-only 
+	// copy of its ROM, which is freed when the last instance using it unloads it. Images are matched by the hash 
+	// of their content, so the same game loaded from different paths is still only kept once.
+	class ROMCache
+	{
+	public:
+		// Returns nullptr if the file can't be read. Zip and gzip archives are decompressed in memory. A file that 
+		// is already loaded (same path, size and modification time) is returned without reading it again.
+		static std::shared_ptr<const ROMImage> LoadFile(const std::string& filePath);
+
+		// Returns the cached copy of [data] if there is one, or adds [data] to the cache.
+		static std::shared_ptr<const ROMImage> Acquire(std::vector<uint8_t>&& data);
+
+	private:
+		struct FileEntry
+		{
+			FileStamp stamp;
+			std::weak_ptr<const ROMImage> image;
+		};
+
+		static std::mutex cacheMutex;
+		static std::unordered_map<uint64_t, std::weak_ptr<const ROMImage>> imagesByHash;
+		static std::unordered_map<std::string, FileEntry> imagesByFilePath;
+
+		// Must be called with the cache locked.
+		static std::shared_ptr<const ROMImage> AcquireLocked(std::vector<uint8_t>&& data, uint64_t hash);
+		static void RemoveExpiredEntries();
+	};
+}
\ No newline at end of file
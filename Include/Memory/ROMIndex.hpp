@@ -0,0 +1,37 @@
+#pragma once
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "Memory/CartridgeHeader.hpp"
+#include "Utils/FileStamp.hpp"
+
+namespace ModestGB
+{
+	struct ROMIndexEntry
+	{
+		CartridgeHeader header;
+		FileStamp stamp;
+
+		// Zero until the ROM has been loaded, scanning a file only reads its header.
+		uint64_t romHash = 0;
+	};
+
+	// Process-wide index of the ROMs seen so far, so lists of thousands of ROMs can be built 
+	// without reading any of them completely.
+	class ROMIndex
+	{
+	public:
+		// Reads only the header of the file, and nothing at all if the file is already indexed and hasn't changed since.
+		static bool Scan(const std::string& filePath, ROMIndexEntry& entry);
+
+		// Records a ROM that was loaded completely, which also makes it possible to find it by its hash.
+		static void Add(const std::string& filePath, uint64_t romHash, const CartridgeHeader& header);
+		static bool FindByHash(uint64_t romHash, ROMIndexEntry& entry);
+
+	private:
+		static std::mutex indexMutex;
+		static std::unordered_map<std::string, ROMIndexEntry> entriesByFilePath;
+		static std::unordered_map<uint64_t, ROMIndexEntry> entriesByHash;
+	};
+}
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 #include <cstdint>
 #include "Memory/Memory.hpp"
+#include "Utils/BitField.hpp"
 
 namespace ModestGB
 {
@@ -18,6 +19,19 @@ namespace ModestGB
 		void Increase(uint8_t amount);
 		void Decrease(uint8_t amount);
 
+		// Typed field access, e.g. nrx2.Read(NRX2_ENVELOPE_INITIAL_VOLUME). Compiles down to a shift and a mask.
+		template <uint8_t Start, uint8_t End>
+		uint8_t Read(BitField<Start, End> field) const
+		{
+			return static_cast<uint8_t>(field.Get(data));
+		}
+
+		template <uint8_t Start, uint8_t End>
+		void Write(BitField<Start, End> field, uint8_t value)
+		{
+			data = static_cast<uint8_t>(field.Set(data, value));
+		}
+
 	private:
 		uint8_t data = 0;
 	};
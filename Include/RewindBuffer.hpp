@@ -0,0 +1,85 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+
+namespace ModestGB
+{
+	// Recent history of the emulated machine, used to rewind it. The emulation thread hands over full save states, and a 
+	// background thread compresses each one as a XOR delta against the state captured after it. Only the most recent 
+	// state is kept in full, and going back in time undoes the deltas from the newest to the oldest.
+	//
+	// The deltas live in a ring buffer of fixed capacity: when it is full, the oldest ones are overwritten.
+	// Apart from Start and Stop, every method must be called from the same thread (the emulation thread).
+	class RewindBuffer
+	{
+	public:
+		~RewindBuffer();
+
+		// Allocates [capacity] bytes for the compressed history and starts the background thread. 
+		// The most recent state and the buffers used to compress it come on top of that (about 3 times the size of a state).
+		void Start(size_t capacity);
+		void Stop();
+		bool IsStarted() const;
+
+		void Clear();
+
+		// Hands [state] over to the background thread. It is swapped with an internal buffer rather than copied, so [state] 
+		// is left with unspecified contents (but keeps a capacity that can be reused) when this returns. 
+		// If the background thread hasn't picked up the previous state yet, that state is dropped.
+		void Push(std::vector<uint8_t>& state);
+
+		// Copies the most recent state to [state] and removes it from the history, so that the next call returns the state 
+		// captured before it. The oldest state is never removed. Returns false if the history is empty.
+		bool Pop(std::vector<uint8_t>& state);
+
+		uint32_t GetStateCount() const;
+
+		// Number of bytes of the ring buffer taken by the compressed deltas, out of [GetCapacity].
+		size_t GetUsedCapacity() const;
+		size_t GetCapacity() const;
+
+	private:
+		struct Delta
+		{
+			size_t offset;
+			size_t size;
+
+			// Size of the state the delta turns the next state back into.
+			size_t stateSize;
+		};
+
+		// Only accessed by the background thread while a state is being compressed, otherwise only by the emulation thread.
+		std::vector<uint8_t> storage;
+		size_t writeOffset = 0;
+		std::deque<Delta> deltas;
+		size_t storedDeltaSize = 0;
+		std::vector<uint8_t> latestState;
+		bool hasLatestState = false;
+		std::vector<uint8_t> compressedState;
+		std::vector<uint8_t> workingState;
+
+		std::mutex mutex;
+		std::condition_variable condition;
+		std::vector<uint8_t> pendingState;
+		bool isStatePending = false;
+		bool isCompressing = false;
+		bool shouldStop = false;
+		std::thread compressionThread;
+
+		// Mirrors of the size of the history, so that they can be read without waiting for the background thread.
+		std::atomic<uint32_t> stateCount = 0;
+		std::atomic<size_t> usedCapacity = 0;
+
+		void RunCompression();
+		void AddState(std::vector<uint8_t>& state);
+		void StoreDelta(const std::vector<uint8_t>& delta, size_t stateSize);
+		void DropOldestDelta();
+		void ClearHistory();
+		void RefreshStatistics();
+	};
+}
\ No newline at end of file
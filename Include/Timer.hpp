@@ -1,6 +1,7 @@
 #pragma once
 #include <vector>
 #include "Memory/Memory.hpp"
+#include "Utils/StateSerialization.hpp"
 
 namespace ModestGB
 {
@@ -33,6 +34,9 @@ namespace ModestGB
 		void WriteToDividerRegister(uint8_t value);
 
 		void Reset();
+
+		void Serialize(StateWriter& writer) const;
+		void Deserialize(StateReader& reader);
 	private:
 		Memory& memoryMap;
 
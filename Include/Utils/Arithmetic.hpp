@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <vector>
 #include <string>
 
@@ -18,4 +19,21 @@ namespace ModestGB::Arithmetic
 
 	// Remaps the address to a value between 0 and [upperBound - lowerBound].
 	uint16_t NormalizeAddress(uint16_t operand, uint16_t lowerBound, uint16_t upperBound);
+
+	// Mask covering [End - Start + 1] bits, starting at bit 0.
+	template <uint8_t Start, uint8_t End>
+	constexpr uint32_t GetBitMask()
+	{
+		static_assert(Start <= End && End < 32, "Invalid bit range.");
+
+		// Shifting 2 instead of 1 keeps the full 32-bit range well defined (it wraps to 0, then to 0xFFFFFFFF).
+		return (2u << (End - Start)) - 1;
+	}
+
+	// Compile-time equivalent of GetBits(data, start, end).
+	template <uint8_t Start, uint8_t End>
+	constexpr uint32_t GetBits(uint32_t data)
+	{
+		return (data >> Start) & GetBitMask<Start, End>();
+	}
 }
\ No newline at end of file
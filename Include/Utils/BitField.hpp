@@ -0,0 +1,28 @@
+#pragma once
+#include <cstdint>
+#include "Utils/Arithmetic.hpp"
+
+namespace ModestGB
+{
+	// Describes the bits [Start, End] of a register. Reading or writing a field through this type
+	// resolves to a single shift and mask at compile time.
+	template <uint8_t Start, uint8_t End = Start>
+	struct BitField
+	{
+		static_assert(Start <= End && End < 32, "Invalid bit field range.");
+
+		static constexpr uint8_t START = Start;
+		static constexpr uint8_t WIDTH = (End - Start) + 1;
+		static constexpr uint32_t MASK = Arithmetic::GetBitMask<Start, End>();
+
+		static constexpr uint32_t Get(uint32_t data)
+		{
+			return Arithmetic::GetBits<Start, End>(data);
+		}
+
+		static constexpr uint32_t Set(uint32_t data, uint32_t value)
+		{
+			return (data & ~(MASK << Start)) | ((value & MASK) << Start);
+		}
+	};
+}
\ No newline at end of file
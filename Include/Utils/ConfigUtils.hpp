@@ -1,11 +1,11 @@
 #pragma once
 #include "Audio/APU.hpp"
 #include "Graphics/PPU.hpp"
-#include "Input/Joypad.hpp"
+#include "Input/InputMapping.hpp"
 #include "EmulatorWindow.hpp"
 
 namespace ModestGB::Config
 {
-	bool SaveConfiguration(const std::string& configFilePath, EmulatorWindow& window, const APU& apu, const PPU& ppu, const Joypad& joypad, const InputManager& inputManager, const Cartridge& cartride);
-	bool LoadConfiguration(const std::string& configFilePath, EmulatorWindow& window, APU& apu, PPU& ppu, Joypad& joypad, InputManager& inputManager, Cartridge& cartridge);
+	bool SaveConfiguration(const std::string& configFilePath, EmulatorWindow& window, const APU& apu, const PPU& ppu, const InputMapping& inputMapping, const InputManager& inputManager, const Cartridge& cartride);
+	bool LoadConfiguration(const std::string& configFilePath, EmulatorWindow& window, APU& apu, PPU& ppu, InputMapping& inputMapping, InputManager& inputManager, Cartridge& cartridge);
 }
\ No newline at end of file
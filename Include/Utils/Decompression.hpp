@@ -0,0 +1,18 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace ModestGB::Decompression
+{
+	// Decodes raw DEFLATE data (RFC 1951) into [output], which is cleared first. Fails rather than 
+	// producing more than [maxOutputSize] bytes, so a malicious archive can't exhaust the memory.
+	bool Inflate(const uint8_t* input, size_t inputSize, std::vector<uint8_t>& output, size_t maxOutputSize);
+
+	// Whether the data is a zip or gzip archive, recognized by its signature.
+	bool IsArchive(const uint8_t* data, size_t size);
+
+	// Decompresses a gzip file, or the ROM (.gb, .gbc or .rom, otherwise the first file) of a zip archive, straight into [rom]. 
+	// Only stored and deflated zip entries are supported. The CRC of the decompressed data is verified.
+	bool ExtractROM(const uint8_t* archive, size_t archiveSize, std::vector<uint8_t>& rom);
+}
\ No newline at end of file
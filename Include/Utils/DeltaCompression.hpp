@@ -0,0 +1,16 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace ModestGB::DeltaCompression
+{
+	// Encodes the XOR of [current] and [previous] into [delta] (which is cleared first). Consecutive states of the machine 
+	// mostly differ in a few places, so only the bytes that changed are stored: the delta is a sequence of runs made of the 
+	// number of unchanged bytes, the number of changed bytes, then the XORed changed bytes. The counts are stored as 
+	// variable length integers. When the sizes differ, the shorter buffer is treated as if it was padded with zeroes.
+	void EncodeXORDelta(const uint8_t* current, size_t currentSize, const uint8_t* previous, size_t previousSize, std::vector<uint8_t>& delta);
+
+	// Applies [delta] to [state] in place and resizes it to [resultSize]. XOR being its own inverse, applying a delta 
+	// to either of the buffers it was encoded from gives the other one. Returns false if the delta is malformed.
+	bool ApplyXORDelta(const uint8_t* delta, size_t deltaSize, std::vector<uint8_t>& state, size_t resultSize);
+}
\ No newline at end of file
@@ -0,0 +1,9 @@
+#pragma once
+#include <vector>
+
+namespace ModestGB::FFT
+{
+	// Computes the magnitude (in dB) of the first half of the spectrum of [samples], after applying a Hann window. 
+	// The number of samples must be a power of 2.
+	void ComputeMagnitudeSpectrum(const std::vector<float>& samples, std::vector<float>& magnitudes);
+}
\ No newline at end of file
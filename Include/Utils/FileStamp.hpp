@@ -0,0 +1,19 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+namespace ModestGB
+{
+	// Identifies a version of a file without reading it. A file whose stamp hasn't changed is assumed to have the same content.
+	struct FileStamp
+	{
+		std::string canonicalPath;
+		uintmax_t size = 0;
+		int64_t lastWriteTime = 0;
+
+		bool operator==(const FileStamp& other) const = default;
+
+		// Returns false if the file doesn't exist or can't be queried.
+		static bool Get(const std::string& filePath, FileStamp& stamp);
+	};
+}
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include <cstdint>
 #include "Memory/Memory.hpp"
 #include "Memory/Register8.hpp"
+#include "Utils/BitField.hpp"
 #include "Graphics/Color.hpp"
 
 namespace ModestGB
@@ -50,6 +51,17 @@ namespace ModestGB
 	const uint8_t LCDC_WINDOW_TILE_MAP_AREA_BIT_INDEX = 6;
 	const uint8_t LCDC_PPU_ENABLE_BIT_INDEX = 7;
 
+	// Typed views of the LCDC and STAT bits above, for use with Register8::Read/Write.
+	constexpr BitField<LCDC_BG_WINDOW_ENABLE_BIT_INDEX> LCDC_BG_WINDOW_ENABLE{};
+	constexpr BitField<LCDC_OBJ_ENABLE_BIT_INDEX> LCDC_OBJ_ENABLE{};
+	constexpr BitField<LCDC_OBJ_SIZE_BIT_INDEX> LCDC_OBJ_SIZE{};
+	constexpr BitField<LCDC_BG_TILE_MAP_AREA_BIT_INDEX> LCDC_BG_TILE_MAP_AREA{};
+	constexpr BitField<LCDC_BG_WINDOW_ADDRESSING_MODE_BIT_INDEX> LCDC_BG_WINDOW_ADDRESSING_MODE{};
+	constexpr BitField<LCDC_WINDOW_ENABLE_BIT_INDEX> LCDC_WINDOW_ENABLE{};
+	constexpr BitField<LCDC_WINDOW_TILE_MAP_AREA_BIT_INDEX> LCDC_WINDOW_TILE_MAP_AREA{};
+	constexpr BitField<LCDC_PPU_ENABLE_BIT_INDEX> LCDC_PPU_ENABLE{};
+	constexpr BitField<0, 1> STAT_MODE{};
+
 	// Sprite Attribute Table (OAM)
 	// ------------------------------
 	// Byte 0 = Y Position
@@ -91,6 +103,7 @@ namespace ModestGB
 
 	const uint16_t DMA_TRANSFER_DESTINATION_START_ADDRESS = 0xFE00;
 	const uint8_t DMA_TRANSFER_DURATION = 160;
+	const uint8_t DMA_TRANSFER_SIZE = 160;
 
 	const uint16_t TILE_DATA_START_ADDRESS = 0x8000;
 
@@ -0,0 +1,12 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+
+namespace ModestGB::Hashing
+{
+	// 64-bit FNV-1a hash. Used to identify ROMs, not for anything security related.
+	uint64_t ComputeFNV1a(const uint8_t* data, size_t size);
+
+	// The CRC-32 used by zip and gzip archives.
+	uint32_t ComputeCRC32(const uint8_t* data, size_t size);
+}
\ No newline at end of file
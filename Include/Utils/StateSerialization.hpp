@@ -0,0 +1,152 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <array>
+#include <vector>
+#include <string>
+#include <type_traits>
+#include "Memory/PagedBuffer.hpp"
+
+namespace ModestGB
+{
+	// "MGBS"
+	const uint32_t SAVE_STATE_MAGIC = 0x5342474D;
+
+	// Must be incremented whenever the layout of a component's state changes. Components can check 
+	// StateReader::GetVersion() to keep reading states written by older versions.
+	//   2: The MBC3 real-time clock counts emulated cycles.
+	//   3: Echo RAM, the unusable region and the generic I/O memory are replaced by the serial registers.
+	const uint32_t SAVE_STATE_VERSION = 3;
+	const uint32_t MIN_SUPPORTED_SAVE_STATE_VERSION = 1;
+
+	// The state of the whole machine, kept in memory to fork the emulation. The paged memories aren't copied 
+	// into [state], they share their pages with the machine until either side writes to them, so taking a 
+	// snapshot only costs the page tables and the few KiB of registers.
+	struct MachineSnapshot
+	{
+		std::vector<uint8_t> state;
+		std::vector<PagedBuffer> memories;
+	};
+
+	// Writes the state of the emulated hardware as a flat binary blob, in the host's byte order. 
+	// The target buffer is only grown when the state doesn't fit, so reusing the same buffer for 
+	// every save means that, after the first one, saving doesn't allocate.
+	class StateWriter
+	{
+	public:
+		StateWriter(std::vector<uint8_t>& buffer);
+
+		// Paged memories are shared with [memories] instead of being written out.
+		StateWriter(MachineSnapshot& snapshot);
+
+		void WriteHeader();
+
+		// Shrinks the buffer to the written state, and fills in the payload size if a header was written.
+		void Finish();
+
+		size_t GetSize() const;
+
+		void WriteBytes(const void* source, size_t length)
+		{
+			if (position + length > buffer->size())
+				buffer->resize(std::max(buffer->size() * 2, position + length));
+
+			std::memcpy(buffer->data() + position, source, length);
+			position += length;
+		}
+
+		template <typename T>
+		void Write(T value)
+		{
+			static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>, "Only plain values can be written directly.");
+			WriteBytes(&value, sizeof(T));
+		}
+
+		template <typename T, size_t N>
+		void Write(const std::array<T, N>& values)
+		{
+			static_assert(std::is_arithmetic_v<T>, "Only arrays of plain values can be written directly.");
+			WriteBytes(values.data(), sizeof(T) * N);
+		}
+
+		void Write(const std::string& value);
+		void Write(const PagedBuffer& memory);
+
+	private:
+		std::vector<uint8_t>* buffer;
+		std::vector<PagedBuffer>* sharedMemories = nullptr;
+		size_t position = 0;
+		size_t payloadStart = 0;
+	};
+
+	// Reads a state written by StateWriter. Reading past the end of the state doesn't throw, it marks 
+	// the reader as failed and yields zeros, so components can read unconditionally and the caller 
+	// checks HasFailed() once at the end.
+	class StateReader
+	{
+	public:
+		StateReader(const uint8_t* data, size_t size);
+		StateReader(const MachineSnapshot& snapshot);
+
+		// Validates the magic number, the version and the payload size.
+		bool ReadHeader();
+
+		uint32_t GetVersion() const;
+		bool HasFailed() const;
+		bool IsAtEnd() const;
+
+		// Marks the state as unusable, e.g. when it belongs to a different ROM.
+		void Fail();
+
+		void ReadBytes(void* destination, size_t length)
+		{
+			if (hasFailed || position + length > size)
+			{
+				hasFailed = true;
+				std::memset(destination, 0, length);
+				return;
+			}
+
+			std::memcpy(destination, data + position, length);
+			position += length;
+		}
+
+		template <typename T>
+		void Read(T& value)
+		{
+			static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>, "Only plain values can be read directly.");
+			ReadBytes(&value, sizeof(T));
+		}
+
+		template <typename T>
+		T Read()
+		{
+			T value;
+			Read(value);
+			return value;
+		}
+
+		template <typename T, size_t N>
+		void Read(std::array<T, N>& values)
+		{
+			static_assert(std::is_arithmetic_v<T>, "Only arrays of plain values can be read directly.");
+			ReadBytes(values.data(), sizeof(T) * N);
+		}
+
+		void Read(std::string& value);
+		void Skip(size_t length);
+
+		// Fails if the size of the memory doesn't match.
+		void Read(PagedBuffer& memory);
+
+	private:
+		const uint8_t* data;
+		size_t size;
+		const std::vector<PagedBuffer>* sharedMemories = nullptr;
+		size_t sharedMemoryIndex = 0;
+		size_t position = 0;
+		uint32_t version = 0;
+		bool hasFailed = false;
+	};
+}
\ No newline at end of file
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 
 namespace ModestGB::SystemTime
 {
@@ -13,4 +14,7 @@ namespace ModestGB::SystemTime
 	};
 
 	DateTime GetCurrentTime();
+
+	// Seconds elapsed since 1970-01-01 00:00 UTC.
+	int64_t GetUnixTime();
 }
\ No newline at end of file
@@ -1,34 +1,53 @@
 #include <vector>
 #include <string>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include "Audio/APU.hpp"
 #include "Logger.hpp"
 #include "Utils/GBSpecs.hpp"
-#include "Utils/Arithmetic.hpp"
 
 namespace ModestGB
 {
 	const std::string APU_MESSAGE_HEADER = "[APU]";
 	const uint8_t AUDIO_CHANNELS = 2;
 	const int SAMPLE_FREQUENCY = 44100;
-	const uint16_t MAX_SAMPLES_BUFFER_SIZE = 4096;
 	const uint32_t FRAME_SEQUENCER_PERIOD = static_cast<uint32_t>(std::floor(GB_CLOCK_SPEED / 512.0f));
-	const uint32_t SAMPLE_COLLECTION_TIMER_PERIOD = static_cast<uint32_t>(std::floor(GB_CLOCK_SPEED / static_cast<float>(SAMPLE_FREQUENCY)));
+	// Samples are read out of the blip buffers after every frame sequencer period (~2ms).
+	const uint32_t BLIP_FRAME_LENGTH = FRAME_SEQUENCER_PERIOD;
+	// Number of samples that should ideally be waiting in a real-time sink's queue.
+	const uint32_t TARGET_QUEUED_SAMPLE_COUNT = APU::SAMPLE_BLOCK_SIZE * 2;
+	// Beyond this amount, new samples are dropped instead of being queued, so the latency can't keep growing.
+	const uint32_t MAX_QUEUED_SAMPLE_COUNT = APU::SAMPLE_BLOCK_SIZE * 6;
+	// The emulated frame rate never matches the output device's clock exactly, so the sample rate is 
+	// nudged by up to 0.5% to keep the queue near its target. The resulting pitch change is inaudible.
+	const double MAX_SAMPLE_RATE_ADJUSTMENT = 0.005;
+	// The queue size reported by an audio device jumps by a whole device buffer at a time, so the fill error is 
+	// smoothed before it's used, otherwise the pitch would wobble with every callback.
+	const double FILL_ERROR_SMOOTHING = 0.1;
 	const float MASTER_VOLUME_MULTIPLIER = 0.075f;
+	const float MAX_CHANNEL_OUTPUT = 15.0f;
 
-	void APU::Initialize()
+	void APU::Initialize(std::unique_ptr<AudioSink> audioSink)
 	{
-		SDL_zero(currentAudioSpec);
-		currentAudioSpec.freq = SAMPLE_FREQUENCY;
-		currentAudioSpec.format = AUDIO_F32;
-		currentAudioSpec.channels = AUDIO_CHANNELS;
-		currentAudioSpec.samples = MAX_SAMPLES_BUFFER_SIZE;
+		sink = std::move(audioSink);
 
-		// By default, set the output device to the first available audio device.
-		SetOutputDevice(SDL_GetAudioDeviceName(0, SDL_FALSE));
-		RefreshAudioDeviceNames();
+		// Not having anywhere to play the audio isn't a reason to stop the emulator from running.
+		if (!sink->Open(SAMPLE_FREQUENCY, AUDIO_CHANNELS))
+		{
+			Logger::WriteWarning("Failed to open the audio output. The audio will be discarded.", APU_MESSAGE_HEADER);
+			sink = AudioSink::Create(AudioSinkType::Null, "");
+			sink->Open(SAMPLE_FREQUENCY, AUDIO_CHANNELS);
+		}
 
 		frameSequencerTimer.Restart(FRAME_SEQUENCER_PERIOD);
-		sampleCollectionTimer.Restart(SAMPLE_COLLECTION_TIMER_PERIOD);
+		SetSampleRateRatio(1.0);
+		RefreshChannelGains();
+
+		metrics.sampleRate = SAMPLE_FREQUENCY;
+		metrics.channelCount = AUDIO_CHANNELS;
+		metrics.targetQueuedSampleCount = TARGET_QUEUED_SAMPLE_COUNT;
+		metrics.maxQueuedSampleCount = MAX_QUEUED_SAMPLE_COUNT;
 	}
 
 	void APU::Reset()
@@ -39,12 +58,66 @@ namespace ModestGB
 		channel4.Reset();
 
 		frameSequencerTimer.Restart(FRAME_SEQUENCER_PERIOD);
-		sampleCollectionTimer.Restart(SAMPLE_COLLECTION_TIMER_PERIOD);
 
-		samples.clear();
+		leftBlipBuffer.Clear();
+		rightBlipBuffer.Clear();
+		blipFrameElapsedCycles = 0;
+		pendingCycles = 0;
+		leftChannelAmplitudes.fill(0);
+		rightChannelAmplitudes.fill(0);
+		capturedChannelAmplitudes.fill(0);
+
+		for (BlipBuffer& blipBuffer : channelCaptureBlipBuffers)
+			blipBuffer.Clear();
+
+		sampleBlockSize = 0;
+		sink->Clear();
+		isOutputPrimed = false;
+	}
+
+	void APU::Serialize(StateWriter& writer) const
+	{
+		writer.Write(isSoundControllerEnabled);
+		writer.Write(nr50.Read());
+		writer.Write(nr51.Read());
+		frameSequencerTimer.Serialize(writer);
+		writer.Write(frameSequencerStep);
+		writer.Write(pendingCycles);
+
+		writer.Write(channelStates.frequencyTimerCounters);
+		writer.Write(channelStates.frequencyTimerPeriods);
+		writer.Write(channelStates.outputs);
+		channel1.Serialize(writer);
+		channel2.Serialize(writer);
+		channel3.Serialize(writer);
+		channel4.Serialize(writer);
+	}
+
+	void APU::Deserialize(StateReader& reader)
+	{
+		reader.Read(isSoundControllerEnabled);
+		nr50.Write(reader.Read<uint8_t>());
+		nr51.Write(reader.Read<uint8_t>());
+		frameSequencerTimer.Deserialize(reader);
+		frameSequencerStep = reader.Read<uint8_t>() % 8;
+		reader.Read(pendingCycles);
+
+		reader.Read(channelStates.frequencyTimerCounters);
+		reader.Read(channelStates.frequencyTimerPeriods);
+		reader.Read(channelStates.outputs);
+		channel1.Deserialize(reader);
+		channel2.Deserialize(reader);
+		channel3.Deserialize(reader);
+		channel4.Deserialize(reader);
+
+		// The blip buffers keep going, so the output steps from the old state to the restored one instead of restarting.
+		RefreshChannelGains();
+		UpdateChannelOutputs();
+	}
 
-		if (currentAudioDeviceID > 0)
-			SDL_ClearQueuedAudio(currentAudioDeviceID);
+	void APU::Quit()
+	{
+		sink->Close();
 	}
 
 	float APU::GetMasterVolume() const
@@ -63,8 +136,9 @@ namespace ModestGB
 
 		if (isMuted)
 		{
-			samples.clear();
-			SDL_ClearQueuedAudio(currentAudioDeviceID);
+			sampleBlockSize = 0;
+			sink->Clear();
+			isOutputPrimed = false;
 		}
 	}
 
@@ -75,242 +149,547 @@ namespace ModestGB
 
 	const std::string& APU::GetCurrentOutputDeviceName() const
 	{
-		return currentAudioDeviceName;
+		return sink->GetCurrentOutputDeviceName();
 	}
 
 	const std::vector<std::string>& APU::GetAllOutputDeviceNames() const
 	{
-		return audioDeviceNames;
+		return sink->GetAllOutputDeviceNames();
 	}
 
 	void APU::SetOutputDevice(const std::string& audioDeviceName)
 	{
-		SDL_AudioDeviceID result = SDL_OpenAudioDevice(audioDeviceName.c_str(), SDL_FALSE, &currentAudioSpec, nullptr, 0);
+		sink->SetOutputDevice(audioDeviceName);
+	}
+
+	void APU::RefreshOutputDevices()
+	{
+		sink->RefreshOutputDevices();
+	}
 
-		if (result == 0)
+	void APU::Tick(uint32_t cycles)
+	{
+		pendingCycles += cycles;
+	}
+
+	void APU::SetOutputSuspended(bool isSuspended)
+	{
+		isOutputSuspended = isSuspended;
+
+		// Steps from the output levels from before the suspension to the current ones (if a different state was restored).
+		if (!isOutputSuspended)
+			UpdateChannelOutputs();
+	}
+
+	bool APU::IsOutputSuspended() const
+	{
+		return isOutputSuspended;
+	}
+
+	void APU::CatchUp()
+	{
+		if (isOutputSuspended)
 		{
-			Logger::WriteWarning("Failed to select output device: " + audioDeviceName, APU_MESSAGE_HEADER);
+			SkipPendingCycles();
 			return;
 		}
 
-		// Close the existing audio device, if any.
-		if (currentAudioDeviceID > 0)
-			SDL_CloseAudioDevice(currentAudioDeviceID);
+		while (pendingCycles > 0)
+		{
+			// Run the channels up to the next frame sequencer step (since that step may change their output), 
+			// or up to the end of the current blip frame, whichever comes first.
+			uint32_t cyclesUntilFrameSequencerStep = frameSequencerTimer.GetRemainingTicks();
+			uint32_t step = std::min(pendingCycles, BLIP_FRAME_LENGTH - blipFrameElapsedCycles);
+
+			if (cyclesUntilFrameSequencerStep != 0)
+				step = std::min(step, cyclesUntilFrameSequencerStep);
 
-		currentAudioDeviceID = result;
-		currentAudioDeviceName = audioDeviceName;
+			RunChannels(step);
+			pendingCycles -= step;
 
-		SDL_PauseAudioDevice(currentAudioDeviceID, SDL_FALSE);
-		Logger::WriteInfo("Selected output device: " + currentAudioDeviceName, APU_MESSAGE_HEADER);
+			if (frameSequencerTimer.Tick(step))
+			{
+				frameSequencerTimer.Restart(FRAME_SEQUENCER_PERIOD);
+				StepFrameSequencer();
+				UpdateChannelOutputs();
+			}
+
+			if (blipFrameElapsedCycles >= BLIP_FRAME_LENGTH)
+				EndBlipFrame();
+		}
 	}
 
-	void APU::RefreshOutputDevices()
+	void APU::SkipPendingCycles()
 	{
-		// Check if any audio devices were added or removed.
-		if (SDL_GetNumAudioDevices(SDL_FALSE) != audioDeviceNames.size())
+		// Same as CatchUp, except that the output levels are never sent to the blip buffers, so every channel can skip 
+		// straight to the next frame sequencer step. The blip frame doesn't advance either.
+		while (pendingCycles > 0)
 		{
-			Logger::WriteInfo("New audio device detected.", APU_MESSAGE_HEADER);
-			RefreshAudioDeviceNames();
+			uint32_t cyclesUntilFrameSequencerStep = frameSequencerTimer.GetRemainingTicks();
+			uint32_t step = cyclesUntilFrameSequencerStep != 0 ? std::min(pendingCycles, cyclesUntilFrameSequencerStep) : pendingCycles;
+
+			channel1.SkipFrequencyTimer(step);
+			channel2.SkipFrequencyTimer(step);
+			channel3.SkipFrequencyTimer(step);
+			channel4.SkipFrequencyTimer(step);
+			pendingCycles -= step;
+
+			if (frameSequencerTimer.Tick(step))
+			{
+				frameSequencerTimer.Restart(FRAME_SEQUENCER_PERIOD);
+				StepFrameSequencer();
+			}
 		}
 	}
 
-	void APU::Tick(uint32_t cycles)
+	void APU::StepFrameSequencer()
 	{
-		for (uint32_t i = 0; i < cycles; i++)
+		switch (frameSequencerStep)
 		{
-			if (frameSequencerTimer.Tick())
-			{
-				frameSequencerTimer.Restart(FRAME_SEQUENCER_PERIOD);
+		case 0:
+			channel1.TickLengthControlTimer();
+			channel2.TickLengthControlTimer();
+			channel3.TickLengthControlTimer();
+			channel4.TickLengthControlTimer();
+			break;
+		case 1:
+			break;
+		case 2:
+			channel1.TickSweepTimer();
+			channel1.TickLengthControlTimer();
+			channel2.TickLengthControlTimer();
+			channel3.TickLengthControlTimer();
+			channel4.TickLengthControlTimer();
+			break;
+		case 3:
+			break;
+		case 4:
+			channel1.TickLengthControlTimer();
+			channel2.TickLengthControlTimer();
+			channel3.TickLengthControlTimer();
+			channel4.TickLengthControlTimer();
+			break;
+		case 5:
+			break;
+		case 6:
+			channel1.TickSweepTimer();
+			channel1.TickLengthControlTimer();
+			channel2.TickLengthControlTimer();
+			channel3.TickLengthControlTimer();
+			channel4.TickLengthControlTimer();
+			break;
+		case 7:
+			channel1.TickVolumeEnvelopeTimer();
+			channel2.TickVolumeEnvelopeTimer();
+			channel4.TickVolumeEnvelopeTimer();
+			break;
+		}
 
-				switch (frameSequencerStep)
-				{
-				case 0:
-					channel1.TickLengthControlTimer();
-					channel2.TickLengthControlTimer();
-					channel3.TickLengthControlTimer();
-					channel4.TickLengthControlTimer();
-					break;
-				case 1:
-					break;
-				case 2:
-					channel1.TickSweepTimer();
-					channel1.TickLengthControlTimer();
-					channel2.TickLengthControlTimer();
-					channel3.TickLengthControlTimer();
-					channel4.TickLengthControlTimer();
-					break;
-				case 3:
-					break;
-				case 4:
-					channel1.TickLengthControlTimer();
-					channel2.TickLengthControlTimer();
-					channel3.TickLengthControlTimer();
-					channel4.TickLengthControlTimer();
-					break;
-				case 5:
-					break;
-				case 6:
-					channel1.TickSweepTimer();
-					channel1.TickLengthControlTimer();
-					channel2.TickLengthControlTimer();
-					channel3.TickLengthControlTimer();
-					channel4.TickLengthControlTimer();
-					break;
-				case 7:
-					channel1.TickVolumeEnvelopeTimer();
-					channel2.TickVolumeEnvelopeTimer();
-					channel4.TickVolumeEnvelopeTimer();
-					break;
-				}
-
-				frameSequencerStep = (frameSequencerStep + 1) % 8;
-			}
+		frameSequencerStep = (frameSequencerStep + 1) % 8;
+	}
+
+	template <typename Channel>
+	void APU::RunChannel(Channel& channel, uint8_t channelIndex, uint32_t cycles)
+	{
+		// If the output level can't change, or can't be heard, there's no need to visit every waveform step.
+		if (channel.HasConstantOutput() || (!IsChannelAudible(channelIndex) && !isCapturing))
+		{
+			channel.SkipFrequencyTimer(cycles);
+			UpdateChannelOutput(channelIndex, blipFrameElapsedCycles);
+			return;
+		}
 
-			channel1.TickFrequencyTimer();
-			channel2.TickFrequencyTimer();
-			channel3.TickFrequencyTimer();
-			channel4.TickFrequencyTimer();
+		// Only visit the cycles where the waveform steps, since the output level can't change in between.
+		uint32_t elapsedCycles = 0;
+		while (true)
+		{
+			uint32_t cyclesUntilWaveformStep = channel.GetRemainingFrequencyTimerCycles();
 
-			if (sampleCollectionTimer.Tick())
+			if (cyclesUntilWaveformStep == 0 || cyclesUntilWaveformStep > cycles - elapsedCycles)
 			{
-				sampleCollectionTimer.Restart(SAMPLE_COLLECTION_TIMER_PERIOD);
-
-				// Mix the sound channels, and add the samples to the buffer.
-				MixChannels();
+				channel.TickFrequencyTimer(cycles - elapsedCycles);
+				break;
 			}
 
-			if (samples.size() >= MAX_SAMPLES_BUFFER_SIZE)
-			{
-				// Prevents the audio queue from getting too large, which would cause the audio playback to become out of sync with the video playback.
-				while (SDL_GetQueuedAudioSize(currentAudioDeviceID) > MAX_SAMPLES_BUFFER_SIZE * sizeof(float)) {}
+			elapsedCycles += cyclesUntilWaveformStep;
+			channel.TickFrequencyTimer(cyclesUntilWaveformStep);
+			UpdateChannelOutput(channelIndex, blipFrameElapsedCycles + elapsedCycles);
+		}
+	}
+
+	void APU::RunChannels(uint32_t cycles)
+	{
+		RunChannel(channel1, 0, cycles);
+		RunChannel(channel2, 1, cycles);
+		RunChannel(channel3, 2, cycles);
+		RunChannel(channel4, 3, cycles);
+
+		blipFrameElapsedCycles += cycles;
+	}
+
+	void APU::UpdateChannelOutput(uint8_t channelIndex, uint32_t clockTime)
+	{
+		if (isOutputSuspended)
+			return;
+
+		float sample = channelStates.outputs[channelIndex];
+		float left = sample * leftChannelGains[channelIndex];
+		float right = sample * rightChannelGains[channelIndex];
 
-				if (SDL_QueueAudio(currentAudioDeviceID, samples.data(), static_cast<uint32_t>(samples.size() * sizeof(float))) < 0)
-					Logger::WriteError("SDL failed to play audio. Error: " + std::string(SDL_GetError()), APU_MESSAGE_HEADER);
+		if (left != leftChannelAmplitudes[channelIndex])
+		{
+			leftBlipBuffer.AddDelta(clockTime, left - leftChannelAmplitudes[channelIndex]);
+			leftChannelAmplitudes[channelIndex] = left;
+		}
+
+		if (right != rightChannelAmplitudes[channelIndex])
+		{
+			rightBlipBuffer.AddDelta(clockTime, right - rightChannelAmplitudes[channelIndex]);
+			rightChannelAmplitudes[channelIndex] = right;
+		}
+
+		// The captured output is taken before panning and NR50, so that every channel can be inspected on its own.
+		if (isCapturing)
+		{
+			float captured = sample * captureChannelGains[channelIndex];
 
-				samples.clear();
+			if (captured != capturedChannelAmplitudes[channelIndex])
+			{
+				channelCaptureBlipBuffers[channelIndex].AddDelta(clockTime, captured - capturedChannelAmplitudes[channelIndex]);
+				capturedChannelAmplitudes[channelIndex] = captured;
 			}
 		}
 	}
 
+	bool APU::IsChannelAudible(uint8_t channelIndex) const
+	{
+		return leftChannelGains[channelIndex] != 0 || rightChannelGains[channelIndex] != 0;
+	}
+
+	void APU::RefreshChannelGains()
+	{
+		// NR51 selects the sides each channel is sent to, and NR50 sets the volume of each side. 
+		// The sum of all 4 channels is averaged.
+		float leftVolume = (nr50.Read(NR50_LEFT_VOLUME) + 1) / 4.0f;
+		float rightVolume = (nr50.Read(NR50_RIGHT_VOLUME) + 1) / 4.0f;
+
+		for (uint8_t i = 0; i < 4; i++)
+		{
+			bool isConnected = connectionStates[i];
+			leftChannelGains[i] = isConnected && nr51.Read(i + 4) ? leftVolume : 0;
+			rightChannelGains[i] = isConnected && nr51.Read(i) ? rightVolume : 0;
+			captureChannelGains[i] = isConnected ? 1.0f / MAX_CHANNEL_OUTPUT : 0;
+		}
+	}
+
+	void APU::UpdateChannelOutputs()
+	{
+		for (uint8_t i = 0; i < 4; i++)
+			UpdateChannelOutput(i, blipFrameElapsedCycles);
+	}
+
+	void APU::EndBlipFrame()
+	{
+		// Picks up channels being connected or disconnected from the UI.
+		RefreshChannelGains();
+		UpdateChannelOutputs();
+
+		leftBlipBuffer.EndFrame(blipFrameElapsedCycles);
+		rightBlipBuffer.EndFrame(blipFrameElapsedCycles);
+
+		if (isCapturing)
+		{
+			for (BlipBuffer& blipBuffer : channelCaptureBlipBuffers)
+				blipBuffer.EndFrame(blipFrameElapsedCycles);
+		}
+
+		blipFrameElapsedCycles = 0;
+
+		uint32_t sampleCount = leftBlipBuffer.GetSamplesAvailable();
+		float* blockSamples = &sampleBlock[sampleBlockSize];
+
+		// Sinks expect the samples interleaved in left/right ordering.
+		leftBlipBuffer.ReadSamples(blockSamples, sampleCount, AUDIO_CHANNELS);
+		rightBlipBuffer.ReadSamples(blockSamples + 1, sampleCount, AUDIO_CHANNELS);
+
+		if (isCapturing)
+			CaptureBlipFrame(blockSamples, sampleCount);
+
+		// Capturing is only started or stopped between two frames, so the capture buffers never get half a frame.
+		if (isCapturing != isCaptureEnabled)
+		{
+			isCapturing = isCaptureEnabled;
+			capturedChannelAmplitudes.fill(0);
+
+			for (BlipBuffer& blipBuffer : channelCaptureBlipBuffers)
+				blipBuffer.Clear();
+		}
+
+		if (isMuted)
+			return;
+
+		// The panning and NR50 volume are already part of the blip buffers' output, so only the master volume is left.
+		float volume = masterVolume * MASTER_VOLUME_MULTIPLIER;
+		for (uint32_t i = 0; i < sampleCount * AUDIO_CHANNELS; i++)
+			blockSamples[i] *= volume;
+
+		sampleBlockSize += sampleCount * AUDIO_CHANNELS;
+
+		if (sampleBlockSize >= SAMPLE_BLOCK_SIZE)
+			QueueSamples();
+	}
+
+	void APU::CaptureBlipFrame(const float* mixedSamples, uint32_t sampleCount)
+	{
+		for (uint8_t i = 0; i < 4; i++)
+		{
+			uint32_t capturedCount = channelCaptureBlipBuffers[i].ReadSamples(captureSamples.data(), sampleCount);
+			captureBuffers[i].Write(captureSamples.data(), capturedCount);
+		}
+
+		// The mixed output is captured in mono, before the master volume is applied.
+		for (uint32_t i = 0; i < sampleCount; i++)
+			captureSamples[i] = (mixedSamples[i * AUDIO_CHANNELS] + mixedSamples[i * AUDIO_CHANNELS + 1]) * 0.5f * MASTER_VOLUME_MULTIPLIER;
+
+		captureBuffers[AUDIO_CAPTURE_MIXED_OUTPUT].Write(captureSamples.data(), sampleCount);
+	}
+
+	void APU::SetCaptureEnabled(bool isEnabled)
+	{
+		isCaptureEnabled = isEnabled;
+	}
+
+	void APU::ReadCapturedSamples(uint8_t source, float* destination, uint32_t count) const
+	{
+		captureBuffers[source].ReadLatest(destination, count);
+	}
+
+	void APU::SetSampleRateRatio(double ratio)
+	{
+		leftBlipBuffer.SetRates(GB_CLOCK_SPEED, SAMPLE_FREQUENCY * ratio);
+		rightBlipBuffer.SetRates(GB_CLOCK_SPEED, SAMPLE_FREQUENCY * ratio);
+
+		for (BlipBuffer& blipBuffer : channelCaptureBlipBuffers)
+			blipBuffer.SetRates(GB_CLOCK_SPEED, SAMPLE_FREQUENCY * ratio);
+	}
+
+	void APU::QueueSamples()
+	{
+		// Sinks that don't play in real time get every sample, at the nominal rate.
+		if (!sink->IsRealTime())
+		{
+			WriteSamplesToSink();
+			sampleBlockSize = 0;
+			return;
+		}
+
+		uint32_t queuedSampleCount = sink->GetQueuedSampleCount();
+		RecordQueueFill(queuedSampleCount);
+
+		// Playback is paced by the emulation thread, so the queue is never waited on here. If it's too 
+		// far ahead (e.g. the output device stalled), drop the samples instead.
+		if (queuedSampleCount < MAX_QUEUED_SAMPLE_COUNT)
+			WriteSamplesToSink();
+		else
+			metrics.droppedSampleCount += sampleBlockSize;
+
+		// Produce more samples when the queue is running dry, and fewer when it's filling up.
+		double fillError = (static_cast<double>(TARGET_QUEUED_SAMPLE_COUNT) - queuedSampleCount) / TARGET_QUEUED_SAMPLE_COUNT;
+		smoothedFillError += (std::clamp(fillError, -1.0, 1.0) - smoothedFillError) * FILL_ERROR_SMOOTHING;
+		SetSampleRateRatio(1.0 + smoothedFillError * MAX_SAMPLE_RATE_ADJUSTMENT);
+
+		sampleBlockSize = 0;
+	}
+
+	void APU::WriteSamplesToSink()
+	{
+		std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+		sink->Write(sampleBlock.data(), sampleBlockSize);
+		double writeMicroseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - startTime).count();
+
+		metrics.writtenBatchCount++;
+		metrics.lastWriteMicroseconds = writeMicroseconds;
+		metrics.maxWriteMicroseconds = std::max(metrics.maxWriteMicroseconds, writeMicroseconds);
+
+		size_t bucket = writeMicroseconds < 1 ? 0 : static_cast<size_t>(std::log2(writeMicroseconds)) + 1;
+		metrics.writeTimeHistogram[std::min(bucket, metrics.writeTimeHistogram.size() - 1)]++;
+
+		isOutputPrimed = true;
+	}
+
+	void APU::RecordQueueFill(uint32_t queuedSampleCount)
+	{
+		// An empty queue is only a problem once playback has started.
+		if (isOutputPrimed && queuedSampleCount == 0)
+			metrics.underrunCount++;
+
+		metrics.queuedSampleCount = queuedSampleCount;
+		metrics.sampleRateRatio = 1.0 + smoothedFillError * MAX_SAMPLE_RATE_ADJUSTMENT;
+
+		size_t bucket = static_cast<size_t>(queuedSampleCount) * AUDIO_QUEUE_FILL_HISTOGRAM_SIZE / MAX_QUEUED_SAMPLE_COUNT;
+		metrics.queueFillHistogram[std::min(bucket, metrics.queueFillHistogram.size() - 1)]++;
+
+		// The newest sample of the batch has to wait for everything queued before it, then for the device's own buffer.
+		uint32_t samplesAhead = queuedSampleCount + sampleBlockSize + sink->GetDeviceBufferSampleCount();
+		metrics.latencyMilliseconds = samplesAhead * 1000.0 / (static_cast<double>(SAMPLE_FREQUENCY) * AUDIO_CHANNELS);
+	}
+
+	const AudioMetrics& APU::GetMetrics() const
+	{
+		return metrics;
+	}
+
 	void APU::WriteToNR10(uint8_t value)
 	{
 		channel1.WriteToNRX0(value);
+		UpdateChannelOutput(0, blipFrameElapsedCycles);
 	}
 
 	void APU::WriteToNR11(uint8_t value)
 	{
 		channel1.WriteToNRX1(value);
+		UpdateChannelOutput(0, blipFrameElapsedCycles);
 	}
 
 	void APU::WriteToNR12(uint8_t value)
 	{
 		channel1.WriteToNRX2(value);
+		UpdateChannelOutput(0, blipFrameElapsedCycles);
 	}
 
 	void APU::WriteToNR13(uint8_t value)
 	{
 		channel1.WriteToNRX3(value);
+		UpdateChannelOutput(0, blipFrameElapsedCycles);
 	}
 
 	void APU::WriteToNR14(uint8_t value)
 	{
 		channel1.WriteToNRX4(value);
+		UpdateChannelOutput(0, blipFrameElapsedCycles);
 	}
 
 	void APU::WriteToNR21(uint8_t value)
 	{
 		channel2.WriteToNRX1(value);
+		UpdateChannelOutput(1, blipFrameElapsedCycles);
 	}
 
 	void APU::WriteToNR22(uint8_t value)
 	{
 		channel2.WriteToNRX2(value);
+		UpdateChannelOutput(1, blipFrameElapsedCycles);
 	}
 
 	void APU::WriteToNR23(uint8_t value)
 	{
 		channel2.WriteToNRX3(value);
+		UpdateChannelOutput(1, blipFrameElapsedCycles);
 	}
 
 	void APU::WriteToNR24(uint8_t value)
 	{
 		channel2.WriteToNRX4(value);
+		UpdateChannelOutput(1, blipFrameElapsedCycles);
 	}
 
 	void APU::WriteToNR30(uint8_t value)
 	{
 		channel3.WriteToNRX0(value);
+		UpdateChannelOutput(2, blipFrameElapsedCycles);
 	}
 
 	void APU::WriteToNR31(uint8_t value)
 	{
 		channel3.WriteToNRX1(value);
+		UpdateChannelOutput(2, blipFrameElapsedCycles);
 	}
 
 	void APU::WriteToNR32(uint8_t value)
 	{
 		channel3.WriteToNRX2(value);
+		UpdateChannelOutput(2, blipFrameElapsedCycles);
 	}
 
 	void APU::WriteToNR33(uint8_t value)
 	{
 		channel3.WriteToNRX3(value);
+		UpdateChannelOutput(2, blipFrameElapsedCycles);
 	}
 
 	void APU::WriteToNR34(uint8_t value)
 	{
 		channel3.WriteToNRX4(value);
+		UpdateChannelOutput(2, blipFrameElapsedCycles);
 	}
 
 	void APU::WriteToNR41(uint8_t value)
 	{
 		channel4.WriteToNRX1(value);
+		UpdateChannelOutput(3, blipFrameElapsedCycles);
 	}
 
 	void APU::WriteToNR42(uint8_t value)
 	{
 		channel4.WriteToNRX2(value);
+		UpdateChannelOutput(3, blipFrameElapsedCycles);
 	}
 
 	void APU::WriteToNR43(uint8_t value)
 	{
 		channel4.WriteToNRX3(value);
+		UpdateChannelOutput(3, blipFrameElapsedCycles);
 	}
 
 	void APU::WriteToNR44(uint8_t value)
 	{
 		channel4.WriteToNRX4(value);
+		UpdateChannelOutput(3, blipFrameElapsedCycles);
 	}
 
 	void APU::WriteToNR50(uint8_t value)
 	{
 		nr50.Write(value);
+		RefreshChannelGains();
+		UpdateChannelOutputs();
 	}
 
 	void APU::WriteToNR51(uint8_t value)
 	{
 		nr51.Write(value);
+		RefreshChannelGains();
+		UpdateChannelOutputs();
 	}
 
 	void APU::WriteToNR52(uint8_t value)
 	{
-		isSoundControllerEnabled = Arithmetic::GetBit(value, 7);
+		isSoundControllerEnabled = NR52_SOUND_ENABLE.Get(value);
 
 		if (isSoundControllerEnabled)
 			frameSequencerStep = 0;
 
-		for (uint8_t i = 0; i < 4; i++)
+		if (isSoundControllerEnabled)
 		{
-			if (!isSoundControllerEnabled)
-				channels[i]->DisableSoundController();
-			else
-				channels[i]->EnableSoundController();
+			channel1.EnableSoundController();
+			channel2.EnableSoundController();
+			channel3.EnableSoundController();
+			channel4.EnableSoundController();
 		}
+		else
+		{
+			channel1.DisableSoundController();
+			channel2.DisableSoundController();
+			channel3.DisableSoundController();
+			channel4.DisableSoundController();
+		}
+
+		UpdateChannelOutputs();
 	}
 
 	void APU::WriteToWavePatternRAM(uint16_t address, uint8_t value)
 	{
 		channel3.WriteToWavePatternRAM(address, value);
+		UpdateChannelOutput(2, blipFrameElapsedCycles);
 	}
 
 	uint8_t APU::ReadNR10() const
@@ -467,61 +846,4 @@ namespace ModestGB
 	{
 		return connectionStates[3];
 	}
-
-	void APU::MixChannels()
-	{
-		if (isMuted)
-			return;
-
-		float right = 0;
-		float left = 0;
-
-		uint8_t rightVolume = nr50.Read(0, 2) + 1;
-		uint8_t leftVolume = nr50.Read(4, 6) + 1;
-
-		for (uint8_t i = 0; i < 4; i++)
-		{
-			if (!connectionStates[i])
-				continue;
-
-			// Check if NR51 states that the sound should be sent to the right audio channel.
-			if (nr51.Read(i))
-				right += channels[i]->GetSample() * rightVolume;
-
-			// Check if NR51 states that the sound should be sent to the left audio channel.
-			if (nr51.Read(i + 4))
-				left += channels[i]->GetSample() * leftVolume;
-		}
-
-		// Average the samples.
-		right /= 4.0f;
-		left /= 4.0f;
-
-		// In stereo mode, SDL expects the samples in left/right ordering, so the left sample should be pushed first
-		samples.push_back(left * (masterVolume * MASTER_VOLUME_MULTIPLIER));
-		samples.push_back(right * (masterVolume * MASTER_VOLUME_MULTIPLIER));
-	}
-
-	void APU::RefreshAudioDeviceNames()
-	{
-		audioDeviceNames.clear();
-
-		bool isCurrentDeviceFound = false;
-		int outputDeviceCount = SDL_GetNumAudioDevices(SDL_FALSE);
-
-		for (int i = 0; i < outputDeviceCount; i++)
-		{
-			const char* name = SDL_GetAudioDeviceName(i, SDL_FALSE);
-
-			// Is the currently selected audio device still connected?
-			if (name == currentAudioDeviceName)
-				isCurrentDeviceFound = true;
-
-			audioDeviceNames.push_back(name);
-		}
-
-		// Is the currently selected audio device is no longer connected, then choose a new device.
-		if (!isCurrentDeviceFound)
-			SetOutputDevice(SDL_GetAudioDeviceName(std::max(outputDeviceCount - 1, 0), SDL_FALSE));
-	}
 }
\ No newline at end of file
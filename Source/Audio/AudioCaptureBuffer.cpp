@@ -0,0 +1,33 @@
+#include <algorithm>
+#include "Audio/AudioCaptureBuffer.hpp"
+
+namespace ModestGB
+{
+	const uint32_t INDEX_MASK = AUDIO_CAPTURE_BUFFER_SIZE - 1;
+
+	void AudioCaptureBuffer::Write(const float* source, uint32_t count, uint32_t stride)
+	{
+		uint32_t index = writeIndex.load(std::memory_order_relaxed);
+
+		for (uint32_t i = 0; i < count; i++)
+			samples[(index + i) & INDEX_MASK].store(source[i * stride], std::memory_order_relaxed);
+
+		// Publish the new samples.
+		writeIndex.store(index + count, std::memory_order_release);
+	}
+
+	void AudioCaptureBuffer::Clear()
+	{
+		for (std::atomic<float>& sample : samples)
+			sample.store(0, std::memory_order_relaxed);
+	}
+
+	void AudioCaptureBuffer::ReadLatest(float* destination, uint32_t count) const
+	{
+		count = std::min(count, AUDIO_CAPTURE_BUFFER_SIZE);
+		uint32_t firstIndex = writeIndex.load(std::memory_order_acquire) - count;
+
+		for (uint32_t i = 0; i < count; i++)
+			destination[i] = samples[(firstIndex + i) & INDEX_MASK].load(std::memory_order_relaxed);
+	}
+}
\ No newline at end of file
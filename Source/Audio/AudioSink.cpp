@@ -0,0 +1,58 @@
+#include "Audio/AudioSink.hpp"
+#include "Audio/SDLAudioSink.hpp"
+#include "Audio/NullAudioSink.hpp"
+#include "Audio/WAVAudioSink.hpp"
+#include "Audio/RawPCMAudioSink.hpp"
+
+namespace ModestGB
+{
+	const std::vector<std::string> NO_OUTPUT_DEVICES;
+
+	std::unique_ptr<AudioSink> AudioSink::Create(AudioSinkType type, const std::string& path)
+	{
+		switch (type)
+		{
+		case AudioSinkType::Null:
+			return std::unique_ptr<AudioSink>(new NullAudioSink());
+		case AudioSinkType::WAVFile:
+			return std::unique_ptr<AudioSink>(new WAVAudioSink(path));
+		case AudioSinkType::RawPCM:
+			return std::unique_ptr<AudioSink>(new RawPCMAudioSink(path));
+		default:
+			return std::unique_ptr<AudioSink>(new SDLAudioSink());
+		}
+	}
+
+	void AudioSink::Clear()
+	{
+	}
+
+	bool AudioSink::IsRealTime() const
+	{
+		return false;
+	}
+
+	uint32_t AudioSink::GetQueuedSampleCount() const
+	{
+		return 0;
+	}
+
+	uint32_t AudioSink::GetDeviceBufferSampleCount() const
+	{
+		return 0;
+	}
+
+	void AudioSink::RefreshOutputDevices()
+	{
+	}
+
+	const std::vector<std::string>& AudioSink::GetAllOutputDeviceNames() const
+	{
+		return NO_OUTPUT_DEVICES;
+	}
+
+	bool AudioSink::SetOutputDevice(const std::string& deviceName)
+	{
+		return false;
+	}
+}
\ No newline at end of file
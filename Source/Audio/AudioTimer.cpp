@@ -17,6 +17,26 @@ namespace ModestGB
 		return false;
 	}
 
+	bool AudioTimer::Tick(uint32_t ticks)
+	{
+		if (!isEnabled || counter == 0)
+			return false;
+
+		if (ticks >= counter)
+		{
+			counter = 0;
+			return true;
+		}
+
+		counter -= ticks;
+		return false;
+	}
+
+	uint32_t AudioTimer::GetRemainingTicks() const
+	{
+		return isEnabled ? counter : 0;
+	}
+
 	void AudioTimer::Disable()
 	{
 		isEnabled = false;
@@ -38,4 +58,18 @@ namespace ModestGB
 	{
 		return counter == 0;
 	}
+
+	void AudioTimer::Serialize(StateWriter& writer) const
+	{
+		writer.Write(period);
+		writer.Write(counter);
+		writer.Write(isEnabled);
+	}
+
+	void AudioTimer::Deserialize(StateReader& reader)
+	{
+		reader.Read(period);
+		reader.Read(counter);
+		reader.Read(isEnabled);
+	}
 }
\ No newline at end of file
@@ -0,0 +1,158 @@
+#include <array>
+#include <cmath>
+#include <algorithm>
+#include <numbers>
+#include "Audio/BlipBuffer.hpp"
+
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64)
+#include <xmmintrin.h>
+#define MODESTGB_BLIP_SSE
+#endif
+
+namespace ModestGB
+{
+	const uint8_t FRACTION_BITS = 32;
+	const uint8_t PHASE_BITS = 5;
+	const uint16_t PHASE_COUNT = 1 << PHASE_BITS;
+	const uint8_t INTERPOLATION_BITS = 15;
+	const uint8_t KERNEL_HALF_WIDTH = 8;
+	const uint8_t KERNEL_WIDTH = KERNEL_HALF_WIDTH * 2;
+
+	// Cutoff of the band-limited step, relative to the Nyquist frequency of the output.
+	const double KERNEL_CUTOFF = 0.9;
+
+	// The integrator leaks a little bit every sample, which acts as a high-pass filter that removes the DC offset 
+	// (like the capacitor on the real hardware does) and keeps rounding errors from accumulating.
+	const float INTEGRATOR_LEAK = 1.0f / 512.0f;
+
+	// The taps of a phase, and their difference to the taps of the next phase, so that the two can be 
+	// interpolated with a single multiply-add per tap.
+	struct KernelPhase
+	{
+		alignas(16) std::array<float, KERNEL_WIDTH> taps;
+		alignas(16) std::array<float, KERNEL_WIDTH> slopes;
+	};
+
+	using Kernel = std::array<KernelPhase, PHASE_COUNT>;
+
+	// Blackman-windowed sinc impulses, one for every sub-sample phase. Each phase is normalized so that 
+	// a delta always adds up to exactly its own height once integrated.
+	Kernel GenerateKernel()
+	{
+		std::array<std::array<float, KERNEL_WIDTH>, PHASE_COUNT + 1> phases{};
+
+		for (uint16_t phase = 0; phase <= PHASE_COUNT; phase++)
+		{
+			double sum = 0;
+
+			for (uint8_t i = 0; i < KERNEL_WIDTH; i++)
+			{
+				double x = i - (KERNEL_HALF_WIDTH - 1) - (phase / static_cast<double>(PHASE_COUNT));
+				double sinc = x == 0 ? 1.0 : std::sin(std::numbers::pi * KERNEL_CUTOFF * x) / (std::numbers::pi * KERNEL_CUTOFF * x);
+				double window = 0.42 + 0.5 * std::cos(std::numbers::pi * x / KERNEL_HALF_WIDTH) + 0.08 * std::cos(2 * std::numbers::pi * x / KERNEL_HALF_WIDTH);
+
+				phases[phase][i] = static_cast<float>(sinc * window);
+				sum += phases[phase][i];
+			}
+
+			for (uint8_t i = 0; i < KERNEL_WIDTH; i++)
+				phases[phase][i] = static_cast<float>(phases[phase][i] / sum);
+		}
+
+		Kernel kernel{};
+
+		for (uint16_t phase = 0; phase < PHASE_COUNT; phase++)
+		{
+			for (uint8_t i = 0; i < KERNEL_WIDTH; i++)
+			{
+				kernel[phase].taps[i] = phases[phase][i];
+				kernel[phase].slopes[i] = phases[phase + 1][i] - phases[phase][i];
+			}
+		}
+
+		return kernel;
+	}
+
+	const Kernel KERNEL = GenerateKernel();
+
+	BlipBuffer::BlipBuffer(uint32_t capacity) : capacity(capacity)
+	{
+		buffer = std::vector<float>(capacity + KERNEL_WIDTH);
+	}
+
+	void BlipBuffer::SetRates(double clockRate, double sampleRate)
+	{
+		factor = static_cast<uint64_t>(std::llround((sampleRate / clockRate) * (1ull << FRACTION_BITS)));
+	}
+
+	void BlipBuffer::Clear()
+	{
+		std::fill(buffer.begin(), buffer.end(), 0.0f);
+		samplesAvailable = 0;
+		offset = 0;
+		integrator = 0;
+	}
+
+	void BlipBuffer::AddDelta(uint32_t clockTime, float delta)
+	{
+		uint64_t position = offset + clockTime * factor;
+		uint32_t index = static_cast<uint32_t>(position >> FRACTION_BITS);
+
+		if (index + KERNEL_WIDTH > buffer.size())
+			return;
+
+		// Interpolate between the two closest phases of the kernel.
+		uint32_t phase = static_cast<uint32_t>(position >> (FRACTION_BITS - PHASE_BITS)) & (PHASE_COUNT - 1);
+		float interpolation = (static_cast<uint32_t>(position >> (FRACTION_BITS - PHASE_BITS - INTERPOLATION_BITS)) & ((1 << INTERPOLATION_BITS) - 1)) / static_cast<float>(1 << INTERPOLATION_BITS);
+
+		const KernelPhase& kernel = KERNEL[phase];
+		float* destination = &buffer[index];
+
+		// Every delta costs the same fixed amount of work, no matter the rate or the phase.
+#ifdef MODESTGB_BLIP_SSE
+		__m128 deltas = _mm_set1_ps(delta);
+		__m128 interpolations = _mm_set1_ps(interpolation);
+
+		for (uint8_t i = 0; i < KERNEL_WIDTH; i += 4)
+		{
+			__m128 taps = _mm_add_ps(_mm_load_ps(&kernel.taps[i]), _mm_mul_ps(_mm_load_ps(&kernel.slopes[i]), interpolations));
+			_mm_storeu_ps(&destination[i], _mm_add_ps(_mm_loadu_ps(&destination[i]), _mm_mul_ps(deltas, taps)));
+		}
+#else
+		for (uint8_t i = 0; i < KERNEL_WIDTH; i++)
+			destination[i] += delta * (kernel.taps[i] + kernel.slopes[i] * interpolation);
+#endif
+	}
+
+	void BlipBuffer::EndFrame(uint32_t clockDuration)
+	{
+		offset += clockDuration * factor;
+		samplesAvailable = std::min(static_cast<uint32_t>(offset >> FRACTION_BITS), capacity);
+	}
+
+	uint32_t BlipBuffer::GetSamplesAvailable() const
+	{
+		return samplesAvailable;
+	}
+
+	uint32_t BlipBuffer::ReadSamples(float* destination, uint32_t count, uint32_t stride)
+	{
+		count = std::min(count, samplesAvailable);
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			integrator += buffer[i];
+			destination[i * stride] = integrator;
+			integrator -= integrator * INTEGRATOR_LEAK;
+		}
+
+		// Move the samples that haven't been read yet (including the tails of the last deltas) to the front.
+		std::copy(buffer.begin() + count, buffer.end(), buffer.begin());
+		std::fill(buffer.end() - count, buffer.end(), 0.0f);
+
+		samplesAvailable -= count;
+		offset -= static_cast<uint64_t>(count) << FRACTION_BITS;
+
+		return count;
+	}
+}
\ No newline at end of file
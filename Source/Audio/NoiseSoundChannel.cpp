@@ -1,18 +1,72 @@
 #include <string>
+#include <array>
+#include <algorithm>
 #include "Audio/NoiseSoundChannel.hpp"
 #include "Logger.hpp"
 
 namespace ModestGB
 {
-	NoiseSoundChannel::NoiseSoundChannel() : SoundChannel()
+	// Lengths of the sequences generated by the 15-bit and 7-bit shift registers.
+	const uint16_t LONG_SHIFT_REGISTER_PERIOD = 32767;
+	const uint16_t SHORT_SHIFT_REGISTER_PERIOD = 127;
+	const uint16_t SHIFT_REGISTER_TRIGGER_STATE = 0x7FFF;
+
+	// Every state of the shift register, starting from the state it's in after a trigger. In 7-bit mode, the 
+	// lower 7 bits (which the output depends on) cycle on their own every 127 steps. The upper bits only hold 
+	// copies of recently shifted in bits, and are kept as they are on the first lap.
+	template <uint16_t Period>
+	std::array<uint16_t, Period> GenerateShiftRegisterStates(bool isShort)
+	{
+		std::array<uint16_t, Period> states{};
+		uint16_t shiftRegister = SHIFT_REGISTER_TRIGGER_STATE;
+
+		for (uint16_t i = 0; i < Period; i++)
+		{
+			states[i] = shiftRegister;
+
+			uint16_t xorResult = (shiftRegister ^ (shiftRegister >> 1)) & 1;
+			shiftRegister = (shiftRegister >> 1) | (xorResult << 14);
+
+			if (isShort)
+				shiftRegister = (shiftRegister & ~(1 << 6)) | (xorResult << 6);
+		}
+
+		return states;
+	}
+
+	const std::array<uint16_t, LONG_SHIFT_REGISTER_PERIOD> LONG_SHIFT_REGISTER_STATES = GenerateShiftRegisterStates<LONG_SHIFT_REGISTER_PERIOD>(false);
+	const std::array<uint16_t, SHORT_SHIFT_REGISTER_PERIOD> SHORT_SHIFT_REGISTER_STATES = GenerateShiftRegisterStates<SHORT_SHIFT_REGISTER_PERIOD>(true);
+
+	NoiseSoundChannel::NoiseSoundChannel(SoundChannelStates& states, uint8_t index) : SoundChannel(states, index)
 	{
+		RefreshShiftRegisterWidth();
 	}
 
 	void NoiseSoundChannel::Reset()
 	{
 		SoundChannel::Reset();
 
-		shiftRegister.Fill(false);
+		shiftRegisterPosition = 0;
+		RefreshShiftRegisterWidth();
+		RefreshOutput();
+	}
+
+	void NoiseSoundChannel::Serialize(StateWriter& writer) const
+	{
+		SoundChannel::Serialize(writer);
+
+		writer.Write(shiftRegisterPosition);
+	}
+
+	void NoiseSoundChannel::Deserialize(StateReader& reader)
+	{
+		SoundChannel::Deserialize(reader);
+
+		// The width is selected by NRX3 directly, since RefreshShiftRegisterWidth() would carry over the bits of the previous state.
+		bool isShort = IsShiftRegisterShort();
+		shiftRegisterStates = isShort ? SHORT_SHIFT_REGISTER_STATES.data() : LONG_SHIFT_REGISTER_STATES.data();
+		shiftRegisterPeriod = isShort ? SHORT_SHIFT_REGISTER_PERIOD : LONG_SHIFT_REGISTER_PERIOD;
+		shiftRegisterPosition = reader.Read<uint16_t>() % shiftRegisterPeriod;
 	}
 
 	void NoiseSoundChannel::WriteToNRX1(uint8_t value)
@@ -27,12 +81,22 @@ namespace ModestGB
 		SoundChannel::WriteToNRX2(value);
 
 		// If the upper 5 bits of NR42 are 0, then this channel is disabled.
-		if (nrx2.Read(3, 7) == 0)
+		if (nrx2.Read(NRX2_DAC_ENABLE) == 0)
 			isEnabled = false;
 
 		// If the period is 0, then stop the volume envelope.
 		if (GetVolumeEnvelopeTimerPeriod() == 0)
 			DisableVolumeEnvelope();
+
+		RefreshOutput();
+	}
+
+	void NoiseSoundChannel::WriteToNRX3(uint8_t value)
+	{
+		SoundChannel::WriteToNRX3(value);
+
+		if (IsShiftRegisterShort() != (shiftRegisterStates == SHORT_SHIFT_REGISTER_STATES.data()))
+			RefreshShiftRegisterWidth();
 	}
 
 	uint8_t NoiseSoundChannel::ReadNRX0() const
@@ -50,68 +114,71 @@ namespace ModestGB
 		return SoundChannel::ReadNRX4() | 0xBF;
 	}
 
-	uint16_t NoiseSoundChannel::GetFrequencyTimerPeriod() const
+	uint32_t NoiseSoundChannel::GetFrequencyTimerPeriod() const
 	{
-		uint8_t divisorCode = nrx3.Read(0, 2);
+		uint8_t divisorCode = nrx3.Read(NRX3_NOISE_CLOCK_DIVIDER);
 		return (divisorCode == 0 ? 8 : divisorCode * 16) << GetFrequencyShift();
 	}
 
-	void NoiseSoundChannel::OnFrequencyTimerReachedZero()
-	{
-		SoundChannel::OnFrequencyTimerReachedZero();
-
-		uint8_t xorResult = shiftRegister.Read(0) ^ shiftRegister.Read(1);
-		shiftRegister.Write(shiftRegister.Read() >> 1);
-		shiftRegister.SetBit(14, xorResult);
-
-		if (GetShiftRegisterSize() == 7)
-			shiftRegister.SetBit(6, xorResult);
-	}
-
-	float NoiseSoundChannel::GenerateSample() const
-	{
-		return static_cast<float>(((~shiftRegister.Read()) & 1) * volume);
-	}
-
 	uint16_t NoiseSoundChannel::GetLengthTimerPeriod() const
 	{
-		return nrx1.Read(0, 5);
+		return nrx1.Read(NRX1_LENGTH_TIMER);
 	}
 
-	SoundChannel::ModifierDirection NoiseSoundChannel::GetVolumeEnvelopeDirection() const
+	ModifierDirection NoiseSoundChannel::GetVolumeEnvelopeDirection() const
 	{
-		return nrx2.Read(3) ?  ModifierDirection::Increase : ModifierDirection::Decrease;
+		return nrx2.Read(NRX2_ENVELOPE_DIRECTION) ?  ModifierDirection::Increase : ModifierDirection::Decrease;
 	}
 
 	uint8_t NoiseSoundChannel::GetInitialEnvelopeVolume() const
 	{
-		return nrx2.Read(4, 7);
+		return nrx2.Read(NRX2_ENVELOPE_INITIAL_VOLUME);
 	}
 
 	uint16_t NoiseSoundChannel::GetVolumeEnvelopeTimerPeriod() const
 	{
-		return nrx2.Read(0, 2);
-	}
-
-	bool NoiseSoundChannel::IsConstrainedByLength() const
-	{
-		return nrx4.Read(6);
+		return nrx2.Read(NRX2_ENVELOPE_PERIOD);
 	}
 
 	void NoiseSoundChannel::OnTrigger()
 	{
 		SoundChannel::OnTrigger();
 
-		shiftRegister.Fill(1);
+		// Both sequences start from the state the shift register is reset to.
+		shiftRegisterPosition = 0;
 	}
 
-	uint8_t NoiseSoundChannel::GetShiftRegisterSize() const
+	bool NoiseSoundChannel::IsShiftRegisterShort() const
 	{
-		return nrx3.Read(3);
+		return nrx3.Read(NRX3_NOISE_SHIFT_REGISTER_WIDTH);
+	}
+
+	void NoiseSoundChannel::RefreshShiftRegisterWidth()
+	{
+		// Switching widths without a trigger keeps the bits of the shift register, so continue from the position 
+		// of the same bits in the other sequence. Only the lower 7 bits matter in 7-bit mode.
+		uint16_t currentState = shiftRegisterStates != nullptr ? shiftRegisterStates[shiftRegisterPosition] : SHIFT_REGISTER_TRIGGER_STATE;
+
+		if (IsShiftRegisterShort())
+		{
+			auto it = std::find_if(SHORT_SHIFT_REGISTER_STATES.begin(), SHORT_SHIFT_REGISTER_STATES.end(), [currentState](uint16_t state) { return (state & 0x7F) == (currentState & 0x7F); });
+
+			shiftRegisterStates = SHORT_SHIFT_REGISTER_STATES.data();
+			shiftRegisterPeriod = SHORT_SHIFT_REGISTER_PERIOD;
+			shiftRegisterPosition = it != SHORT_SHIFT_REGISTER_STATES.end() ? static_cast<uint16_t>(it - SHORT_SHIFT_REGISTER_STATES.begin()) : 0;
+		}
+		else
+		{
+			auto it = std::find(LONG_SHIFT_REGISTER_STATES.begin(), LONG_SHIFT_REGISTER_STATES.end(), currentState);
+
+			shiftRegisterStates = LONG_SHIFT_REGISTER_STATES.data();
+			shiftRegisterPeriod = LONG_SHIFT_REGISTER_PERIOD;
+			shiftRegisterPosition = it != LONG_SHIFT_REGISTER_STATES.end() ? static_cast<uint16_t>(it - LONG_SHIFT_REGISTER_STATES.begin()) : 0;
+		}
 	}
 
 	uint8_t NoiseSoundChannel::GetFrequencyShift() const
 	{
-		return nrx3.Read(4, 7) + 1;
+		return nrx3.Read(NRX3_NOISE_CLOCK_SHIFT) + 1;
 	}
 }
\ No newline at end of file
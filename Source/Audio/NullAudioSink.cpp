@@ -0,0 +1,24 @@
+#include "Audio/NullAudioSink.hpp"
+
+namespace ModestGB
+{
+	const std::string NULL_AUDIO_SINK_NAME = "None";
+
+	bool NullAudioSink::Open(uint32_t, uint8_t)
+	{
+		return true;
+	}
+
+	void NullAudioSink::Close()
+	{
+	}
+
+	void NullAudioSink::Write(const float*, uint32_t)
+	{
+	}
+
+	const std::string& NullAudioSink::GetCurrentOutputDeviceName() const
+	{
+		return NULL_AUDIO_SINK_NAME;
+	}
+}
\ No newline at end of file
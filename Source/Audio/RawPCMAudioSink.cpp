@@ -0,0 +1,47 @@
+#include "Audio/RawPCMAudioSink.hpp"
+#include "Logger.hpp"
+
+namespace ModestGB
+{
+	const std::string RAW_PCM_AUDIO_SINK_MESSAGE_HEADER = "[Raw PCM Audio]";
+
+	RawPCMAudioSink::RawPCMAudioSink(const std::string& path) : path(path)
+	{
+	}
+
+	RawPCMAudioSink::~RawPCMAudioSink()
+	{
+		Close();
+	}
+
+	bool RawPCMAudioSink::Open(uint32_t sampleRate, uint8_t channelCount)
+	{
+		stream.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+
+		if (!stream.is_open())
+		{
+			Logger::WriteError("Failed to open " + path + " for writing.", RAW_PCM_AUDIO_SINK_MESSAGE_HEADER);
+			return false;
+		}
+
+		Logger::WriteInfo("Writing " + std::to_string(channelCount) + " channels of 32-bit float samples at " + std::to_string(sampleRate) + " Hz to " + path, RAW_PCM_AUDIO_SINK_MESSAGE_HEADER);
+		return true;
+	}
+
+	void RawPCMAudioSink::Close()
+	{
+		if (stream.is_open())
+			stream.close();
+	}
+
+	void RawPCMAudioSink::Write(const float* samples, uint32_t sampleCount)
+	{
+		if (stream.is_open())
+			stream.write(reinterpret_cast<const char*>(samples), sampleCount * sizeof(float));
+	}
+
+	const std::string& RawPCMAudioSink::GetCurrentOutputDeviceName() const
+	{
+		return path;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,159 @@
+#include <algorithm>
+#include "Audio/SDLAudioSink.hpp"
+#include "Logger.hpp"
+
+namespace ModestGB
+{
+	const std::string SDL_AUDIO_SINK_MESSAGE_HEADER = "[SDL Audio]";
+	const uint16_t DEVICE_BUFFER_SIZE = 4096;
+
+	SDLAudioSink::~SDLAudioSink()
+	{
+		Close();
+	}
+
+	bool SDLAudioSink::Open(uint32_t sampleRate, uint8_t channelCount)
+	{
+		// The audio subsystem is initialized separately from the window, so a machine without audio can still run the emulator.
+		if (SDL_InitSubSystem(SDL_INIT_AUDIO) < 0)
+		{
+			Logger::WriteWarning("SDL failed to initialize audio. Error: " + std::string(SDL_GetError()), SDL_AUDIO_SINK_MESSAGE_HEADER);
+			return false;
+		}
+
+		isAudioSubsystemInitialized = true;
+
+		SDL_zero(currentAudioSpec);
+		currentAudioSpec.freq = static_cast<int>(sampleRate);
+		currentAudioSpec.format = AUDIO_F32;
+		currentAudioSpec.channels = channelCount;
+		currentAudioSpec.samples = DEVICE_BUFFER_SIZE;
+
+		// By default, set the output device to the first available audio device.
+		const char* defaultDeviceName = SDL_GetAudioDeviceName(0, SDL_FALSE);
+
+		if (defaultDeviceName == nullptr || !SetOutputDevice(defaultDeviceName))
+		{
+			Logger::WriteWarning("No audio output device available.", SDL_AUDIO_SINK_MESSAGE_HEADER);
+			Close();
+			return false;
+		}
+
+		RefreshAudioDeviceNames();
+		return true;
+	}
+
+	void SDLAudioSink::Close()
+	{
+		if (currentAudioDeviceID > 0)
+			SDL_CloseAudioDevice(currentAudioDeviceID);
+
+		currentAudioDeviceID = 0;
+
+		if (isAudioSubsystemInitialized)
+			SDL_QuitSubSystem(SDL_INIT_AUDIO);
+
+		isAudioSubsystemInitialized = false;
+	}
+
+	void SDLAudioSink::Write(const float* samples, uint32_t sampleCount)
+	{
+		if (SDL_QueueAudio(currentAudioDeviceID, samples, static_cast<uint32_t>(sampleCount * sizeof(float))) < 0)
+			Logger::WriteError("SDL failed to play audio. Error: " + std::string(SDL_GetError()), SDL_AUDIO_SINK_MESSAGE_HEADER);
+	}
+
+	void SDLAudioSink::Clear()
+	{
+		if (currentAudioDeviceID > 0)
+			SDL_ClearQueuedAudio(currentAudioDeviceID);
+	}
+
+	bool SDLAudioSink::IsRealTime() const
+	{
+		return true;
+	}
+
+	uint32_t SDLAudioSink::GetQueuedSampleCount() const
+	{
+		return SDL_GetQueuedAudioSize(currentAudioDeviceID) / sizeof(float);
+	}
+
+	uint32_t SDLAudioSink::GetDeviceBufferSampleCount() const
+	{
+		return currentAudioDeviceID > 0 ? currentAudioSpec.samples * currentAudioSpec.channels : 0;
+	}
+
+	void SDLAudioSink::RefreshOutputDevices()
+	{
+		if (!isAudioSubsystemInitialized)
+			return;
+
+		// Check if any audio devices were added or removed.
+		if (SDL_GetNumAudioDevices(SDL_FALSE) != audioDeviceNames.size())
+		{
+			Logger::WriteInfo("New audio device detected.", SDL_AUDIO_SINK_MESSAGE_HEADER);
+			RefreshAudioDeviceNames();
+		}
+	}
+
+	const std::vector<std::string>& SDLAudioSink::GetAllOutputDeviceNames() const
+	{
+		return audioDeviceNames;
+	}
+
+	bool SDLAudioSink::SetOutputDevice(const std::string& deviceName)
+	{
+		if (!isAudioSubsystemInitialized)
+			return false;
+
+		SDL_AudioDeviceID result = SDL_OpenAudioDevice(deviceName.c_str(), SDL_FALSE, &currentAudioSpec, nullptr, 0);
+
+		if (result == 0)
+		{
+			Logger::WriteWarning("Failed to select output device: " + deviceName, SDL_AUDIO_SINK_MESSAGE_HEADER);
+			return false;
+		}
+
+		// Close the existing audio device, if any.
+		if (currentAudioDeviceID > 0)
+			SDL_CloseAudioDevice(currentAudioDeviceID);
+
+		currentAudioDeviceID = result;
+		currentAudioDeviceName = deviceName;
+
+		SDL_PauseAudioDevice(currentAudioDeviceID, SDL_FALSE);
+		Logger::WriteInfo("Selected output device: " + currentAudioDeviceName, SDL_AUDIO_SINK_MESSAGE_HEADER);
+		return true;
+	}
+
+	const std::string& SDLAudioSink::GetCurrentOutputDeviceName() const
+	{
+		return currentAudioDeviceName;
+	}
+
+	void SDLAudioSink::RefreshAudioDeviceNames()
+	{
+		audioDeviceNames.clear();
+
+		bool isCurrentDeviceFound = false;
+		int outputDeviceCount = SDL_GetNumAudioDevices(SDL_FALSE);
+
+		for (int i = 0; i < outputDeviceCount; i++)
+		{
+			const char* name = SDL_GetAudioDeviceName(i, SDL_FALSE);
+
+			if (name == nullptr)
+				continue;
+
+			// Is the currently selected audio device still connected?
+			if (name == currentAudioDeviceName)
+				isCurrentDeviceFound = true;
+
+			audioDeviceNames.push_back(name);
+		}
+
+		// Is the currently selected audio device is no longer connected, then choose a new device.
+		if (!isCurrentDeviceFound && !audioDeviceNames.empty())
+			SetOutputDevice(audioDeviceNames.back());
+	}
+}
\ No newline at end of file
@@ -1,5 +1,9 @@
 #include <string>
 #include "Audio/SoundChannel.hpp"
+#include "Audio/SweepSoundChannel.hpp"
+#include "Audio/ToneSoundChannel.hpp"
+#include "Audio/WaveSoundChannel.hpp"
+#include "Audio/NoiseSoundChannel.hpp"
 #include "Utils/GBSpecs.hpp"
 #include "Logger.hpp"
 
@@ -9,24 +13,14 @@ namespace ModestGB
 	const uint8_t ENVELOPE_TIMER_PERIOD = 8;
 	const uint8_t LENGTH_TIMER_PERIOD = 2;
 
-	SoundChannel::SoundChannel()
+	template <typename Derived>
+	SoundChannel<Derived>::SoundChannel(SoundChannelStates& states, uint8_t index) : states(states), index(index)
 	{
 
 	}
 
-	void SoundChannel::TickFrequencyTimer()
-	{
-		if (!isSoundControllerEnabled)
-			return;
-
-		if (frequencyTimer.Tick())
-		{
-			ReloadFrequencyTimer();
-			OnFrequencyTimerReachedZero();
-		}
-	}
-
-	void SoundChannel::TickVolumeEnvelopeTimer()
+	template <typename Derived>
+	void SoundChannel<Derived>::TickVolumeEnvelopeTimer()
 	{
 		if (!isSoundControllerEnabled)
 			return;
@@ -35,19 +29,22 @@ namespace ModestGB
 		{
 			ReloadEnvelopeTimer();
 
-			if (GetVolumeEnvelopeTimerPeriod() != 0)
+			if (Self().GetVolumeEnvelopeTimerPeriod() != 0)
 			{
 				// Decrement or increment the volume depending on the envelope direction.
-				int16_t newVolume = volume + static_cast<int8_t>(GetVolumeEnvelopeDirection());
+				int16_t newVolume = volume + static_cast<int8_t>(Self().GetVolumeEnvelopeDirection());
 
 				// If the new volume does not overflow, then update the volume.
 				if (newVolume >= 0 && newVolume <= MAX_UNSCALED_VOLUME)
 					volume = static_cast<uint8_t>(newVolume);
+
+				RefreshOutput();
 			}
 		}
 	}
 
-	void SoundChannel::TickLengthControlTimer()
+	template <typename Derived>
+	void SoundChannel<Derived>::TickLengthControlTimer()
 	{
 		if (!isSoundControllerEnabled)
 			return;
@@ -59,22 +56,21 @@ namespace ModestGB
 			// If the length timer reaches 0, and the respective bit in NRX4 is set, 
 			// the this channel should be disabled.
 			if (IsConstrainedByLength())
+			{
 				isEnabled = false;
+				RefreshOutput();
+			}
 		}
 	}
 
-	bool SoundChannel::IsEnabled() const
+	template <typename Derived>
+	bool SoundChannel<Derived>::IsEnabled() const
 	{
 		return isEnabled;
 	}
 
-	float SoundChannel::GetSample() const
-	{
-		// Outputs an amplitude between -1 and 1.
-		return isEnabled && isSoundControllerEnabled ? ((GenerateSample() / MAX_UNSCALED_VOLUME) * 2) - 1 : 0;
-	}
-
-	void SoundChannel::Reset()
+	template <typename Derived>
+	void SoundChannel<Derived>::Reset()
 	{
 		nrx0.Write(0);
 		nrx1.Write(0);
@@ -84,65 +80,83 @@ namespace ModestGB
 
 		envelopeTimer.Disable();
 		lengthTimer.Disable();
-		frequencyTimer.Disable();
+		states.frequencyTimerCounters[index] = 0;
+
+		RefreshFrequencyTimerPeriod();
+		RefreshOutput();
 	}
 
-	void SoundChannel::EnableSoundController()
+	template <typename Derived>
+	void SoundChannel<Derived>::EnableSoundController()
 	{
 		isSoundControllerEnabled = true;
-		Reset();
+		Self().Reset();
 	}
 
-	void SoundChannel::DisableSoundController()
+	template <typename Derived>
+	void SoundChannel<Derived>::DisableSoundController()
 	{
 		isSoundControllerEnabled = false;
-		Reset();
+		Self().Reset();
 	}
 
-	void SoundChannel::WriteToNRX0(uint8_t value)
+	template <typename Derived>
+	void SoundChannel<Derived>::WriteToNRX0(uint8_t value)
 	{
 		if (!isSoundControllerEnabled)
 			return;
 
 		nrx0.Write(value);
+		RefreshOutput();
 	}
 
-	void SoundChannel::WriteToNRX1(uint8_t value)
+	template <typename Derived>
+	void SoundChannel<Derived>::WriteToNRX1(uint8_t value)
 	{
 		if (!isSoundControllerEnabled)
 			return;
 
 		nrx1.Write(value);
+		RefreshOutput();
 	}
 
-	void SoundChannel::WriteToNRX2(uint8_t value)
+	template <typename Derived>
+	void SoundChannel<Derived>::WriteToNRX2(uint8_t value)
 	{
 		if (!isSoundControllerEnabled)
 			return;
 
 		nrx2.Write(value);
+		RefreshOutput();
 	}
 
-	void SoundChannel::WriteToNRX3(uint8_t value)
+	template <typename Derived>
+	void SoundChannel<Derived>::WriteToNRX3(uint8_t value)
 	{
 		if (!isSoundControllerEnabled)
 			return;
 
 		nrx3.Write(value);
+		RefreshFrequencyTimerPeriod();
 	}
 
-	void SoundChannel::WriteToNRX4(uint8_t value)
+	template <typename Derived>
+	void SoundChannel<Derived>::WriteToNRX4(uint8_t value)
 	{
 		if (!isSoundControllerEnabled)
 			return;
 
 		nrx4.Write(value);
+		RefreshFrequencyTimerPeriod();
+
+		if (NRX4_TRIGGER.Get(value))
+			Self().OnTrigger();
 
-		if ((value >> 7) == 1)
-			OnTrigger();
+		RefreshOutput();
 	}
 
-	uint8_t SoundChannel::ReadNRX0() const
+	template <typename Derived>
+	uint8_t SoundChannel<Derived>::ReadNRX0() const
 	{
 		if (!isSoundControllerEnabled)
 			return 0;
@@ -150,7 +164,8 @@ namespace ModestGB
 		return nrx0.Read();
 	}
 
-	uint8_t SoundChannel::ReadNRX1() const
+	template <typename Derived>
+	uint8_t SoundChannel<Derived>::ReadNRX1() const
 	{
 		if (!isSoundControllerEnabled)
 			return 0;
@@ -158,7 +173,8 @@ namespace ModestGB
 		return nrx1.Read();
 	}
 
-	uint8_t SoundChannel::ReadNRX2() const
+	template <typename Derived>
+	uint8_t SoundChannel<Derived>::ReadNRX2() const
 	{
 		if (!isSoundControllerEnabled)
 			return 0;
@@ -166,7 +182,8 @@ namespace ModestGB
 		return nrx2.Read();
 	}
 
-	uint8_t SoundChannel::ReadNRX3() const
+	template <typename Derived>
+	uint8_t SoundChannel<Derived>::ReadNRX3() const
 	{
 		if (!isSoundControllerEnabled)
 			return 0;
@@ -174,7 +191,8 @@ namespace ModestGB
 		return nrx3.Read();
 	}
 
-	uint8_t SoundChannel::ReadNRX4() const
+	template <typename Derived>
+	uint8_t SoundChannel<Derived>::ReadNRX4() const
 	{
 		if (!isSoundControllerEnabled)
 			return 0;
@@ -182,7 +200,8 @@ namespace ModestGB
 		return nrx4.Read();
 	}
 
-	void SoundChannel::OnTrigger()
+	template <typename Derived>
+	void SoundChannel<Derived>::OnTrigger()
 	{
 		isEnabled = true;
 
@@ -192,34 +211,80 @@ namespace ModestGB
 		ReloadFrequencyTimer();
 		ReloadEnvelopeTimer();
 
-		volume = GetInitialEnvelopeVolume();
+		volume = Self().GetInitialEnvelopeVolume();
 	}
 
-	void SoundChannel::DisableVolumeEnvelope()
+	template <typename Derived>
+	void SoundChannel<Derived>::DisableVolumeEnvelope()
 	{
 		envelopeTimer.Disable();
 	}
 
-	void SoundChannel::ReloadLengthTimer()
+	template <typename Derived>
+	void SoundChannel<Derived>::ReloadLengthTimer()
 	{
-		lengthTimer.Restart(GetLengthTimerPeriod());
+		lengthTimer.Restart(Self().GetLengthTimerPeriod());
 	}
 
-	void SoundChannel::ReloadFrequencyTimer()
+	template <typename Derived>
+	void SoundChannel<Derived>::ReloadFrequencyTimer()
 	{
-		frequencyTimer.Restart(GetFrequencyTimerPeriod());
+		states.frequencyTimerCounters[index] = states.frequencyTimerPeriods[index];
 	}
 
-	void SoundChannel::ReloadEnvelopeTimer()
+	template <typename Derived>
+	void SoundChannel<Derived>::ReloadEnvelopeTimer()
 	{
-		uint16_t period = GetVolumeEnvelopeTimerPeriod();
+		uint16_t period = Self().GetVolumeEnvelopeTimerPeriod();
 
 		// The volume envelope timer treats a period of 0 as 8.
 		envelopeTimer.Restart(period == 0 ? 8 : period);
 	}
 
-	void SoundChannel::OnFrequencyTimerReachedZero()
+	template <typename Derived>
+	void SoundChannel<Derived>::RefreshFrequencyTimerPeriod()
+	{
+		states.frequencyTimerPeriods[index] = Self().GetFrequencyTimerPeriod();
+	}
+
+	template <typename Derived>
+	bool SoundChannel<Derived>::IsConstrainedByLength() const
 	{
+		return nrx4.Read(NRX4_LENGTH_ENABLE);
+	}
+
+	template <typename Derived>
+	void SoundChannel<Derived>::Serialize(StateWriter& writer) const
+	{
+		writer.Write(isEnabled);
+		writer.Write(isSoundControllerEnabled);
+		writer.Write(volume);
+		writer.Write(nrx0.Read());
+		writer.Write(nrx1.Read());
+		writer.Write(nrx2.Read());
+		writer.Write(nrx3.Read());
+		writer.Write(nrx4.Read());
+		lengthTimer.Serialize(writer);
+		envelopeTimer.Serialize(writer);
+	}
 
+	template <typename Derived>
+	void SoundChannel<Derived>::Deserialize(StateReader& reader)
+	{
+		reader.Read(isEnabled);
+		reader.Read(isSoundControllerEnabled);
+		reader.Read(volume);
+		nrx0.Write(reader.Read<uint8_t>());
+		nrx1.Write(reader.Read<uint8_t>());
+		nrx2.Write(reader.Read<uint8_t>());
+		nrx3.Write(reader.Read<uint8_t>());
+		nrx4.Write(reader.Read<uint8_t>());
+		lengthTimer.Deserialize(reader);
+		envelopeTimer.Deserialize(reader);
 	}
+
+	template class SoundChannel<SweepSoundChannel>;
+	template class SoundChannel<ToneSoundChannel>;
+	template class SoundChannel<WaveSoundChannel>;
+	template class SoundChannel<NoiseSoundChannel>;
 }
\ No newline at end of file
@@ -7,20 +7,38 @@ namespace ModestGB
 {
 	const uint16_t MAX_FREQUENCY = 2047;
 
-	SweepSoundChannel::SweepSoundChannel() : ToneSoundChannel()
+	SweepSoundChannel::SweepSoundChannel(SoundChannelStates& states, uint8_t index) : BasicToneSoundChannel(states, index)
 	{
 
 	}
 
 	void SweepSoundChannel::Reset()
 	{
-		ToneSoundChannel::Reset();
+		BasicToneSoundChannel::Reset();
 
 		sweepTimer.Disable();
 		shadowFrequency = 0;
 		isSweepEnabled = false;
 	}
 
+	void SweepSoundChannel::Serialize(StateWriter& writer) const
+	{
+		BasicToneSoundChannel::Serialize(writer);
+
+		writer.Write(isSweepEnabled);
+		writer.Write(shadowFrequency);
+		sweepTimer.Serialize(writer);
+	}
+
+	void SweepSoundChannel::Deserialize(StateReader& reader)
+	{
+		BasicToneSoundChannel::Deserialize(reader);
+
+		reader.Read(isSweepEnabled);
+		reader.Read(shadowFrequency);
+		sweepTimer.Deserialize(reader);
+	}
+
 	void SweepSoundChannel::TickSweepTimer()
 	{
 		if (!isSoundControllerEnabled)
@@ -43,6 +61,8 @@ namespace ModestGB
 					// but the new frequency is not used.
 					PerformOverflowCheck(CalculateShadowFrequency());
 				}
+
+				RefreshOutput();
 			}
 		}
 	}
@@ -54,7 +74,7 @@ namespace ModestGB
 
 	void SweepSoundChannel::OnTrigger()
 	{
-		ToneSoundChannel::OnTrigger();
+		BasicToneSoundChannel::OnTrigger();
 
 		// Copy the frequency to the shadow register
 		shadowFrequency = GetFrequency();
@@ -101,22 +121,24 @@ namespace ModestGB
 		nrx3.Write(shadowFrequency & 255);
 
 		// Upper 3 bits of 11 bit frequency
-		nrx4.Write(nrx4.Read(3, 7) | (shadowFrequency >> 8) & 0b111);
+		nrx4.Write(NRX4_FREQUENCY_HIGH, shadowFrequency >> 8);
+
+		RefreshFrequencyTimerPeriod();
 	}
 
 	uint8_t SweepSoundChannel::GetSweepPeriod() const
 	{
-		return nrx0.Read(4, 6);
+		return nrx0.Read(NRX0_SWEEP_PERIOD);
 	}
 
-	SoundChannel::ModifierDirection SweepSoundChannel::GetSweepDirection() const
+	ModifierDirection SweepSoundChannel::GetSweepDirection() const
 	{
-		return nrx0.Read(3) ? ModifierDirection::Decrease : ModifierDirection::Increase;
+		return nrx0.Read(NRX0_SWEEP_DIRECTION) ? ModifierDirection::Decrease : ModifierDirection::Increase;
 	}
 
 	uint8_t SweepSoundChannel::GetSweepShift() const
 	{
-		return nrx0.Read(0, 2);
+		return nrx0.Read(NRX0_SWEEP_SHIFT);
 	}
 
 	void SweepSoundChannel::ReloadSweepTimer()
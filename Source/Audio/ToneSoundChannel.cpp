@@ -1,128 +1,146 @@
-#include <map>
 #include <string>
 #include "Audio/ToneSoundChannel.hpp"
+#include "Audio/SweepSoundChannel.hpp"
 #include "Logger.hpp"
 
 namespace ModestGB
 {
-	const std::map<uint8_t, std::vector<bool>> WAVEFORMS =
+	const uint8_t DUTY_CYCLE_WAVEFORMS[4][DUTY_CYCLE_LENGTH] =
 	{
-		{ 0,  {0, 0, 0, 0, 0, 0, 0, 1} },
-		{ 1,  {1, 0, 0, 0, 0, 0, 0, 1} },
-		{ 2,  {1, 0, 0, 0, 0, 1, 1, 1} },
-		{ 3,  {0, 1, 1, 1, 1, 1, 1, 0} }
+		{0, 0, 0, 0, 0, 0, 0, 1},
+		{1, 0, 0, 0, 0, 0, 0, 1},
+		{1, 0, 0, 0, 0, 1, 1, 1},
+		{0, 1, 1, 1, 1, 1, 1, 0}
 	};
 
-	ToneSoundChannel::ToneSoundChannel() : SoundChannel()
+	template <typename Derived>
+	BasicToneSoundChannel<Derived>::BasicToneSoundChannel(SoundChannelStates& states, uint8_t index) : SoundChannel<Derived>(states, index)
 	{
 
 	}
 
-	void ToneSoundChannel::Reset()
+	template <typename Derived>
+	void BasicToneSoundChannel<Derived>::Reset()
 	{
-		SoundChannel::Reset();
+		SoundChannel<Derived>::Reset();
 
 		waveformPosition = 0;
+		this->RefreshOutput();
 	}
 
-	void ToneSoundChannel::WriteToNRX1(uint8_t value)
+	template <typename Derived>
+	void BasicToneSoundChannel<Derived>::WriteToNRX1(uint8_t value)
 	{
-		SoundChannel::WriteToNRX1(value);
+		SoundChannel<Derived>::WriteToNRX1(value);
 
-		ReloadLengthTimer();
+		this->ReloadLengthTimer();
 	}
 
-	void ToneSoundChannel::WriteToNRX2(uint8_t value)
+	template <typename Derived>
+	void BasicToneSoundChannel<Derived>::WriteToNRX2(uint8_t value)
 	{
-		SoundChannel::WriteToNRX2(value);
+		SoundChannel<Derived>::WriteToNRX2(value);
 
 		// If the upper 5 bits of NRX2 are 0, then this channel is disabled.
-		if (nrx2.Read(3, 7) == 0)
-			isEnabled = false;
+		if (this->nrx2.Read(NRX2_DAC_ENABLE) == 0)
+			this->isEnabled = false;
 
 		// If the period is 0, then stop the volume envelope.
 		if (GetVolumeEnvelopeTimerPeriod() == 0)
-			DisableVolumeEnvelope();
-	}
+			this->DisableVolumeEnvelope();
 
-	uint8_t ToneSoundChannel::ReadNRX0() const
-	{
-		return SoundChannel::ReadNRX0() | 0xFF;
+		this->RefreshOutput();
 	}
 
-	uint8_t ToneSoundChannel::ReadNRX1() const
+	template <typename Derived>
+	uint8_t BasicToneSoundChannel<Derived>::ReadNRX0() const
 	{
-		return SoundChannel::ReadNRX1() | 0x3F;
+		return SoundChannel<Derived>::ReadNRX0() | 0xFF;
 	}
 
-	uint8_t ToneSoundChannel::ReadNRX3() const
+	template <typename Derived>
+	uint8_t BasicToneSoundChannel<Derived>::ReadNRX1() const
 	{
-		return SoundChannel::ReadNRX3() | 0xFF;
+		return SoundChannel<Derived>::ReadNRX1() | 0x3F;
 	}
 
-	uint8_t ToneSoundChannel::ReadNRX4() const
+	template <typename Derived>
+	uint8_t BasicToneSoundChannel<Derived>::ReadNRX3() const
 	{
-		return SoundChannel::ReadNRX4() | 0xBF;
+		return SoundChannel<Derived>::ReadNRX3() | 0xFF;
 	}
 
-	float ToneSoundChannel::GenerateSample() const
+	template <typename Derived>
+	uint8_t BasicToneSoundChannel<Derived>::ReadNRX4() const
 	{
-		return static_cast<float>(WAVEFORMS.at(GetWaveformIndex())[waveformPosition] * volume);
+		return SoundChannel<Derived>::ReadNRX4() | 0xBF;
 	}
 
-	uint16_t ToneSoundChannel::GetFrequency() const
+	template <typename Derived>
+	uint16_t BasicToneSoundChannel<Derived>::GetFrequency() const
 	{
 		// Bits 0 - 2 of NRX4 define the upper 3 bits of the 11 bit frequency, 
 		// and NRX3 defines the lower 8 bits.
-		return (nrx4.Read(0, 2) << 8) | nrx3.Read();
+		return (this->nrx4.Read(NRX4_FREQUENCY_HIGH) << 8) | this->nrx3.Read();
 	}
 
-	uint8_t ToneSoundChannel::GetWaveformIndex() const
+	template <typename Derived>
+	void BasicToneSoundChannel<Derived>::OnTrigger()
 	{
-		return nrx1.Read(6, 7);
+		SoundChannel<Derived>::OnTrigger();
+
+		waveformPosition = 0;
 	}
 
-	void ToneSoundChannel::OnFrequencyTimerReachedZero()
+	template <typename Derived>
+	ModifierDirection BasicToneSoundChannel<Derived>::GetVolumeEnvelopeDirection() const
 	{
-		SoundChannel::OnFrequencyTimerReachedZero();
-
-		waveformPosition = (waveformPosition + 1) % 8;
+		return this->nrx2.Read(NRX2_ENVELOPE_DIRECTION) ? ModifierDirection::Increase : ModifierDirection::Decrease;
 	}
 
-	void ToneSoundChannel::OnTrigger() 
+	template <typename Derived>
+	uint8_t BasicToneSoundChannel<Derived>::GetInitialEnvelopeVolume() const
 	{
-		SoundChannel::OnTrigger();
-
-		waveformPosition = 0;
+		return this->nrx2.Read(NRX2_ENVELOPE_INITIAL_VOLUME);
 	}
 
-	SoundChannel::ModifierDirection ToneSoundChannel::GetVolumeEnvelopeDirection() const
+	template <typename Derived>
+	uint32_t BasicToneSoundChannel<Derived>::GetFrequencyTimerPeriod() const
 	{
-		return nrx2.Read(3) ? ModifierDirection::Increase : ModifierDirection::Decrease;
+		return ((2048 - GetFrequency()) * 4);
 	}
 
-	uint8_t ToneSoundChannel::GetInitialEnvelopeVolume() const
+	template <typename Derived>
+	uint16_t BasicToneSoundChannel<Derived>::GetVolumeEnvelopeTimerPeriod() const
 	{
-		return nrx2.Read(4, 7);
+		return this->nrx2.Read(NRX2_ENVELOPE_PERIOD);
 	}
 
-	bool ToneSoundChannel::IsConstrainedByLength() const
+	template <typename Derived>
+	uint16_t BasicToneSoundChannel<Derived>::GetLengthTimerPeriod() const
 	{
-		return nrx4.Read(6);
+		return this->nrx1.Read(NRX1_LENGTH_TIMER);
 	}
 
-	uint16_t ToneSoundChannel::GetFrequencyTimerPeriod() const
+	ToneSoundChannel::ToneSoundChannel(SoundChannelStates& states, uint8_t index) : BasicToneSoundChannel(states, index)
 	{
-		return ((2048 - GetFrequency()) * 4);
+
 	}
 
-	uint16_t ToneSoundChannel::GetVolumeEnvelopeTimerPeriod() const
+	template <typename Derived>
+	void BasicToneSoundChannel<Derived>::Serialize(StateWriter& writer) const
 	{
-		return nrx2.Read(0, 2);
+		SoundChannel<Derived>::Serialize(writer);
+		writer.Write(waveformPosition);
 	}
 
-	uint16_t ToneSoundChannel::GetLengthTimerPeriod() const
+	template <typename Derived>
+	void BasicToneSoundChannel<Derived>::Deserialize(StateReader& reader)
 	{
-		return nrx1.Read(0, 5);
+		SoundChannel<Derived>::Deserialize(reader);
+		waveformPosition = reader.Read<uint8_t>() % DUTY_CYCLE_LENGTH;
 	}
+
+	template class BasicToneSoundChannel<SweepSoundChannel>;
+	template class BasicToneSoundChannel<ToneSoundChannel>;
 }
\ No newline at end of file
@@ -0,0 +1,103 @@
+#include <algorithm>
+#include "Audio/WAVAudioSink.hpp"
+#include "Logger.hpp"
+
+namespace ModestGB
+{
+	const std::string WAV_AUDIO_SINK_MESSAGE_HEADER = "[WAV Audio]";
+	const uint16_t PCM_FORMAT_TAG = 1;
+	const uint16_t BITS_PER_SAMPLE = 16;
+	const uint32_t HEADER_SIZE = 44;
+	const uint32_t RIFF_SIZE_OFFSET = 4;
+	const uint32_t DATA_SIZE_OFFSET = 40;
+
+	void WriteLittleEndian(std::ofstream& stream, uint32_t value, uint8_t size)
+	{
+		for (uint8_t i = 0; i < size; i++)
+			stream.put(static_cast<char>((value >> (i * 8)) & 0xFF));
+	}
+
+	WAVAudioSink::WAVAudioSink(const std::string& path) : path(path)
+	{
+	}
+
+	WAVAudioSink::~WAVAudioSink()
+	{
+		Close();
+	}
+
+	bool WAVAudioSink::Open(uint32_t sampleRate, uint8_t channelCount)
+	{
+		stream.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+
+		if (!stream.is_open())
+		{
+			Logger::WriteError("Failed to open " + path + " for writing.", WAV_AUDIO_SINK_MESSAGE_HEADER);
+			return false;
+		}
+
+		dataSize = 0;
+		WriteHeader(sampleRate, channelCount);
+
+		Logger::WriteInfo("Recording audio to " + path, WAV_AUDIO_SINK_MESSAGE_HEADER);
+		return true;
+	}
+
+	void WAVAudioSink::Close()
+	{
+		if (!stream.is_open())
+			return;
+
+		// Now that the amount of audio is known, fill in the sizes.
+		stream.seekp(RIFF_SIZE_OFFSET);
+		WriteLittleEndian(stream, HEADER_SIZE - 8 + dataSize, 4);
+		stream.seekp(DATA_SIZE_OFFSET);
+		WriteLittleEndian(stream, dataSize, 4);
+
+		stream.close();
+	}
+
+	void WAVAudioSink::Write(const float* samples, uint32_t sampleCount)
+	{
+		if (!stream.is_open())
+			return;
+
+		convertedSamples.resize(sampleCount * sizeof(int16_t));
+
+		for (uint32_t i = 0; i < sampleCount; i++)
+		{
+			int16_t sample = static_cast<int16_t>(std::clamp(samples[i], -1.0f, 1.0f) * INT16_MAX);
+			convertedSamples[i * 2] = static_cast<uint8_t>(sample & 0xFF);
+			convertedSamples[i * 2 + 1] = static_cast<uint8_t>((sample >> 8) & 0xFF);
+		}
+
+		stream.write(reinterpret_cast<const char*>(convertedSamples.data()), convertedSamples.size());
+		dataSize += static_cast<uint32_t>(convertedSamples.size());
+	}
+
+	const std::string& WAVAudioSink::GetCurrentOutputDeviceName() const
+	{
+		return path;
+	}
+
+	void WAVAudioSink::WriteHeader(uint32_t sampleRate, uint8_t channelCount)
+	{
+		uint16_t blockAlign = channelCount * (BITS_PER_SAMPLE / 8);
+
+		stream.write("RIFF", 4);
+		WriteLittleEndian(stream, HEADER_SIZE - 8, 4);
+		stream.write("WAVE", 4);
+
+		stream.write("fmt ", 4);
+		WriteLittleEndian(stream, 16, 4);
+		WriteLittleEndian(stream, PCM_FORMAT_TAG, 2);
+		WriteLittleEndian(stream, channelCount, 2);
+		WriteLittleEndian(stream, sampleRate, 4);
+		WriteLittleEndian(stream, sampleRate * blockAlign, 4);
+		WriteLittleEndian(stream, blockAlign, 2);
+		WriteLittleEndian(stream, BITS_PER_SAMPLE, 2);
+
+		stream.write("data", 4);
+		WriteLittleEndian(stream, 0, 4);
+	}
+}
\ No newline at end of file
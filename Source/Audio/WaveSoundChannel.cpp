@@ -6,11 +6,10 @@ namespace ModestGB
 {
 	const uint16_t WAVE_PATTERN_RAM_START_ADDRESS = 0xFF30;
 	const uint16_t WAVE_PATTERN_RAM_END_ADDRESS = 0xFF3F;
-	const uint8_t NUMBER_OF_SAMPLES = 32;
 
-	WaveSoundChannel::WaveSoundChannel() : SoundChannel()
+	WaveSoundChannel::WaveSoundChannel(SoundChannelStates& states, uint8_t index) : SoundChannel(states, index)
 	{
-		samples = std::vector<uint8_t>(NUMBER_OF_SAMPLES);
+
 	}
 
 	void WaveSoundChannel::Reset()
@@ -18,14 +17,47 @@ namespace ModestGB
 		SoundChannel::Reset();
 
 		sampleIndex = 0;
-		std::fill(samples.begin(), samples.end(), 0);
+		std::fill(wavePatternRAM.begin(), wavePatternRAM.end(), 0);
+		RefreshVolumeControlShift();
+		DecodeSamples();
+		RefreshOutput();
+	}
+
+	void WaveSoundChannel::Serialize(StateWriter& writer) const
+	{
+		SoundChannel::Serialize(writer);
+
+		writer.Write(sampleIndex);
+		writer.Write(wavePatternRAM);
+	}
+
+	void WaveSoundChannel::Deserialize(StateReader& reader)
+	{
+		SoundChannel::Deserialize(reader);
+
+		sampleIndex = reader.Read<uint8_t>() % WAVE_SAMPLE_COUNT;
+		reader.Read(wavePatternRAM);
+
+		// The decoded samples aren't saved, since they can be rebuilt from NRX2 and the wave pattern RAM.
+		RefreshVolumeControlShift();
+		DecodeSamples();
 	}
 
 	void WaveSoundChannel::WriteToNRX0(uint8_t value)
 	{
 		SoundChannel::WriteToNRX0(value);
 
-		isEnabled = nrx0.Read(7);
+		isEnabled = nrx0.Read(NRX0_WAVE_DAC_ENABLE);
+		RefreshOutput();
+	}
+
+	void WaveSoundChannel::WriteToNRX2(uint8_t value)
+	{
+		SoundChannel::WriteToNRX2(value);
+
+		RefreshVolumeControlShift();
+		DecodeSamples();
+		RefreshOutput();
 	}
 
 	void WaveSoundChannel::WriteToWavePatternRAM(uint16_t address, uint8_t value)
@@ -36,8 +68,11 @@ namespace ModestGB
 			return;
 		}
 
-		samples[address - WAVE_PATTERN_RAM_START_ADDRESS] = (value >> 4) & 0b1111;
-		samples[(address - WAVE_PATTERN_RAM_START_ADDRESS) + 1] = value & 0b1111;
+		uint8_t ramIndex = static_cast<uint8_t>(address - WAVE_PATTERN_RAM_START_ADDRESS);
+		wavePatternRAM[ramIndex] = value;
+
+		DecodeSample(ramIndex);
+		RefreshOutput();
 	}
 
 	uint8_t WaveSoundChannel::ReadNRX0() const
@@ -67,7 +102,8 @@ namespace ModestGB
 
 	uint8_t WaveSoundChannel::ReadWavePatternRAM() const
 	{
-		return isEnabled ? samples[sampleIndex] : 0xFF;
+		// While the channel is playing, the byte holding the current sample is read instead.
+		return isEnabled ? wavePatternRAM[sampleIndex / 2] : 0xFF;
 	}
 
 	uint16_t WaveSoundChannel::GetLengthTimerPeriod() const
@@ -75,33 +111,30 @@ namespace ModestGB
 		return nrx1.Read();
 	}
 
-	float WaveSoundChannel::GenerateSample() const
-	{
-		return static_cast<float>(samples[sampleIndex] >> GetVolumeControlShift());
-	}
-
-	bool WaveSoundChannel::IsConstrainedByLength() const
+	uint32_t WaveSoundChannel::GetFrequencyTimerPeriod() const
 	{
-		return nrx4.Read(6);
+		uint16_t frequency = (nrx4.Read(NRX4_FREQUENCY_HIGH) << 8) | nrx3.Read();
+		return (2048 - frequency) * 2;
 	}
 
-	uint16_t WaveSoundChannel::GetFrequencyTimerPeriod() const
+	void WaveSoundChannel::RefreshVolumeControlShift()
 	{
-		uint16_t frequency = (nrx4.Read(0, 2) << 8) | nrx3.Read();
-		return (2048 - frequency) * 2;
+		uint8_t volumeControl = nrx2.Read(NRX2_WAVE_OUTPUT_LEVEL);
+		volumeControlShift = volumeControl == 0 ? 4 : volumeControl - 1;
 	}
 
-	void WaveSoundChannel::OnFrequencyTimerReachedZero()
+	void WaveSoundChannel::DecodeSample(uint8_t ramIndex)
 	{
-		SoundChannel::OnFrequencyTimerReachedZero();
-
-		sampleIndex = (sampleIndex + 1) % NUMBER_OF_SAMPLES;
+		// Each byte holds 2 samples, with the upper nibble being played first.
+		uint8_t value = wavePatternRAM[ramIndex];
+		sampleLevels[ramIndex * 2] = static_cast<float>(((value >> 4) & 0b1111) >> volumeControlShift);
+		sampleLevels[ramIndex * 2 + 1] = static_cast<float>((value & 0b1111) >> volumeControlShift);
 	}
 
-	uint8_t WaveSoundChannel::GetVolumeControlShift() const
+	void WaveSoundChannel::DecodeSamples()
 	{
-		uint8_t volumeControl = nrx2.Read(5, 6);
-		return volumeControl == 0 ? 4 : volumeControl - 1;
+		for (uint8_t i = 0; i < WAVE_PATTERN_RAM_SIZE; i++)
+			DecodeSample(i);
 	}
 
 	void WaveSoundChannel::OnTrigger()
@@ -120,7 +153,7 @@ namespace ModestGB
 		return 0;
 	}
 
-	SoundChannel::ModifierDirection WaveSoundChannel::GetVolumeEnvelopeDirection() const
+	ModifierDirection WaveSoundChannel::GetVolumeEnvelopeDirection() const
 	{
 		return ModifierDirection::Increase;
 	}
@@ -95,6 +95,34 @@ namespace ModestGB
 		interruptMasterEnableFlag = false;
 	}
 
+	void CPU::Serialize(StateWriter& writer) const
+	{
+		writer.Write(regAF.Read());
+		writer.Write(regBC.Read());
+		writer.Write(regDE.Read());
+		writer.Write(regHL.Read());
+		writer.Write(stackPointer.Read());
+		writer.Write(programCounter.Read());
+		writer.Write(isHalted);
+		writer.Write(interruptMasterEnableFlag);
+	}
+
+	void CPU::Deserialize(StateReader& reader)
+	{
+		regAF.Write(reader.Read<uint16_t>());
+		regBC.Write(reader.Read<uint16_t>());
+		regDE.Write(reader.Read<uint16_t>());
+		regHL.Write(reader.Read<uint16_t>());
+		stackPointer.Write(reader.Read<uint16_t>());
+		programCounter.Write(reader.Read<uint16_t>());
+		reader.Read(isHalted);
+		reader.Read(interruptMasterEnableFlag);
+
+		// States are only taken between instructions.
+		currentInstructionCycles = 0;
+		currentInstruction = nullptr;
+	}
+
 	uint16_t CPU::ReadRegisterAF() const
 	{
 		return regAF.Read();
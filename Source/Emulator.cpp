@@ -1,10 +1,12 @@
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <chrono>
 #include "imgui.h"
 #include "imgui_impl_sdl.h"
 #include "imgui_impl_sdlrenderer.h"
 #include "Emulator.hpp"
+#include "FramePacer.hpp"
 #include "Logger.hpp"
 #include "Utils/GBSpecs.hpp"
 #include "Utils/ConfigUtils.hpp"
@@ -13,9 +15,16 @@ namespace ModestGB
 {
 	const std::string CONFIG_FILE_RELATIVE_PATH = "Modest-GB.config";
 
+	// Size of the generic I/O memory stored by save states older than version 3.
+	const uint32_t LEGACY_IO_REGISTERS_SIZE = 128;
+
+	Emulator::Emulator(const LaunchOptions& launchOptions) : launchOptions(launchOptions)
+	{
+	}
+
 	Emulator::~Emulator()
 	{
-		Config::SaveConfiguration((std::filesystem::current_path() / CONFIG_FILE_RELATIVE_PATH).string(), window, apu, ppu, joypad, inputManager, cartridge);
+		Config::SaveConfiguration((std::filesystem::current_path() / CONFIG_FILE_RELATIVE_PATH).string(), window, apu, ppu, inputMapping, inputManager, cartridge);
 	}
 
 	int Emulator::Run()
@@ -32,88 +41,447 @@ namespace ModestGB
 		window.RegisterPauseButtonCallback(std::bind(&Emulator::OnPauseButtonPressed, this));
 		window.RegisterStepButtonCallback(std::bind(&Emulator::OnStepButtonPressed, this));
 		window.RegisterClearButtonCallback(std::bind(&Emulator::OnClearButtonPressed, this));
+		window.RegisterSaveStateButtonCallback(std::bind(&Emulator::OnSaveStateButtonPressed, this));
+		window.RegisterLoadStateButtonCallback(std::bind(&Emulator::OnLoadStateButtonPressed, this));
+		window.RegisterRecordMovieFromPowerOnButtonCallback(std::bind(&Emulator::OnRecordMovieFromPowerOnButtonPressed, this));
+		window.RegisterRecordMovieFromCurrentStateButtonCallback(std::bind(&Emulator::OnRecordMovieFromCurrentStateButtonPressed, this));
+		window.RegisterMovieFileSelectionCallback(std::bind(&Emulator::OnMovieFileSelected, this, std::placeholders::_1));
+		window.RegisterStopMovieButtonCallback(std::bind(&Emulator::OnStopMovieButtonPressed, this));
+		window.RegisterSettingChangedCallback(std::bind(&Emulator::PushCommand, this, std::placeholders::_1));
 		inputManager.RegisterGenericInputEventCallback(std::bind(&Emulator::OnInputEventReceived, this, std::placeholders::_1));
+		inputManager.RegisterKeyPressedCallback(std::bind(&Emulator::OnKeyPressed, this, std::placeholders::_1));
+		inputManager.RegisterKeyReleasedCallback(std::bind(&Emulator::OnKeyReleased, this, std::placeholders::_1));
+		inputManager.RegisterControllerButtonPressedCallback(std::bind(&Emulator::OnControllerButtonPressed, this, std::placeholders::_1));
+		inputManager.RegisterControllerButtonReleasedCallback(std::bind(&Emulator::OnControllerButtonReleased, this, std::placeholders::_1));
 
 		ppu.InitializeFramebuffer(window.GetSDLWindow());
 		SetupMemoryMap();
 		memoryMap.Reset();
 
-		apu.Initialize();
+		apu.Initialize(AudioSink::Create(launchOptions.audioSinkType, launchOptions.audioOutputPath));
 		inputManager.Initialize();
 
+		if (launchOptions.rewindBufferSizeInMiB > 0)
+			rewindBuffer.Start(static_cast<size_t>(launchOptions.rewindBufferSizeInMiB) * MiB);
+
 		Logger::WriteInfo("Loading configuration file...");
-		Config::LoadConfiguration((std::filesystem::current_path() / CONFIG_FILE_RELATIVE_PATH).string(), window, apu, ppu, joypad, inputManager, cartridge);
+		Config::LoadConfiguration((std::filesystem::current_path() / CONFIG_FILE_RELATIVE_PATH).string(), window, apu, ppu, inputMapping, inputManager, cartridge);
 		Logger::WriteInfo("Configuration file attributes applied.");
 
 		window.Show();
 
+		if (launchOptions.frameSkipInterval > 1)
+			PushCommand({ .type = EmulatorCommandType::SetFrameSkip, .framesToSkip = launchOptions.framesToSkip, .frameSkipInterval = launchOptions.frameSkipInterval });
+
+		if (launchOptions.isRenderingDisabled)
+			PushCommand({ .type = EmulatorCommandType::SetRenderingEnabled, .isEnabled = false });
+
+		if (!launchOptions.romPath.empty())
+		{
+			PushCommand({ .type = EmulatorCommandType::LoadROM, .romFilePath = launchOptions.romPath });
+
+			if (!launchOptions.moviePath.empty())
+				PushCommand({ .type = EmulatorCommandType::PlayMovie, .moviePath = launchOptions.moviePath });
+		}
+
 		isRunning = true;
-		double secondsSinceLastFrame = 0;
-		double secondsSinceLastCycleCount = 0;
-		uint32_t cyclesSinceLastFrame = 0;
-		uint32_t cyclesSinceLastCount = 0;
+		PublishStateSnapshot();
+
+		// From this point on, the emulated hardware belongs to the emulation thread. The UI thread 
+		// only talks to it through the command queue and reads its state through the published snapshots.
+		emulationThread = std::thread(&Emulator::RunEmulation, this);
 
-		std::chrono::steady_clock::time_point prevTime = std::chrono::steady_clock::now();
-		std::chrono::steady_clock::time_point currentTime;
-		double deltaTimeInSeconds = 0;
+		EmulatorStateSnapshot snapshot;
+		FramePacer uiFramePacer(GB_FRAMES_PER_SECOND);
 
 		while (isRunning)
 		{
-			currentTime = std::chrono::steady_clock::now();
-			deltaTimeInSeconds = std::chrono::duration_cast<std::chrono::duration<double>>(currentTime - prevTime).count();
-			prevTime = currentTime;
+			inputManager.Update();
 
-			if (cartridge.IsROMLoaded() && (!isPaused || isStepRequested) && cyclesSinceLastFrame < GB_CYCLES_PER_FRAME)
 			{
-				uint32_t cycles = processor.Tick();
+				std::lock_guard<std::mutex> lock(stateSnapshotMutex);
+				snapshot = stateSnapshot;
+			}
 
-				cyclesSinceLastFrame += cycles;
-				cyclesSinceLastCount += cycles;
+			{
+				std::lock_guard<std::mutex> lock(pendingLogEntriesMutex);
+				logEntries.insert(logEntries.end(), pendingLogEntries.begin(), pendingLogEntries.end());
+				pendingLogEntries.clear();
+			}
 
-				timer.Tick(cycles);
-				ppu.Tick(cycles);
-				apu.Tick(cycles);
+			window.SetPauseButtonLabel(snapshot.isPaused ? "Resume" : "Pause");
+			ppu.UploadFramebuffers();
+			window.Render(snapshot, ppu, apu, inputMapping, inputManager, logEntries);
+
+			isTilesDebugViewVisible = window.shouldRenderTilesDebugWindow;
+			isSpritesDebugViewVisible = window.shouldRenderSpritesDebugWindow;
+			isBackgroundTileMapDebugViewVisible = window.shouldRenderBackgroundTileMapDebugWindow;
+			isWindowTileMapDebugViewVisible = window.shouldRenderWindowTileMapDebugWindow;
+			apu.SetCaptureEnabled(window.shouldRenderSoundDebugWindow);
+			isRewindRequested = window.IsRewindButtonHeld();
+
+			// With vsync, presenting the frame already blocks until the display refreshes. Otherwise, 
+			// the UI is refreshed at the same rate as the emulated display.
+			if (!window.IsVSyncEnabled())
+				uiFramePacer.WaitForNextFrame();
+		}
 
-				if (window.shouldRenderTilesDebugWindow)
-					ppu.DebugDrawTiles(cycles);
+		emulationThread.join();
+		rewindBuffer.Stop();
 
-				if (window.shouldRenderSpritesDebugWindow)
-					ppu.DebugDrawSprites(cycles);
+		apu.Quit();
+		window.Quit();
+		return 0;
+	}
+
+	void Emulator::RunEmulation()
+	{
+		uint32_t cyclesSinceLastCount = 0;
+		std::chrono::steady_clock::time_point lastCycleCountTime = std::chrono::steady_clock::now();
+		FramePacer framePacer(GB_FRAMES_PER_SECOND);
 
-				if (window.shouldRenderBackgroundTileMapDebugWindow)
-					ppu.DebugDrawBackgroundTileMap(cycles);
+		// Sound can't keep up with an uncapped speed, so the channels are only kept running.
+		if (launchOptions.isSpeedUncapped)
+			apu.SetOutputSuspended(true);
+
+		while (isRunning)
+		{
+			ProcessCommands();
 
-				if (window.shouldRenderWindowTileMapDebugWindow)
-					ppu.DebugDrawWindowTileMap(cycles);
+			// Selecting a device and writing to it both happen here, so a device that was unplugged can't be closed mid-write.
+			apu.RefreshOutputDevices();
 
-				if (cycles > 0)
-					processor.HandleInterrupts();
+			// The input of a movie only changes at the start of a frame. This can end the playback, which pauses the emulator.
+			if (cartridge.IsROMLoaded() && !isPaused && movieMode != MovieMode::None)
+				AdvanceMovie();
 
-				isStepRequested = false;
+			if (cartridge.IsROMLoaded() && !isPaused)
+			{
+				// Restoring older states would change what a movie records, or desync the one being played.
+				bool isRewinding = isRewindRequested && movieMode == MovieMode::None;
+
+				// The states restored while rewinding are shown as they are.
+				if (isRewinding)
+				{
+					RewindFrame();
+					RunFrame();
+				}
+				else if (launchOptions.runAheadFrames > 0)
+					RunFrameWithRunAhead();
+				else
+					RunFrame();
+
+				cyclesSinceLastCount += static_cast<uint32_t>(GB_CYCLES_PER_FRAME);
+
+				if (!isRewinding)
+					CaptureRewindState();
+			}
+			else if (cartridge.IsROMLoaded() && isStepRequested)
+			{
+				cyclesSinceLastCount += Tick();
 			}
 
-			secondsSinceLastFrame += deltaTimeInSeconds;
-			secondsSinceLastCycleCount += deltaTimeInSeconds;
+			isStepRequested = false;
 
-			if (secondsSinceLastCycleCount >= 1)
+			// Deliver the samples of this frame.
+			apu.CatchUp();
+
+			std::chrono::steady_clock::time_point currentTime = std::chrono::steady_clock::now();
+			if (currentTime - lastCycleCountTime >= std::chrono::seconds(1))
 			{
 				cyclesPerSecond = cyclesSinceLastCount;
 				cyclesSinceLastCount = 0;
-				secondsSinceLastCycleCount = 0;
+				lastCycleCountTime = currentTime;
 			}
 
-			if (secondsSinceLastFrame >= GB_SECONDS_PER_FRAME)
+			PublishStateSnapshot();
+
+			if (!launchOptions.isSpeedUncapped)
+				framePacer.WaitForNextFrame();
+		}
+	}
+
+	void Emulator::RunFrame()
+	{
+		excessCyclesFromLastFrame = RunCycles(excessCyclesFromLastFrame);
+	}
+
+	void Emulator::RunFrameWithRunAhead()
+	{
+		// The real frame is emulated without being shown. Then the machine runs [runAheadFrames] more frames with the same 
+		// input, the last of which is shown, and the state from the end of the real frame is restored. The game seems to 
+		// react to the input that many frames sooner, which hides the lag most games have between reading the joypad 
+		// and showing the result. Only the real frames produce sound and write to the saved data file.
+		uint32_t frameCount = launchOptions.runAheadFrames;
+		bool isRenderingEnabled = ppu.IsRenderingEnabled();
+		bool wasOutputSuspended = apu.IsOutputSuspended();
+		bool wereSavedDataWritesSuspended = cartridge.AreSavedDataWritesSuspended();
+
+		// Whether a frame is drawn is decided when the previous one ends (as VBlank starts), so 
+		// rendering is only enabled during the frame that comes before the one shown.
+		ppu.SetRenderingEnabled(isRenderingEnabled && frameCount == 1);
+		RunFrame();
+
+		// Delivers the samples of the real frame before the output is suspended.
+		apu.CatchUp();
+
+		SaveSnapshot(runAheadSnapshot);
+		isRunningAhead = true;
+		apu.SetOutputSuspended(true);
+		cartridge.SetSavedDataWritesSuspended(true);
+
+		uint32_t excessCycles = excessCyclesFromLastFrame;
+		for (uint32_t i = 1; i <= frameCount; i++)
+		{
+			ppu.SetRenderingEnabled(isRenderingEnabled && i + 1 == frameCount);
+			excessCycles = RunCycles(excessCycles);
+		}
+
+		LoadSnapshot(runAheadSnapshot);
+		isRunningAhead = false;
+		apu.SetOutputSuspended(wasOutputSuspended);
+		cartridge.SetSavedDataWritesSuspended(wereSavedDataWritesSuspended);
+		ppu.SetRenderingEnabled(isRenderingEnabled);
+	}
+
+	uint32_t Emulator::RunCycles(uint32_t excessCycles)
+	{
+		// Instructions rarely end exactly on a frame boundary, so the extra cycles are carried over 
+		// to the next frame. Otherwise, every frame would run slightly long.
+		uint32_t cyclesSinceLastFrame = excessCycles;
+		while (cyclesSinceLastFrame < GB_CYCLES_PER_FRAME)
+			cyclesSinceLastFrame += Tick();
+
+		return cyclesSinceLastFrame - static_cast<uint32_t>(GB_CYCLES_PER_FRAME);
+	}
+
+	uint32_t Emulator::Tick()
+	{
+		uint32_t cycles = processor.Tick();
+
+		timer.Tick(cycles);
+		ppu.Tick(cycles);
+		apu.Tick(cycles);
+		cartridge.Tick(cycles);
+
+		// The debug views only show the real frames.
+		if (!isRunningAhead)
+		{
+			if (isTilesDebugViewVisible)
+				ppu.DebugDrawTiles(cycles);
+
+			if (isSpritesDebugViewVisible)
+				ppu.DebugDrawSprites(cycles);
+
+			if (isBackgroundTileMapDebugViewVisible)
+				ppu.DebugDrawBackgroundTileMap(cycles);
+
+			if (isWindowTileMapDebugViewVisible)
+				ppu.DebugDrawWindowTileMap(cycles);
+		}
+
+		if (cycles > 0)
+			processor.HandleInterrupts();
+
+		return cycles;
+	}
+
+	void Emulator::PushCommand(const EmulatorCommand& command)
+	{
+		std::lock_guard<std::mutex> lock(commandQueueMutex);
+		commandQueue.push(command);
+	}
+
+	void Emulator::ProcessCommands()
+	{
+		std::queue<EmulatorCommand> commands;
+
+		{
+			std::lock_guard<std::mutex> lock(commandQueueMutex);
+			std::swap(commands, commandQueue);
+		}
+
+		while (!commands.empty())
+		{
+			const EmulatorCommand& command = commands.front();
+
+			switch (command.type)
 			{
-				apu.RefreshOutputDevices();
-				inputManager.Update();
-				window.Render(memoryMap, ppu, processor, apu, joypad, inputManager, cartridge, timer, cyclesPerSecond, logEntries);
-				secondsSinceLastFrame = 0;
-				cyclesSinceLastFrame = 0;
+			case EmulatorCommandType::LoadROM:
+				StopMovie();
+				LoadROM(command.romFilePath);
+				break;
+			case EmulatorCommandType::TogglePause:
+				isPaused = !isPaused;
+				break;
+			case EmulatorCommandType::Step:
+				// "Stepping" only works when the emulator is paused. Movies only advance by whole frames.
+				isStepRequested = isPaused && movieMode == MovieMode::None;
+				break;
+			case EmulatorCommandType::SetButtonState:
+				if (movieMode == MovieMode::Recording)
+				{
+					uint8_t buttonMask = 1 << static_cast<uint8_t>(command.button);
+					movieButtonStates = command.isPressed ? movieButtonStates | buttonMask : movieButtonStates & ~buttonMask;
+				}
+				else if (movieMode == MovieMode::None)
+					joypad.SetButtonState(command.button, command.isPressed);
+				break;
+			case EmulatorCommandType::SaveState:
+				SaveStateToFile();
+				break;
+			case EmulatorCommandType::LoadState:
+				if (movieMode == MovieMode::None)
+					LoadStateFromFile();
+				else
+					Logger::WriteWarning("States can't be loaded while a movie is recorded or played.");
+				break;
+			case EmulatorCommandType::RecordMovie:
+				StartMovieRecording(command.startsAtPowerOn);
+				break;
+			case EmulatorCommandType::PlayMovie:
+				StartMoviePlayback(command.moviePath);
+				break;
+			case EmulatorCommandType::StopMovie:
+				StopMovie();
+				break;
+			case EmulatorCommandType::SetPaletteTint:
+				ppu.SetPaletteTint(command.paletteAddress, command.colorIndex, command.color);
+				break;
+			case EmulatorCommandType::SetFrameSkip:
+				ppu.SetFrameSkip(command.framesToSkip, command.frameSkipInterval);
+				break;
+			case EmulatorCommandType::SetRenderingEnabled:
+				ppu.SetRenderingEnabled(command.isEnabled);
+				break;
+			case EmulatorCommandType::SetOutputDevice:
+				apu.SetOutputDevice(command.audioDeviceName);
+				break;
+			case EmulatorCommandType::SetMasterVolume:
+				apu.SetMasterVolume(command.volume);
+				break;
+			case EmulatorCommandType::SetMuted:
+				apu.Mute(command.isEnabled);
+				break;
+			case EmulatorCommandType::SetChannelConnected:
+				switch (command.channelIndex)
+				{
+				case 0: apu.SetChannel1ConnectionStatus(command.isEnabled); break;
+				case 1: apu.SetChannel2ConnectionStatus(command.isEnabled); break;
+				case 2: apu.SetChannel3ConnectionStatus(command.isEnabled); break;
+				case 3: apu.SetChannel4ConnectionStatus(command.isEnabled); break;
+				}
+				break;
+			case EmulatorCommandType::SetSavedDataSearchType:
+				cartridge.SetSavedDataSearchType(command.savedDataSearchType);
+				break;
+			case EmulatorCommandType::SetRTCWallClockCatchUpEnabled:
+				cartridge.SetRTCWallClockCatchUpEnabled(command.isEnabled);
+				break;
+			case EmulatorCommandType::SetGlobalChecksumVerificationEnabled:
+				cartridge.SetGlobalChecksumVerificationEnabled(command.isEnabled);
+				break;
 			}
+
+			commands.pop();
 		}
+	}
 
-		window.Quit();
-		return 0;
+	void Emulator::PublishStateSnapshot()
+	{
+		std::lock_guard<std::mutex> lock(stateSnapshotMutex);
+
+		stateSnapshot.isROMLoaded = cartridge.IsROMLoaded();
+		stateSnapshot.isPaused = isPaused;
+		stateSnapshot.cyclesPerSecond = cyclesPerSecond;
+
+		stateSnapshot.isRewindEnabled = rewindBuffer.IsStarted();
+		stateSnapshot.rewindHistoryDuration = rewindBuffer.GetStateCount() * launchOptions.rewindInterval * GB_SECONDS_PER_FRAME;
+		stateSnapshot.rewindBufferUsage = rewindBuffer.GetUsedCapacity();
+		stateSnapshot.rewindBufferCapacity = rewindBuffer.GetCapacity();
+
+		if (stateSnapshot.romTitle != cartridge.GetROMTitle())
+			stateSnapshot.romTitle = cartridge.GetROMTitle();
+
+		stateSnapshot.cpu.registerAF = processor.ReadRegisterAF();
+		stateSnapshot.cpu.registerBC = processor.ReadRegisterBC();
+		stateSnapshot.cpu.registerDE = processor.ReadRegisterDE();
+		stateSnapshot.cpu.registerHL = processor.ReadRegisterHL();
+		stateSnapshot.cpu.programCounter = processor.ReadProgramCounter();
+		stateSnapshot.cpu.stackPointer = processor.ReadStackPointer();
+		stateSnapshot.cpu.interruptFlagRegister = interruptFlagRegister.Read();
+		stateSnapshot.cpu.interruptEnableRegister = interruptEnableRegister.Read();
+		stateSnapshot.cpu.interruptMasterEnableFlag = processor.GetInterruptMasterEnableFlag();
+
+		stateSnapshot.video.lcdc = ppu.ReadLCDC();
+		stateSnapshot.video.stat = ppu.ReadLCDSTAT();
+		stateSnapshot.video.scy = ppu.ReadSCY();
+		stateSnapshot.video.scx = ppu.ReadSCX();
+		stateSnapshot.video.ly = ppu.ReadLY();
+		stateSnapshot.video.lyc = ppu.ReadLYC();
+		stateSnapshot.video.wy = ppu.ReadWY();
+		stateSnapshot.video.wx = ppu.ReadWX();
+
+		stateSnapshot.sound.nr10 = apu.ReadNR10();
+		stateSnapshot.sound.nr11 = apu.ReadNR11();
+		stateSnapshot.sound.nr12 = apu.ReadNR12();
+		stateSnapshot.sound.nr13 = apu.ReadNR13();
+		stateSnapshot.sound.nr14 = apu.ReadNR14();
+		stateSnapshot.sound.nr21 = apu.ReadNR21();
+		stateSnapshot.sound.nr22 = apu.ReadNR22();
+		stateSnapshot.sound.nr23 = apu.ReadNR23();
+		stateSnapshot.sound.nr24 = apu.ReadNR24();
+		stateSnapshot.sound.nr30 = apu.ReadNR30();
+		stateSnapshot.sound.nr31 = apu.ReadNR31();
+		stateSnapshot.sound.nr32 = apu.ReadNR32();
+		stateSnapshot.sound.nr33 = apu.ReadNR33();
+		stateSnapshot.sound.nr34 = apu.ReadNR34();
+		stateSnapshot.sound.nr41 = apu.ReadNR41();
+		stateSnapshot.sound.nr42 = apu.ReadNR42();
+		stateSnapshot.sound.nr43 = apu.ReadNR43();
+		stateSnapshot.sound.nr44 = apu.ReadNR44();
+		stateSnapshot.sound.nr50 = apu.ReadNR50();
+		stateSnapshot.sound.nr51 = apu.ReadNR51();
+		stateSnapshot.sound.nr52 = apu.ReadNR52();
+		stateSnapshot.sound.metrics = apu.GetMetrics();
+
+		stateSnapshot.joypad.joypadRegister = joypad.Read();
+		stateSnapshot.joypad.isDownOrStartPressed = joypad.IsDownOrStartPressed();
+		stateSnapshot.joypad.isUpOrSelectPressed = joypad.IsUpOrSelectPressed();
+		stateSnapshot.joypad.isLeftOrBPressed = joypad.IsLeftOrBPressed();
+		stateSnapshot.joypad.isRightOrAPressed = joypad.IsRightOrAPressed();
+
+		stateSnapshot.timer.dividerRegister = timer.GetDividerRegister();
+		stateSnapshot.timer.timerCounter = timer.GetTimerCounter();
+		stateSnapshot.timer.timerModulo = timer.GetTimerModulo();
+		stateSnapshot.timer.timerControlRegister = timer.GetTimerControlRegister();
+
+		SettingsSnapshot& settings = stateSnapshot.settings;
+
+		for (uint8_t i = 0; i < 4; i++)
+		{
+			settings.backgroundPaletteTints[i] = ppu.GetPaletteTint(GB_BACKGROUND_PALETTE_ADDRESS, i);
+			settings.spritePalette0Tints[i] = ppu.GetPaletteTint(GB_SPRITE_PALETTE_0_ADDRESS, i);
+			settings.spritePalette1Tints[i] = ppu.GetPaletteTint(GB_SPRITE_PALETTE_1_ADDRESS, i);
+		}
+
+		settings.framesToSkip = ppu.GetFramesToSkip();
+		settings.frameSkipInterval = ppu.GetFrameSkipInterval();
+		settings.isRenderingEnabled = ppu.IsRenderingEnabled();
+
+		if (settings.outputDeviceNames != apu.GetAllOutputDeviceNames())
+			settings.outputDeviceNames = apu.GetAllOutputDeviceNames();
+
+		if (settings.currentOutputDeviceName != apu.GetCurrentOutputDeviceName())
+			settings.currentOutputDeviceName = apu.GetCurrentOutputDeviceName();
+
+		settings.masterVolume = apu.GetMasterVolume();
+		settings.isMuted = apu.IsMuted();
+		settings.channelConnectionStates = { apu.IsChannel1Connected(), apu.IsChannel2Connected(), apu.IsChannel3Connected(), apu.IsChannel4Connected() };
+
+		settings.savedDataSearchType = cartridge.GetSavedDataSearchType();
+		settings.isRTCWallClockCatchUpEnabled = cartridge.IsRTCWallClockCatchUpEnabled();
+		settings.isGlobalChecksumVerificationEnabled = cartridge.IsGlobalChecksumVerificationEnabled();
 	}
 
 	void Emulator::SetupMemoryMap()
@@ -121,20 +489,19 @@ namespace ModestGB
 		memoryMap.AttachPPU(&ppu);
 		memoryMap.AttachAPU(&apu);
 		memoryMap.AttachCartridge(&cartridge);
-		memoryMap.AttachEchoRAM(&echoRam);
-		memoryMap.AttachGenericIO(&ioRegisters);
 		memoryMap.AttachHRAM(&hram);
 		memoryMap.AttachInterruptEnableRegister(&interruptEnableRegister);
 		memoryMap.AttachInterruptFlagRegister(&interruptFlagRegister);
 		memoryMap.AttachJoypadRegister(&joypad);
 		memoryMap.AttachTimer(&timer);
 		memoryMap.AttachWRAM(&wram);
-		memoryMap.AttachRestrictedMemory(&restrictedMemory);
+		memoryMap.AttachSerialRegisters(&serialTransferDataRegister, &serialTransferControlRegister);
 	}
 
 	void Emulator::AddLogEntry(const std::string& logEntry, LogMessageType messageType)
 	{
-		logEntries.push_back(logEntry);
+		std::lock_guard<std::mutex> lock(pendingLogEntriesMutex);
+		pendingLogEntries.push_back(logEntry);
 	}
 
 	void Emulator::OnInputEventReceived(SDL_Event e)
@@ -165,18 +532,43 @@ namespace ModestGB
 		if (path.empty())
 			return;
 
-		LoadROM(path);
+		PushCommand({ .type = EmulatorCommandType::LoadROM, .romFilePath = path });
 	}
 
 	void Emulator::OnPauseButtonPressed()
 	{
-		isPaused = !isPaused;
-		window.SetPauseButtonLabel(isPaused ? "Resume" : "Pause");
+		PushCommand({ .type = EmulatorCommandType::TogglePause });
 	}
 
 	void Emulator::OnStepButtonPressed()
 	{
-		isStepRequested = true;
+		PushCommand({ .type = EmulatorCommandType::Step });
+	}
+
+	void Emulator::OnKeyPressed(KeyCode keyCode)
+	{
+		PushButtonStateCommands(inputMapping.GetButtonsMappedToKeyCode(keyCode), true);
+	}
+
+	void Emulator::OnKeyReleased(KeyCode keyCode)
+	{
+		PushButtonStateCommands(inputMapping.GetButtonsMappedToKeyCode(keyCode), false);
+	}
+
+	void Emulator::OnControllerButtonPressed(ControllerButtonCode buttonCode)
+	{
+		PushButtonStateCommands(inputMapping.GetButtonsMappedToControllerButtonCode(buttonCode), true);
+	}
+
+	void Emulator::OnControllerButtonReleased(ControllerButtonCode buttonCode)
+	{
+		PushButtonStateCommands(inputMapping.GetButtonsMappedToControllerButtonCode(buttonCode), false);
+	}
+
+	void Emulator::PushButtonStateCommands(const std::vector<GBButton>& buttons, bool isPressed)
+	{
+		for (GBButton button : buttons)
+			PushCommand({ .type = EmulatorCommandType::SetButtonState, .button = button, .isPressed = isPressed });
 	}
 
 	void Emulator::OnClearButtonPressed()
@@ -184,6 +576,36 @@ namespace ModestGB
 		logEntries.clear();
 	}
 
+	void Emulator::OnSaveStateButtonPressed()
+	{
+		PushCommand({ .type = EmulatorCommandType::SaveState });
+	}
+
+	void Emulator::OnLoadStateButtonPressed()
+	{
+		PushCommand({ .type = EmulatorCommandType::LoadState });
+	}
+
+	void Emulator::OnRecordMovieFromPowerOnButtonPressed()
+	{
+		PushCommand({ .type = EmulatorCommandType::RecordMovie, .startsAtPowerOn = true });
+	}
+
+	void Emulator::OnRecordMovieFromCurrentStateButtonPressed()
+	{
+		PushCommand({ .type = EmulatorCommandType::RecordMovie, .startsAtPowerOn = false });
+	}
+
+	void Emulator::OnMovieFileSelected(const std::string& path)
+	{
+		PushCommand({ .type = EmulatorCommandType::PlayMovie, .moviePath = path });
+	}
+
+	void Emulator::OnStopMovieButtonPressed()
+	{
+		PushCommand({ .type = EmulatorCommandType::StopMovie });
+	}
+
 	bool Emulator::LoadROM(const std::string& romFilePath)
 	{
 		if (!cartridge.Load(romFilePath))
@@ -192,12 +614,303 @@ namespace ModestGB
 			return false;
 		};
 
+		ResetMachine();
+		rewindBuffer.Clear();
+		framesSinceLastRewindCapture = 0;
+
+		return true;
+	}
+
+	void Emulator::ResetMachine()
+	{
 		processor.Reset();
 		ppu.Reset();
 		timer.Reset();
 		apu.Reset();
 		memoryMap.Reset();
+		excessCyclesFromLastFrame = 0;
+	}
+
+	void Emulator::SaveState(std::vector<uint8_t>& buffer)
+	{
+		StateWriter writer(buffer);
+		WriteState(writer);
+	}
+
+	bool Emulator::LoadState(const uint8_t* data, size_t size)
+	{
+		StateReader reader(data, size);
+		return ReadState(reader);
+	}
+
+	void Emulator::SaveSnapshot(MachineSnapshot& snapshot)
+	{
+		StateWriter writer(snapshot);
+		WriteState(writer);
+	}
+
+	bool Emulator::LoadSnapshot(const MachineSnapshot& snapshot)
+	{
+		StateReader reader(snapshot);
+		return ReadState(reader);
+	}
+
+	void Emulator::WriteState(StateWriter& writer)
+	{
+		writer.WriteHeader();
+
+		// The cartridge goes first, so a state made with a different ROM is rejected before anything is overwritten.
+		cartridge.Serialize(writer);
+		processor.Serialize(writer);
+		ppu.Serialize(writer);
+		apu.Serialize(writer);
+		timer.Serialize(writer);
+		joypad.Serialize(writer);
+		wram.Serialize(writer);
+		hram.Serialize(writer);
+		writer.Write(serialTransferDataRegister.Read());
+		writer.Write(serialTransferControlRegister.Read());
+		writer.Write(interruptEnableRegister.Read());
+		writer.Write(interruptFlagRegister.Read());
+
+		writer.Finish();
+	}
+
+	bool Emulator::ReadState(StateReader& reader)
+	{
+		if (!reader.ReadHeader())
+			return false;
+
+		cartridge.Deserialize(reader);
+		if (reader.HasFailed())
+			return false;
+
+		processor.Deserialize(reader);
+		ppu.Deserialize(reader);
+		apu.Deserialize(reader);
+		timer.Deserialize(reader);
+		joypad.Deserialize(reader);
+		wram.Deserialize(reader);
+		hram.Deserialize(reader);
+		if (reader.GetVersion() < 3)
+		{
+			// Older states stored echo RAM and the unusable region as separate memories, which are 
+			// skipped, and a block of generic I/O memory, of which only the serial and palette registers are kept.
+			reader.Skip(reader.Read<uint32_t>());
+			reader.Skip(reader.Read<uint32_t>());
+
+			std::array<uint8_t, LEGACY_IO_REGISTERS_SIZE> ioRegisters;
+			if (reader.Read<uint32_t>() != LEGACY_IO_REGISTERS_SIZE)
+				reader.Fail();
+
+			reader.Read(ioRegisters);
+			serialTransferDataRegister.Write(ioRegisters[GB_SERIAL_TRANSFER_DATA_ADDRESS - GB_IO_REGISTERS_START_ADDRESS]);
+			serialTransferControlRegister.Write(ioRegisters[GB_SERIAL_TRANSFER_CONTROL_ADDRESS - GB_IO_REGISTERS_START_ADDRESS]);
+			ppu.WriteBGP(ioRegisters[GB_BACKGROUND_PALETTE_ADDRESS - GB_IO_REGISTERS_START_ADDRESS]);
+			ppu.WriteOBP0(ioRegisters[GB_SPRITE_PALETTE_0_ADDRESS - GB_IO_REGISTERS_START_ADDRESS]);
+			ppu.WriteOBP1(ioRegisters[GB_SPRITE_PALETTE_1_ADDRESS - GB_IO_REGISTERS_START_ADDRESS]);
+		}
+		else
+		{
+			serialTransferDataRegister.Write(reader.Read<uint8_t>());
+			serialTransferControlRegister.Write(reader.Read<uint8_t>());
+		}
+
+		interruptEnableRegister.Write(reader.Read<uint8_t>());
+		interruptFlagRegister.Write(reader.Read<uint8_t>());
+
+		// The size was checked against the header, so this only happens if a component's layout changed without 
+		// SAVE_STATE_VERSION being incremented. The machine is reset rather than left half restored.
+		if (reader.HasFailed() || !reader.IsAtEnd())
+		{
+			Logger::WriteError("The save state is corrupted. The emulator has been reset.");
+			ResetMachine();
+			return false;
+		}
 
 		return true;
 	}
+
+	std::string Emulator::GetStateFilePath() const
+	{
+		return std::filesystem::path(cartridge.GetSavedDataPath()).replace_extension(".state").string();
+	}
+
+	void Emulator::SaveStateToFile()
+	{
+		if (!cartridge.IsROMLoaded())
+			return;
+
+		SaveState(saveStateBuffer);
+
+		std::string path = GetStateFilePath();
+		std::ofstream file(path, std::ios::binary);
+		file.write(reinterpret_cast<const char*>(saveStateBuffer.data()), saveStateBuffer.size());
+
+		if (!file)
+		{
+			Logger::WriteError("Failed to write the save state to " + path);
+			return;
+		}
+
+		Logger::WriteInfo("State saved to " + path);
+	}
+
+	void Emulator::LoadStateFromFile()
+	{
+		if (!cartridge.IsROMLoaded())
+			return;
+
+		std::string path = GetStateFilePath();
+		std::ifstream file(path, std::ios::binary);
+
+		if (!file.is_open())
+		{
+			Logger::WriteError("No save state found at " + path);
+			return;
+		}
+
+		std::vector<uint8_t> data = std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+		if (LoadState(data.data(), data.size()))
+			Logger::WriteInfo("State loaded from " + path);
+	}
+
+	void Emulator::CaptureRewindState()
+	{
+		if (!rewindBuffer.IsStarted() || ++framesSinceLastRewindCapture < launchOptions.rewindInterval)
+			return;
+
+		framesSinceLastRewindCapture = 0;
+
+		// Only the serialization happens here, the compression is done by the rewind buffer's own thread.
+		SaveState(rewindStateBuffer);
+		rewindBuffer.Push(rewindStateBuffer);
+	}
+
+	void Emulator::RewindFrame()
+	{
+		// Save states don't include the framebuffers, so the frame that follows the restored state is emulated 
+		// as usual afterwards to show where the machine is. Every frame goes back by one state of the history.
+		if (rewindBuffer.Pop(rewindStateBuffer))
+			LoadState(rewindStateBuffer.data(), rewindStateBuffer.size());
+	}
+
+	void Emulator::StartMovieRecording(bool startsAtPowerOn)
+	{
+		if (!cartridge.IsROMLoaded())
+		{
+			Logger::WriteError("A ROM must be loaded to record a movie.");
+			return;
+		}
+
+		StopMovie();
+
+		if (startsAtPowerOn)
+			ResetMachine();
+
+		movie.romHash = cartridge.GetROMHash();
+		movie.startsAtPowerOn = startsAtPowerOn;
+		movie.initialExcessCycles = excessCyclesFromLastFrame;
+		movie.frames.clear();
+
+		// Even a movie that starts at power-on embeds a state, since the cartridge RAM and real-time clock are loaded from the saved data file.
+		SaveState(movie.initialState);
+
+		movieMode = MovieMode::Recording;
+		movieFrameIndex = 0;
+		movieButtonStates = joypad.GetButtonStates();
+
+		Logger::WriteInfo("Recording a movie to " + GetMovieFilePath());
+	}
+
+	void Emulator::StartMoviePlayback(const std::string& path)
+	{
+		if (!cartridge.IsROMLoaded())
+		{
+			Logger::WriteError("A ROM must be loaded to play a movie.");
+			return;
+		}
+
+		StopMovie();
+
+		if (!movie.LoadFromFile(path))
+			return;
+
+		if (movie.romHash != cartridge.GetROMHash())
+		{
+			Logger::WriteError("The movie was recorded with a different ROM.");
+			return;
+		}
+
+		// The saved data file is left as it was before the movie, until another ROM is loaded.
+		cartridge.SetSavedDataWritesSuspended(true);
+
+		if (!LoadState(movie.initialState.data(), movie.initialState.size()))
+		{
+			Logger::WriteError("The movie's initial state couldn't be loaded.");
+			return;
+		}
+
+		excessCyclesFromLastFrame = movie.initialExcessCycles;
+		rewindBuffer.Clear();
+		framesSinceLastRewindCapture = 0;
+
+		movieMode = MovieMode::Playing;
+		movieFrameIndex = 0;
+		isPaused = false;
+		moviePlaybackStartTime = std::chrono::steady_clock::now();
+
+		Logger::WriteInfo("Playing " + std::to_string(movie.frames.size()) + " frames from " + path);
+	}
+
+	void Emulator::StopMovie()
+	{
+		if (movieMode == MovieMode::None)
+			return;
+
+		if (movieMode == MovieMode::Recording)
+		{
+			std::string path = GetMovieFilePath();
+
+			if (movie.SaveToFile(path))
+				Logger::WriteInfo("Movie of " + std::to_string(movie.frames.size()) + " frames saved to " + path);
+		}
+		else
+		{
+			// The buttons the player holds are picked up again by their next presses and releases.
+			joypad.SetButtonStates(0);
+		}
+
+		movieMode = MovieMode::None;
+	}
+
+	void Emulator::AdvanceMovie()
+	{
+		if (movieMode == MovieMode::Recording)
+		{
+			movie.frames.push_back(movieButtonStates);
+			joypad.SetButtonStates(movieButtonStates);
+			movieFrameIndex++;
+			return;
+		}
+
+		if (movieFrameIndex == movie.frames.size())
+		{
+			double elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - moviePlaybackStartTime).count();
+			Logger::WriteInfo("Movie finished: " + std::to_string(movie.frames.size()) + " frames played in " + std::to_string(elapsedSeconds) + 
+				" s (" + std::to_string(elapsedSeconds > 0 ? movie.frames.size() / elapsedSeconds : 0) + " frames per second).");
+
+			StopMovie();
+			isPaused = true;
+			return;
+		}
+
+		joypad.SetButtonStates(movie.frames[movieFrameIndex++]);
+	}
+
+	std::string Emulator::GetMovieFilePath() const
+	{
+		return std::filesystem::path(cartridge.GetSavedDataPath()).replace_extension(".movie").string();
+	}
 }
\ No newline at end of file
@@ -1,9 +1,11 @@
+#include <cfloat>
 #include "nfd.h"
 #include "EmulatorWindow.hpp"
 #include "Logger.hpp"
 #include "Utils/DataConversions.hpp"
 #include "Utils/GBSpecs.hpp"
 #include "Utils/MemoryUtils.hpp"
+#include "Utils/FFT.hpp"
 #include "EmbeddedFont.hpp"
 
 namespace ModestGB
@@ -35,6 +37,12 @@ namespace ModestGB
 	const uint8_t SPRITE_2_PALETTE_TINT_ID_3 = 11;
 
 	const float MAX_VOLUME = 100.0f;
+	const int MAX_FRAME_SKIP_INTERVAL = 10;
+
+	const char* AUDIO_CAPTURE_SOURCE_NAMES[] = { "Channel 1", "Channel 2", "Channel 3", "Channel 4", "Mixed" };
+	const uint32_t SOUND_WAVEFORM_SAMPLE_COUNT = 512;
+	const uint32_t SOUND_SPECTRUM_SAMPLE_COUNT = 2048;
+	const float SOUND_SPECTRUM_MIN_DB = -90.0f;
 
 	const std::map<SavedDataSearchType, std::string> SAVED_DATA_SEARCH_TYPE_STRINGS
 	{
@@ -50,7 +58,7 @@ namespace ModestGB
 
 	bool EmulatorWindow::Initialize()
 	{
-		if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_JOYSTICK | SDL_INIT_GAMECONTROLLER) < 0)
+		if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_JOYSTICK | SDL_INIT_GAMECONTROLLER) < 0)
 		{
 			Logger::WriteError("SDL failed to initialize. Error: " + std::string(SDL_GetError()));
 			return false;
@@ -68,7 +76,7 @@ namespace ModestGB
 
 		SDL_SetWindowMinimumSize(sdlWindow, MINIMUM_SDL_WINDOW_WIDTH, MINIMUM_SDL_WINDOW_HEIGHT);
 
-		sdlRenderer = SDL_CreateRenderer(sdlWindow, 0, 0);
+		sdlRenderer = SDL_CreateRenderer(sdlWindow, 0, SDL_RENDERER_PRESENTVSYNC);
 
 		if (sdlRenderer == nullptr)
 		{
@@ -76,6 +84,11 @@ namespace ModestGB
 			return false;
 		}
 
+		// Not every renderer supports vsync, so check whether the request was honored.
+		SDL_RendererInfo rendererInfo;
+		if (SDL_GetRendererInfo(sdlRenderer, &rendererInfo) == 0)
+			isVSyncEnabled = (rendererInfo.flags & SDL_RENDERER_PRESENTVSYNC) != 0;
+
 		IMGUI_CHECKVERSION();
 		if (ImGui::CreateContext() == nullptr)
 		{
@@ -126,30 +139,52 @@ namespace ModestGB
 		}
 	}
 
+	bool EmulatorWindow::IsVSyncEnabled() const
+	{
+		return isVSyncEnabled;
+	}
+
+	void EmulatorWindow::SetVSyncEnabled(bool value)
+	{
+		if (value == isVSyncEnabled)
+			return;
+
+		if (SDL_RenderSetVSync(sdlRenderer, value ? 1 : 0) < 0)
+		{
+			Logger::WriteWarning("Failed to change the vsync mode. Error: " + std::string(SDL_GetError()));
+			return;
+		}
+
+		isVSyncEnabled = value;
+	}
+
 	SDL_Window* EmulatorWindow::GetSDLWindow()
 	{
 		return sdlWindow;
 	}
 
-	void EmulatorWindow::Render(const MemoryMap& memoryMap, PPU& ppu, const CPU& processor, APU& apu, Joypad& joypad, InputManager& inputManager, Cartridge& cartridge, const Timer& timer, uint32_t cyclesPerSecond, const std::vector<std::string>& logEntries)
+	void EmulatorWindow::Render(const EmulatorStateSnapshot& snapshot, const PPU& ppu, const APU& apu, InputMapping& inputMapping, InputManager& inputManager, const std::vector<std::string>& logEntries)
 	{
 		StartFrame();
 		ClearScreen();
 
+		// Only stays true while the button is held in the CPU window.
+		isRewindButtonHeld = false;
+
 		RenderMainWindow();
-		RenderGameView(ppu, cartridge);
+		RenderGameView(ppu, snapshot.romTitle);
 
 		if (shouldRenderCPUDebugWindow)
-			RenderCPUDebugWindow(processor, memoryMap, cyclesPerSecond);
+			RenderCPUDebugWindow(snapshot);
 
 		if (shouldRenderSoundDebugWindow)
-			RenderSoundDebugWindow(apu);
+			RenderSoundDebugWindow(apu, snapshot.sound, snapshot.settings);
 
 		if (shouldRenderJoypadDebugWindow)
-			RenderJoypadDebugWindow(joypad);
+			RenderJoypadDebugWindow(snapshot.joypad);
 
 		if (shouldRenderVideoRegistersDebugWindow)
-			RenderVideoRegistersDebugWindow(ppu);
+			RenderVideoRegistersDebugWindow(snapshot.video);
 
 		if (shouldRenderTilesDebugWindow)
 			RenderTilesDebugWindow(ppu);
@@ -164,13 +199,13 @@ namespace ModestGB
 			RenderWindowTileMapDebugWindow(ppu);
 
 		if (shouldRenderTimerDebugWindow)
-			RenderTimerDebugWindow(timer);
+			RenderTimerDebugWindow(snapshot.timer);
 
 		if (shouldRenderLogWindow)
 			RenderLogWindow(logEntries);
 
 		if (shouldRenderSettingsWindow)
-			RenderSettingsWindow(ppu, apu, joypad, inputManager, cartridge);
+			RenderSettingsWindow(snapshot.settings, inputMapping, inputManager);
 
 		EndFrame();
 	}
@@ -213,6 +248,41 @@ namespace ModestGB
 		quitButtonPressedCallback = callback;
 	}
 
+	void EmulatorWindow::RegisterSaveStateButtonCallback(SimpleCallback callback)
+	{
+		saveStateButtonPressedCallback = callback;
+	}
+
+	void EmulatorWindow::RegisterLoadStateButtonCallback(SimpleCallback callback)
+	{
+		loadStateButtonPressedCallback = callback;
+	}
+
+	void EmulatorWindow::RegisterRecordMovieFromPowerOnButtonCallback(SimpleCallback callback)
+	{
+		recordMovieFromPowerOnButtonPressedCallback = callback;
+	}
+
+	void EmulatorWindow::RegisterRecordMovieFromCurrentStateButtonCallback(SimpleCallback callback)
+	{
+		recordMovieFromCurrentStateButtonPressedCallback = callback;
+	}
+
+	void EmulatorWindow::RegisterMovieFileSelectionCallback(FileSelectionCallback callback)
+	{
+		movieFileSelectionCallback = callback;
+	}
+
+	void EmulatorWindow::RegisterStopMovieButtonCallback(SimpleCallback callback)
+	{
+		stopMovieButtonPressedCallback = callback;
+	}
+
+	void EmulatorWindow::RegisterSettingChangedCallback(EmulatorCommandCallback callback)
+	{
+		settingChangedCallback = callback;
+	}
+
 	void EmulatorWindow::RenderMainWindow()
 	{
 		// Make the main window have the same size and position as the main viewport.
@@ -233,12 +303,40 @@ namespace ModestGB
 				{
 					if (ImGui::MenuItem("Load ROM"))
 					{
-						std::string path = GetPathFromFileBrowser("Game Boy ROMs", "gb,rom");
+						std::string path = GetPathFromFileBrowser("Game Boy ROMs", "gb,rom,zip,gz");
 
 						if (!path.empty())
 							romFileSelectionCallback(path);
 					}
 
+					if (ImGui::MenuItem("Save State"))
+						saveStateButtonPressedCallback();
+
+					if (ImGui::MenuItem("Load State"))
+						loadStateButtonPressedCallback();
+
+					if (ImGui::BeginMenu("Movie"))
+					{
+						if (ImGui::MenuItem("Record From Power-On"))
+							recordMovieFromPowerOnButtonPressedCallback();
+
+						if (ImGui::MenuItem("Record From Current State"))
+							recordMovieFromCurrentStateButtonPressedCallback();
+
+						if (ImGui::MenuItem("Play"))
+						{
+							std::string path = GetPathFromFileBrowser("Modest-GB Movies", "movie");
+
+							if (!path.empty())
+								movieFileSelectionCallback(path);
+						}
+
+						if (ImGui::MenuItem("Stop"))
+							stopMovieButtonPressedCallback();
+
+						ImGui::EndMenu();
+					}
+
 					if (ImGui::MenuItem("Settings"))
 						shouldRenderSettingsWindow = true;
 
@@ -308,13 +406,11 @@ namespace ModestGB
 		ImGui::End();
 	}
 
-	void EmulatorWindow::RenderGameView(const PPU& ppu, const Cartridge& cartridge)
+	void EmulatorWindow::RenderGameView(const PPU& ppu, const std::string& romTitle)
 	{
 		// By default, force the window to be docked.
 		ImGui::SetNextWindowDockID(dockspaceID, ImGuiCond_FirstUseEver);
 
-		std::string romTitle = cartridge.GetROMTitle().c_str();
-
 		// Window containing the currently loaded game, if any.
 		RenderWindowWithFramebuffer(romTitle.empty() ? "Game" : romTitle.c_str(), ppu.GetPrimaryFramebuffer());
 	}
@@ -352,7 +448,7 @@ namespace ModestGB
 		EndWindow();
 	}
 
-	void EmulatorWindow::RenderCPUDebugWindow(const CPU& processor, const MemoryMap& memoryMap, uint32_t cyclesPerSecond)
+	void EmulatorWindow::RenderCPUDebugWindow(const EmulatorStateSnapshot& snapshot)
 	{
 		// By default, force the window to be docked.
 		ImGui::SetNextWindowDockID(dockspaceID, ImGuiCond_FirstUseEver);
@@ -362,19 +458,15 @@ namespace ModestGB
 		{
 			ImGui::Text("Performance");
 			ImGui::Separator();
-			ImGui::Text(("Clock speed:   " + std::to_string(cyclesPerSecond / 1000000.0) + " MHz").c_str());
+			ImGui::Text(("Clock speed:   " + std::to_string(snapshot.cyclesPerSecond / 1000000.0) + " MHz").c_str());
 			ImGui::Spacing();
 			ImGui::Spacing();
 
-			static bool isPaused = false;
 			if (ImGui::Button(pauseButtonLabel.c_str()))
-			{
-				isPaused = !isPaused;
 				pauseButtonPressedCallback();
-			}
 
 			// "Stepping" only works when the emulator is paused.
-			if (isPaused)
+			if (snapshot.isPaused)
 			{
 				ImGui::SameLine();
 
@@ -382,6 +474,17 @@ namespace ModestGB
 					stepButtonPressedCallback();
 			}
 
+			if (snapshot.isRewindEnabled)
+			{
+				// The emulator keeps going back in time for as long as the button is held.
+				ImGui::SameLine();
+				ImGui::Button("Rewind");
+				isRewindButtonHeld = ImGui::IsItemActive();
+
+				ImGui::Text(("Rewind history: " + std::to_string(snapshot.rewindHistoryDuration) + " s (" + 
+					std::to_string(snapshot.rewindBufferUsage / KiB) + " / " + std::to_string(snapshot.rewindBufferCapacity / KiB) + " KiB)").c_str());
+			}
+
 			ImGui::Spacing();
 			ImGui::Spacing();
 
@@ -399,16 +502,16 @@ namespace ModestGB
 				ImGui::TableSetupColumn("##CPU Value 2", ImGuiTableColumnFlags_NoResize, valueColWidth);
 
 				ImGui::TableNextRow();
-				RenderRegister16("[ AF ]", processor.ReadRegisterAF(), 0);
-				RenderRegister16("[ BC ]", processor.ReadRegisterBC(), 2);
+				RenderRegister16("[ AF ]", snapshot.cpu.registerAF, 0);
+				RenderRegister16("[ BC ]", snapshot.cpu.registerBC, 2);
 
 				ImGui::TableNextRow();
-				RenderRegister16("[ DE ]", processor.ReadRegisterDE(), 0);
-				RenderRegister16("[ HL ]", processor.ReadRegisterHL(), 2);
+				RenderRegister16("[ DE ]", snapshot.cpu.registerDE, 0);
+				RenderRegister16("[ HL ]", snapshot.cpu.registerHL, 2);
 
 				ImGui::TableNextRow();
-				RenderRegister16("[ PC ]", processor.ReadProgramCounter(), 0);
-				RenderRegister16("[ SP ]", processor.ReadStackPointer(), 2);
+				RenderRegister16("[ PC ]", snapshot.cpu.programCounter, 0);
+				RenderRegister16("[ SP ]", snapshot.cpu.stackPointer, 2);
 
 				ImGui::EndTable();
 			}
@@ -433,14 +536,14 @@ namespace ModestGB
 
 				ImGui::TableNextRow();
 
-				RenderRegister8("[ IF ]", memoryMap.Read(GB_INTERRUPT_FLAG_ADDRESS), 0);
-				RenderRegister8("[ IE ]", memoryMap.Read(GB_INTERRUPT_ENABLE_ADDRESS), 2);
+				RenderRegister8("[ IF ]", snapshot.cpu.interruptFlagRegister, 0);
+				RenderRegister8("[ IE ]", snapshot.cpu.interruptEnableRegister, 2);
 
 				ImGui::TableSetColumnIndex(4);
 				ImGui::Text("[ IME ]");
 
 				ImGui::TableSetColumnIndex(5);
-				ImGui::Text(std::to_string(processor.GetInterruptMasterEnableFlag()).c_str());
+				ImGui::Text(std::to_string(snapshot.cpu.interruptMasterEnableFlag).c_str());
 
 				ImGui::EndTable();
 			}
@@ -449,7 +552,7 @@ namespace ModestGB
 		EndWindow();
 	}
 
-	void EmulatorWindow::RenderSoundDebugWindow(APU& apu)
+	void EmulatorWindow::RenderSoundDebugWindow(const APU& apu, const SoundStateSnapshot& sound, const SettingsSnapshot& settings)
 	{
 		// By default, force the window to be docked.
 		ImGui::SetNextWindowDockID(dockspaceID, ImGuiCond_FirstUseEver);
@@ -472,9 +575,9 @@ namespace ModestGB
 				ImGui::TableSetupColumn("##Sound Control Register 3 Value", ImGuiTableColumnFlags_NoResize, valueColWidth);
 
 				ImGui::TableNextRow();
-				RenderRegister8("[ NR50 ]", apu.ReadNR50(), 0);
-				RenderRegister8("[ NR51 ]", apu.ReadNR51(), 2);
-				RenderRegister8("[ NR52 ]", apu.ReadNR52(), 4);
+				RenderRegister8("[ NR50 ]", sound.nr50, 0);
+				RenderRegister8("[ NR51 ]", sound.nr51, 2);
+				RenderRegister8("[ NR52 ]", sound.nr52, 4);
 
 				ImGui::EndTable();
 			}
@@ -484,9 +587,9 @@ namespace ModestGB
 
 
 
-			bool isChannel1Connected = apu.IsChannel1Connected();
-			ImGui::Checkbox("Channel 1", &isChannel1Connected);
-			apu.SetChannel1ConnectionStatus(isChannel1Connected);
+			bool isChannel1Connected = settings.channelConnectionStates[0];
+			if (ImGui::Checkbox("Channel 1", &isChannel1Connected))
+				settingChangedCallback({ .type = EmulatorCommandType::SetChannelConnected, .channelIndex = 0, .isEnabled = isChannel1Connected });
 			ImGui::Separator();
 
 			if (ImGui::BeginTable("##Channel 1 Registers", 6, ImGuiTableFlags_None | ImGuiTableFlags_SizingFixedFit))
@@ -499,13 +602,13 @@ namespace ModestGB
 				ImGui::TableSetupColumn("##Channel 1 Reg 3 Value", ImGuiTableColumnFlags_NoResize, valueColWidth);
 
 				ImGui::TableNextRow();
-				RenderRegister8("[ NR10 ]", apu.ReadNR10(), 0);
-				RenderRegister8("[ NR11 ]", apu.ReadNR11(), 2);
-				RenderRegister8("[ NR12 ]", apu.ReadNR12(), 4);
+				RenderRegister8("[ NR10 ]", sound.nr10, 0);
+				RenderRegister8("[ NR11 ]", sound.nr11, 2);
+				RenderRegister8("[ NR12 ]", sound.nr12, 4);
 
 				ImGui::TableNextRow();
-				RenderRegister8("[ NR13 ]", apu.ReadNR13(), 0);
-				RenderRegister8("[ NR14 ]", apu.ReadNR14(), 2);
+				RenderRegister8("[ NR13 ]", sound.nr13, 0);
+				RenderRegister8("[ NR14 ]", sound.nr14, 2);
 
 				ImGui::EndTable();
 			}
@@ -514,9 +617,9 @@ namespace ModestGB
 			ImGui::Spacing();
 
 			// Channel 2
-			bool isChannel2Connected = apu.IsChannel2Connected();
-			ImGui::Checkbox("Channel 2", &isChannel2Connected);
-			apu.SetChannel2ConnectionStatus(isChannel2Connected);
+			bool isChannel2Connected = settings.channelConnectionStates[1];
+			if (ImGui::Checkbox("Channel 2", &isChannel2Connected))
+				settingChangedCallback({ .type = EmulatorCommandType::SetChannelConnected, .channelIndex = 1, .isEnabled = isChannel2Connected });
 			ImGui::Separator();
 
 			if (ImGui::BeginTable("##Channel 2 Registers", 4, ImGuiTableFlags_None | ImGuiTableFlags_SizingFixedFit))
@@ -527,12 +630,12 @@ namespace ModestGB
 				ImGui::TableSetupColumn("##Channel 2 Reg 2 Value", ImGuiTableColumnFlags_NoResize, valueColWidth);
 
 				ImGui::TableNextRow();
-				RenderRegister8("[ NR21 ]", apu.ReadNR21(), 0);
-				RenderRegister8("[ NR22 ]", apu.ReadNR22(), 2);
+				RenderRegister8("[ NR21 ]", sound.nr21, 0);
+				RenderRegister8("[ NR22 ]", sound.nr22, 2);
 
 				ImGui::TableNextRow();
-				RenderRegister8("[ NR23 ]", apu.ReadNR23(), 0);
-				RenderRegister8("[ NR24 ]", apu.ReadNR24(), 2);
+				RenderRegister8("[ NR23 ]", sound.nr23, 0);
+				RenderRegister8("[ NR24 ]", sound.nr24, 2);
 
 				ImGui::EndTable();
 			}
@@ -541,9 +644,9 @@ namespace ModestGB
 			ImGui::Spacing();
 
 			// Channel 3
-			bool isChannel3Connected = apu.IsChannel3Connected();
-			ImGui::Checkbox("Channel 3", &isChannel3Connected);
-			apu.SetChannel3ConnectionStatus(isChannel3Connected);
+			bool isChannel3Connected = settings.channelConnectionStates[2];
+			if (ImGui::Checkbox("Channel 3", &isChannel3Connected))
+				settingChangedCallback({ .type = EmulatorCommandType::SetChannelConnected, .channelIndex = 2, .isEnabled = isChannel3Connected });
 			ImGui::Separator();
 
 			if (ImGui::BeginTable("##Channel 3 Registers", 6, ImGuiTableFlags_None | ImGuiTableFlags_SizingFixedFit))
@@ -556,13 +659,13 @@ namespace ModestGB
 				ImGui::TableSetupColumn("##Channel 3 Reg 3 Value", ImGuiTableColumnFlags_NoResize, valueColWidth);
 
 				ImGui::TableNextRow();
-				RenderRegister8("[ NR30 ]", apu.ReadNR30(), 0);
-				RenderRegister8("[ NR31 ]", apu.ReadNR31(), 2);
-				RenderRegister8("[ NR32 ]", apu.ReadNR32(), 4);
+				RenderRegister8("[ NR30 ]", sound.nr30, 0);
+				RenderRegister8("[ NR31 ]", sound.nr31, 2);
+				RenderRegister8("[ NR32 ]", sound.nr32, 4);
 
 				ImGui::TableNextRow();
-				RenderRegister8("[ NR33 ]", apu.ReadNR33(), 0);
-				RenderRegister8("[ NR34 ]", apu.ReadNR34(), 2);
+				RenderRegister8("[ NR33 ]", sound.nr33, 0);
+				RenderRegister8("[ NR34 ]", sound.nr34, 2);
 
 				ImGui::EndTable();
 			}
@@ -571,9 +674,9 @@ namespace ModestGB
 			ImGui::Spacing();
 
 			// Channel 4
-			bool isChannel4Connected = apu.IsChannel4Connected();
-			ImGui::Checkbox("Channel 4", &isChannel4Connected);
-			apu.SetChannel4ConnectionStatus(isChannel4Connected);
+			bool isChannel4Connected = settings.channelConnectionStates[3];
+			if (ImGui::Checkbox("Channel 4", &isChannel4Connected))
+				settingChangedCallback({ .type = EmulatorCommandType::SetChannelConnected, .channelIndex = 3, .isEnabled = isChannel4Connected });
 			ImGui::Separator();
 
 			if (ImGui::BeginTable("##Channel 4 Registers", 4, ImGuiTableFlags_None | ImGuiTableFlags_SizingFixedFit))
@@ -584,21 +687,132 @@ namespace ModestGB
 				ImGui::TableSetupColumn("##Channel 4 Reg 2 Value", ImGuiTableColumnFlags_NoResize, valueColWidth);
 
 				ImGui::TableNextRow();
-				RenderRegister8("[ NR41 ]", apu.ReadNR41(), 0);
-				RenderRegister8("[ NR42 ]", apu.ReadNR42(), 2);
+				RenderRegister8("[ NR41 ]", sound.nr41, 0);
+				RenderRegister8("[ NR42 ]", sound.nr42, 2);
 
 				ImGui::TableNextRow();
-				RenderRegister8("[ NR43 ]", apu.ReadNR43(), 0);
-				RenderRegister8("[ NR44 ]", apu.ReadNR44(), 2);
+				RenderRegister8("[ NR43 ]", sound.nr43, 0);
+				RenderRegister8("[ NR44 ]", sound.nr44, 2);
 
 				ImGui::EndTable();
 			}
+
+			ImGui::Spacing();
+			ImGui::Spacing();
+
+			RenderSoundOutputBuffer(sound.metrics);
+
+			ImGui::Spacing();
+			ImGui::Spacing();
+
+			RenderSoundOutput(apu);
 		}
 
 		EndWindow();
 	}
 
-	void EmulatorWindow::RenderJoypadDebugWindow(const Joypad& joypad)
+	void EmulatorWindow::RenderSoundOutputBuffer(const AudioMetrics& metrics)
+	{
+		ImGui::Text("Output Buffer");
+		ImGui::Separator();
+
+		float labelWidth = ImGui::GetFontSize() * 8.75f;
+		double samplesPerMillisecond = metrics.sampleRate * std::max<uint8_t>(metrics.channelCount, 1) / 1000.0;
+
+		ImGui::Text("Queued:");
+		ImGui::SameLine(labelWidth);
+		ImGui::Text("%.1f ms (target %.1f ms, max %.1f ms)", metrics.queuedSampleCount / samplesPerMillisecond, 
+			metrics.targetQueuedSampleCount / samplesPerMillisecond, metrics.maxQueuedSampleCount / samplesPerMillisecond);
+
+		ImGui::Text("Latency:");
+		ImGui::SameLine(labelWidth);
+		ImGui::Text("%.1f ms", metrics.latencyMilliseconds);
+
+		ImGui::Text("Rate Ratio:");
+		ImGui::SameLine(labelWidth);
+		ImGui::Text("%.4f", metrics.sampleRateRatio);
+
+		ImGui::Text("Underruns:");
+		ImGui::SameLine(labelWidth);
+		ImGui::Text("%llu", static_cast<unsigned long long>(metrics.underrunCount));
+
+		ImGui::Text("Dropped:");
+		ImGui::SameLine(labelWidth);
+		ImGui::Text("%llu samples", static_cast<unsigned long long>(metrics.droppedSampleCount));
+
+		ImGui::Text("Write Time:");
+		ImGui::SameLine(labelWidth);
+		ImGui::Text("%.1f us (max %.1f us, %llu writes)", metrics.lastWriteMicroseconds, metrics.maxWriteMicroseconds, static_cast<unsigned long long>(metrics.writtenBatchCount));
+
+		// The histograms are plotted relative to their largest bucket.
+		std::array<float, AUDIO_QUEUE_FILL_HISTOGRAM_SIZE> queueFillHistogram;
+		std::copy(metrics.queueFillHistogram.begin(), metrics.queueFillHistogram.end(), queueFillHistogram.begin());
+
+		std::array<float, AUDIO_WRITE_TIME_HISTOGRAM_SIZE> writeTimeHistogram;
+		std::copy(metrics.writeTimeHistogram.begin(), metrics.writeTimeHistogram.end(), writeTimeHistogram.begin());
+
+		float plotWidth = std::max(ImGui::GetContentRegionAvail().x - labelWidth, 1.0f);
+		float plotHeight = ImGui::GetFontSize() * 3.0f;
+
+		ImGui::Text("Queue Fill:");
+		ImGui::SameLine(labelWidth);
+		ImGui::PlotHistogram("##Sound Queue Fill Histogram", queueFillHistogram.data(), AUDIO_QUEUE_FILL_HISTOGRAM_SIZE, 0, "empty to max", 0.0f, FLT_MAX, ImVec2(plotWidth, plotHeight));
+
+		ImGui::Text("Write Times:");
+		ImGui::SameLine(labelWidth);
+		ImGui::PlotHistogram("##Sound Write Time Histogram", writeTimeHistogram.data(), AUDIO_WRITE_TIME_HISTOGRAM_SIZE, 0, "< 1 us to > 16 ms", 0.0f, FLT_MAX, ImVec2(plotWidth, plotHeight));
+	}
+
+	void EmulatorWindow::RenderSoundOutput(const APU& apu)
+	{
+		ImGui::Text("Output");
+		ImGui::Separator();
+
+		float labelWidth = ImGui::GetFontSize() * 5.5f;
+		float plotWidth = std::max(ImGui::GetContentRegionAvail().x - labelWidth, 1.0f);
+		float plotHeight = ImGui::GetFontSize() * 3.0f;
+
+		// Waveforms of the most recent samples, before the channels are mixed.
+		capturedSamples.resize(SOUND_WAVEFORM_SAMPLE_COUNT);
+		for (uint8_t i = 0; i < AUDIO_CAPTURE_SOURCE_COUNT; i++)
+		{
+			apu.ReadCapturedSamples(i, capturedSamples.data(), SOUND_WAVEFORM_SAMPLE_COUNT);
+
+			ImGui::Text("%s", AUDIO_CAPTURE_SOURCE_NAMES[i]);
+			ImGui::SameLine(labelWidth);
+			ImGui::PlotLines(("##Sound Waveform " + std::to_string(i)).c_str(), capturedSamples.data(), SOUND_WAVEFORM_SAMPLE_COUNT, 0, nullptr, -1.0f, 1.0f, ImVec2(plotWidth, plotHeight));
+		}
+
+		ImGui::Spacing();
+		ImGui::Spacing();
+
+		ImGui::Text("Spectrum");
+		ImGui::SameLine(labelWidth);
+		ImGui::SetNextItemWidth(plotWidth);
+		if (ImGui::BeginCombo("##Sound Spectrum Source", AUDIO_CAPTURE_SOURCE_NAMES[spectrumSource]))
+		{
+			for (uint8_t i = 0; i < AUDIO_CAPTURE_SOURCE_COUNT; i++)
+			{
+				bool isSelected = spectrumSource == i;
+
+				if (BeginSelectable(AUDIO_CAPTURE_SOURCE_NAMES[i], isSelected, ImGuiSelectableFlags_None))
+					spectrumSource = i;
+
+				EndSelectable(isSelected);
+			}
+
+			ImGui::EndCombo();
+		}
+
+		capturedSamples.resize(SOUND_SPECTRUM_SAMPLE_COUNT);
+		apu.ReadCapturedSamples(spectrumSource, capturedSamples.data(), SOUND_SPECTRUM_SAMPLE_COUNT);
+		FFT::ComputeMagnitudeSpectrum(capturedSamples, spectrum);
+
+		// Bins go from 0 Hz up to half the output sample rate (~22 kHz).
+		ImGui::PlotHistogram("##Sound Spectrum", spectrum.data(), static_cast<int>(spectrum.size()), 0, nullptr, SOUND_SPECTRUM_MIN_DB, 0.0f, ImVec2(ImGui::GetContentRegionAvail().x, plotHeight * 2));
+	}
+
+	void EmulatorWindow::RenderJoypadDebugWindow(const JoypadStateSnapshot& joypad)
 	{
 		// By default, force the window to be docked.
 		ImGui::SetNextWindowDockID(dockspaceID, ImGuiCond_FirstUseEver);
@@ -617,7 +831,7 @@ namespace ModestGB
 				ImGui::TableSetupColumn("##Joypad Reg Value", ImGuiTableColumnFlags_NoResize, valueColWidth);
 
 				ImGui::TableNextRow();
-				RenderRegister8("[ JOYP ]", joypad.Read(), 0);
+				RenderRegister8("[ JOYP ]", joypad.joypadRegister, 0);
 
 				ImGui::EndTable();
 			}
@@ -627,10 +841,10 @@ namespace ModestGB
 
 			ImGui::BeginDisabled();
 
-			bool isDownOrStartPressed = joypad.IsDownOrStartPressed();
-			bool isUpOrSelectPressed = joypad.IsUpOrSelectPressed();
-			bool isLeftOrBPressed = joypad.IsLeftOrBPressed();
-			bool isRightOrAPressed = joypad.IsRightOrAPressed();
+			bool isDownOrStartPressed = joypad.isDownOrStartPressed;
+			bool isUpOrSelectPressed = joypad.isUpOrSelectPressed;
+			bool isLeftOrBPressed = joypad.isLeftOrBPressed;
+			bool isRightOrAPressed = joypad.isRightOrAPressed;
 
 			ImGui::Checkbox(" Down/Start Pressed", &isDownOrStartPressed);
 			ImGui::Checkbox(" Up/Select Pressed", &isUpOrSelectPressed);
@@ -646,7 +860,7 @@ namespace ModestGB
 		EndWindow();
 	}
 
-	void EmulatorWindow::RenderVideoRegistersDebugWindow(const PPU& ppu)
+	void EmulatorWindow::RenderVideoRegistersDebugWindow(const VideoStateSnapshot& video)
 	{
 		// By default, force the window to be docked.
 		ImGui::SetNextWindowDockID(dockspaceID, ImGuiCond_FirstUseEver);
@@ -666,28 +880,28 @@ namespace ModestGB
 				ImGui::TableSetupColumn("##Video Reg Value", ImGuiTableColumnFlags_NoResize, valueColWidth);
 
 				ImGui::TableNextRow();
-				RenderRegister8("[ LCDC ]", ppu.ReadLCDC(), 0);
+				RenderRegister8("[ LCDC ]", video.lcdc, 0);
 
 				ImGui::TableNextRow();
-				RenderRegister8("[ LY ]", ppu.ReadLY(), 0);
+				RenderRegister8("[ LY ]", video.ly, 0);
 
 				ImGui::TableNextRow();
-				RenderRegister8("[ STAT ]", ppu.ReadLCDSTAT(), 0);
+				RenderRegister8("[ STAT ]", video.stat, 0);
 
 				ImGui::TableNextRow();
-				RenderRegister8("[ LYC ]", ppu.ReadLYC(), 0);
+				RenderRegister8("[ LYC ]", video.lyc, 0);
 
 				ImGui::TableNextRow();
-				RenderRegister8("[ SCY ]", ppu.ReadSCY(), 0);
+				RenderRegister8("[ SCY ]", video.scy, 0);
 
 				ImGui::TableNextRow();
-				RenderRegister8("[ SCX ]", ppu.ReadSCX(), 0);
+				RenderRegister8("[ SCX ]", video.scx, 0);
 
 				ImGui::TableNextRow();
-				RenderRegister8("[ WY ]", ppu.ReadWY(), 0);
+				RenderRegister8("[ WY ]", video.wy, 0);
 
 				ImGui::TableNextRow();
-				RenderRegister8("[ WX ]", ppu.ReadWX(), 0);
+				RenderRegister8("[ WX ]", video.wx, 0);
 
 				ImGui::EndTable();
 			}
@@ -734,7 +948,7 @@ namespace ModestGB
 		RenderWindowWithFramebuffer("Window Tile Map", ppu.GetWindowMapDebugFramebuffer(), &shouldRenderWindowTileMapDebugWindow);
 	}
 
-	void EmulatorWindow::RenderTimerDebugWindow(const Timer& timer)
+	void EmulatorWindow::RenderTimerDebugWindow(const TimerStateSnapshot& timer)
 	{
 		// By default, force the window to be docked.
 		ImGui::SetNextWindowDockID(dockspaceID, ImGuiCond_FirstUseEver);
@@ -753,16 +967,16 @@ namespace ModestGB
 				ImGui::TableSetupColumn("##Timer Register Value", ImGuiTableColumnFlags_NoResize, valueColWidth);
 
 				ImGui::TableNextRow();
-				RenderRegister8("[ DIV ]", timer.GetDividerRegister(), 0);
+				RenderRegister8("[ DIV ]", timer.dividerRegister, 0);
 
 				ImGui::TableNextRow();
-				RenderRegister8("[ TIMA ]", timer.GetTimerCounter(), 0);
+				RenderRegister8("[ TIMA ]", timer.timerCounter, 0);
 
 				ImGui::TableNextRow();
-				RenderRegister8("[ TMA ]", timer.GetTimerModulo(), 0);
+				RenderRegister8("[ TMA ]", timer.timerModulo, 0);
 
 				ImGui::TableNextRow();
-				RenderRegister8("[ TAC ]", timer.GetTimerControlRegister(), 0);
+				RenderRegister8("[ TAC ]", timer.timerControlRegister, 0);
 
 				ImGui::EndTable();
 			}
@@ -808,7 +1022,7 @@ namespace ModestGB
 		EndWindow();
 	}
 
-	void EmulatorWindow::RenderSettingsWindow(PPU& ppu, APU& apu, Joypad& joypad, InputManager& inputManager, Cartridge& cartridge)
+	void EmulatorWindow::RenderSettingsWindow(const SettingsSnapshot& settings, InputMapping& inputMapping, InputManager& inputManager)
 	{
 		// By default, force the window to be docked.
 		ImGui::SetNextWindowDockID(dockspaceID, ImGuiCond_FirstUseEver);
@@ -834,16 +1048,16 @@ namespace ModestGB
 				switch (selectedWindow)
 				{
 				case SETTINGS_VIDEO_WINDOW_ID:
-					RenderVideoSettingsWindow(ppu);
+					RenderVideoSettingsWindow(settings);
 					break;
 				case SETTINGS_AUDIO_WINDOW_ID:
-					RenderAudioSettingsWindow(apu);
+					RenderAudioSettingsWindow(settings);
 					break;
 				case SETTINGS_CONTROLLER_AND_KEYBOARD_WINDOW_ID:
-					RenderControllerAndKeyboardSettingsWindow(joypad, inputManager);
+					RenderControllerAndKeyboardSettingsWindow(inputMapping, inputManager);
 					break;
 				case SETTINGS_SAVED_DATA_WINDOW_ID:
-					RenderSavedDataSettingsWindow(cartridge);
+					RenderSavedDataSettingsWindow(settings);
 					break;
 				}
 			}
@@ -864,7 +1078,7 @@ namespace ModestGB
 		EndSelectable(isSelected);
 	}
 
-	void EmulatorWindow::RenderVideoSettingsWindow(PPU& ppu)
+	void EmulatorWindow::RenderVideoSettingsWindow(const SettingsSnapshot& settings)
 	{
 		static bool isPaletteTintEditorOpen = false;
 		static uint8_t selectedPaletteTintID = BACKGROUND_AND_WINDOW_PALETTE_TINT_ID_0;
@@ -882,38 +1096,73 @@ namespace ModestGB
 			ImGui::Spacing();
 			ImGui::Spacing();
 
+			// Without vsync, the window is refreshed at the emulated display's frame rate.
+			bool isVSyncChecked = isVSyncEnabled;
+			ImGui::Text("VSync:");
+			ImGui::SameLine();
+			if (ImGui::Checkbox("##Video Settings VSync", &isVSyncChecked))
+				SetVSyncEnabled(isVSyncChecked);
+
+			// Without rendering, the game view keeps showing the last frame that was drawn.
+			bool isRenderingChecked = settings.isRenderingEnabled;
+			ImGui::Text("Render Frames:");
+			ImGui::SameLine();
+			if (ImGui::Checkbox("##Video Settings Render Frames", &isRenderingChecked))
+				settingChangedCallback({ .type = EmulatorCommandType::SetRenderingEnabled, .isEnabled = isRenderingChecked });
+
+			// Skipping frames only saves the time spent drawing them, the emulation still runs at full speed.
+			int framesToSkip = static_cast<int>(settings.framesToSkip);
+			int frameSkipInterval = static_cast<int>(settings.frameSkipInterval);
+			float frameSkipItemWidth = ImGui::GetFontSize() * 7.5f;
+			ImGui::Text("Frame Skip:");
+			ImGui::SameLine();
+			ImGui::SetNextItemWidth(frameSkipItemWidth);
+			bool isFrameSkipChanged = ImGui::SliderInt("##Video Settings Frames Skipped", &framesToSkip, 0, MAX_FRAME_SKIP_INTERVAL - 1, "Skip %d");
+			ImGui::SameLine();
+			ImGui::SetNextItemWidth(frameSkipItemWidth);
+			isFrameSkipChanged |= ImGui::SliderInt("##Video Settings Frame Skip Interval", &frameSkipInterval, 1, MAX_FRAME_SKIP_INTERVAL, "Of every %d");
+
+			if (isFrameSkipChanged)
+			{
+				framesToSkip = std::min(framesToSkip, frameSkipInterval - 1);
+				settingChangedCallback({ .type = EmulatorCommandType::SetFrameSkip, .framesToSkip = static_cast<uint32_t>(framesToSkip), .frameSkipInterval = static_cast<uint32_t>(frameSkipInterval) });
+			}
+
+			ImGui::Spacing();
+			ImGui::Spacing();
+
 			ImGui::Text("Palette Tints");
 			ImGui::Separator();
 
 			ImGui::Text("Background (BGP):");
 			ImGui::SameLine();
-			RenderColorPaletteButton(ppu, "BGP 0", GB_BACKGROUND_PALETTE_ADDRESS, 0, paletteAddress, colorIndex, selectedTintLabel, isPaletteTintEditorOpen);
+			RenderColorPaletteButton(settings, "BGP 0", GB_BACKGROUND_PALETTE_ADDRESS, 0, paletteAddress, colorIndex, selectedTintLabel, isPaletteTintEditorOpen);
 			ImGui::SameLine();
-			RenderColorPaletteButton(ppu, "BGP 1", GB_BACKGROUND_PALETTE_ADDRESS, 1, paletteAddress, colorIndex, selectedTintLabel, isPaletteTintEditorOpen);
+			RenderColorPaletteButton(settings, "BGP 1", GB_BACKGROUND_PALETTE_ADDRESS, 1, paletteAddress, colorIndex, selectedTintLabel, isPaletteTintEditorOpen);
 			ImGui::SameLine();
-			RenderColorPaletteButton(ppu, "BGP 2", GB_BACKGROUND_PALETTE_ADDRESS, 2, paletteAddress, colorIndex, selectedTintLabel, isPaletteTintEditorOpen);
+			RenderColorPaletteButton(settings, "BGP 2", GB_BACKGROUND_PALETTE_ADDRESS, 2, paletteAddress, colorIndex, selectedTintLabel, isPaletteTintEditorOpen);
 			ImGui::SameLine();
-			RenderColorPaletteButton(ppu, "BGP 3", GB_BACKGROUND_PALETTE_ADDRESS, 3, paletteAddress, colorIndex, selectedTintLabel, isPaletteTintEditorOpen);
+			RenderColorPaletteButton(settings, "BGP 3", GB_BACKGROUND_PALETTE_ADDRESS, 3, paletteAddress, colorIndex, selectedTintLabel, isPaletteTintEditorOpen);
 
 			ImGui::Text("Sprite 0 (OBP0):");
 			ImGui::SameLine();
-			RenderColorPaletteButton(ppu, "OBP0 0", GB_SPRITE_PALETTE_0_ADDRESS, 0, paletteAddress, colorIndex, selectedTintLabel, isPaletteTintEditorOpen);
+			RenderColorPaletteButton(settings, "OBP0 0", GB_SPRITE_PALETTE_0_ADDRESS, 0, paletteAddress, colorIndex, selectedTintLabel, isPaletteTintEditorOpen);
 			ImGui::SameLine();
-			RenderColorPaletteButton(ppu, "OBP0 1", GB_SPRITE_PALETTE_0_ADDRESS, 1, paletteAddress, colorIndex, selectedTintLabel, isPaletteTintEditorOpen);
+			RenderColorPaletteButton(settings, "OBP0 1", GB_SPRITE_PALETTE_0_ADDRESS, 1, paletteAddress, colorIndex, selectedTintLabel, isPaletteTintEditorOpen);
 			ImGui::SameLine();
-			RenderColorPaletteButton(ppu, "OBP0 2", GB_SPRITE_PALETTE_0_ADDRESS, 2, paletteAddress, colorIndex, selectedTintLabel, isPaletteTintEditorOpen);
+			RenderColorPaletteButton(settings, "OBP0 2", GB_SPRITE_PALETTE_0_ADDRESS, 2, paletteAddress, colorIndex, selectedTintLabel, isPaletteTintEditorOpen);
 			ImGui::SameLine();
-			RenderColorPaletteButton(ppu, "OBP0 3", GB_SPRITE_PALETTE_0_ADDRESS, 3, paletteAddress, colorIndex, selectedTintLabel, isPaletteTintEditorOpen);
+			RenderColorPaletteButton(settings, "OBP0 3", GB_SPRITE_PALETTE_0_ADDRESS, 3, paletteAddress, colorIndex, selectedTintLabel, isPaletteTintEditorOpen);
 
 			ImGui::Text("Sprite 1 (OBP1):");
 			ImGui::SameLine();
-			RenderColorPaletteButton(ppu, "OBP1 0", GB_SPRITE_PALETTE_1_ADDRESS, 0, paletteAddress, colorIndex, selectedTintLabel, isPaletteTintEditorOpen);
+			RenderColorPaletteButton(settings, "OBP1 0", GB_SPRITE_PALETTE_1_ADDRESS, 0, paletteAddress, colorIndex, selectedTintLabel, isPaletteTintEditorOpen);
 			ImGui::SameLine();
-			RenderColorPaletteButton(ppu, "OBP1 1", GB_SPRITE_PALETTE_1_ADDRESS, 1, paletteAddress, colorIndex, selectedTintLabel, isPaletteTintEditorOpen);
+			RenderColorPaletteButton(settings, "OBP1 1", GB_SPRITE_PALETTE_1_ADDRESS, 1, paletteAddress, colorIndex, selectedTintLabel, isPaletteTintEditorOpen);
 			ImGui::SameLine();
-			RenderColorPaletteButton(ppu, "OBP1 2", GB_SPRITE_PALETTE_1_ADDRESS, 2, paletteAddress, colorIndex, selectedTintLabel, isPaletteTintEditorOpen);
+			RenderColorPaletteButton(settings, "OBP1 2", GB_SPRITE_PALETTE_1_ADDRESS, 2, paletteAddress, colorIndex, selectedTintLabel, isPaletteTintEditorOpen);
 			ImGui::SameLine();
-			RenderColorPaletteButton(ppu, "OBP1 3", GB_SPRITE_PALETTE_1_ADDRESS, 3, paletteAddress, colorIndex, selectedTintLabel, isPaletteTintEditorOpen);
+			RenderColorPaletteButton(settings, "OBP1 3", GB_SPRITE_PALETTE_1_ADDRESS, 3, paletteAddress, colorIndex, selectedTintLabel, isPaletteTintEditorOpen);
 		}
 
 		ImGui::EndChild();
@@ -925,21 +1174,21 @@ namespace ModestGB
 			ImGui::SetNextWindowSize(ImVec2(size, size));
 			if (BeginWindow("Palette Editor", &isPaletteTintEditorOpen, ImGuiWindowFlags_NoDocking | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoCollapse))
 			{
-				Color rawTint = ppu.GetPaletteTint(paletteAddress, colorIndex);
+				Color rawTint = GetPaletteTint(settings, paletteAddress, colorIndex);
 				ImVec4 tint = ConvertColorToImVec4(rawTint);
-				ImGui::ColorPicker3(selectedTintLabel.c_str(), &tint.x);
-				ppu.SetPaletteTint(paletteAddress, colorIndex, ConvertImVec4ToColor(tint));
+				if (ImGui::ColorPicker3(selectedTintLabel.c_str(), &tint.x))
+					settingChangedCallback({ .type = EmulatorCommandType::SetPaletteTint, .paletteAddress = paletteAddress, .colorIndex = colorIndex, .color = ConvertImVec4ToColor(tint) });
 			}
 
 			EndWindow();
 		}
 	}
 
-	void EmulatorWindow::RenderColorPaletteButton(PPU& ppu, const std::string& label, uint16_t paletteAddress, uint8_t colorIndex, uint16_t& outPaletteAddress, uint8_t& outColorIndex, std::string& outLabel, bool& isColorPickerOpened)
+	void EmulatorWindow::RenderColorPaletteButton(const SettingsSnapshot& settings, const std::string& label, uint16_t paletteAddress, uint8_t colorIndex, uint16_t& outPaletteAddress, uint8_t& outColorIndex, std::string& outLabel, bool& isColorPickerOpened)
 	{
 		float initialOffset = ImGui::GetFontSize() * 8.2f;
 		ImGui::SetCursorPosX(initialOffset + (ImGui::GetFontSize() * 1.85f) * (colorIndex + 1));
-		Color rawTint = ppu.GetPaletteTint(paletteAddress, colorIndex);
+		Color rawTint = GetPaletteTint(settings, paletteAddress, colorIndex);
 		if (ImGui::ColorButton(label.c_str(), ConvertColorToImVec4(rawTint), ImGuiColorEditFlags_PickerHueWheel))
 		{
 			isColorPickerOpened = true;
@@ -949,7 +1198,7 @@ namespace ModestGB
 		}
 	}
 
-	void EmulatorWindow::RenderAudioSettingsWindow(APU& apu)
+	void EmulatorWindow::RenderAudioSettingsWindow(const SettingsSnapshot& settings)
 	{
 		ImGui::BeginGroup();
 
@@ -960,8 +1209,8 @@ namespace ModestGB
 			ImGui::Spacing();
 			ImGui::Spacing();
 
-			const std::vector<std::string>& outputDeviceNames = apu.GetAllOutputDeviceNames();
-			const std::string& selectedOutputDevice = apu.GetCurrentOutputDeviceName();
+			const std::vector<std::string>& outputDeviceNames = settings.outputDeviceNames;
+			const std::string& selectedOutputDevice = settings.currentOutputDeviceName;
 
 			float itemOffset = ImGui::GetFontSize() * 8.75f;
 
@@ -979,7 +1228,7 @@ namespace ModestGB
 
 					// If the selectable is pressed, then set the selected device as the APU's output device.
 					if (BeginSelectable(name.c_str(), isSelected, ImGuiSelectableFlags_None))
-						apu.SetOutputDevice(name);
+						settingChangedCallback({ .type = EmulatorCommandType::SetOutputDevice, .audioDeviceName = name });
 
 					EndSelectable(isSelected);
 				}
@@ -988,26 +1237,26 @@ namespace ModestGB
 			}
 
 			// Render volume slider.
-			float volume = apu.GetMasterVolume() * MAX_VOLUME;
+			float volume = settings.masterVolume * MAX_VOLUME;
 			ImGui::Text("Volume:       ");
 			ImGui::SameLine(itemOffset);
 			ImGui::SetNextItemWidth(std::max(ImGui::GetContentRegionAvail().x, minItemWidth));
-			ImGui::SliderFloat("##Audio Settings Volume ", &volume, 0.0f, MAX_VOLUME, "%.0f", ImGuiSliderFlags_None);
-			apu.SetMasterVolume(volume / MAX_VOLUME);
+			if (ImGui::SliderFloat("##Audio Settings Volume ", &volume, 0.0f, MAX_VOLUME, "%.0f", ImGuiSliderFlags_None))
+				settingChangedCallback({ .type = EmulatorCommandType::SetMasterVolume, .volume = volume / MAX_VOLUME });
 
 			// Render mute button.
-			bool isMuted = apu.IsMuted();
+			bool isMuted = settings.isMuted;
 			ImGui::Text("Mute:         ");
 			ImGui::SameLine(itemOffset);
-			ImGui::Checkbox("##Audio Settings Mute", &isMuted);
-			apu.Mute(isMuted);
+			if (ImGui::Checkbox("##Audio Settings Mute", &isMuted))
+				settingChangedCallback({ .type = EmulatorCommandType::SetMuted, .isEnabled = isMuted });
 		}
 
 		ImGui::EndChild();
 		ImGui::EndGroup();
 	}
 
-	void EmulatorWindow::RenderControllerAndKeyboardSettingsWindow(Joypad& joypad, InputManager& inputManager)
+	void EmulatorWindow::RenderControllerAndKeyboardSettingsWindow(InputMapping& inputMapping, InputManager& inputManager)
 	{
 		ImGui::BeginGroup();
 
@@ -1093,10 +1342,10 @@ namespace ModestGB
 							ImGui::Text((" " + GBBUTTON_STRINGS.at(static_cast<GBButton>(r))).c_str());
 							break;
 						case 1:
-							RenderControllerButtonComboBox(joypad, gbButton, r, comboBoxWidth);
+							RenderControllerButtonComboBox(inputMapping, gbButton, r, comboBoxWidth);
 							break;
 						case 2:
-							RenderKeyCodeComboBox(joypad, gbButton, r, comboBoxWidth);
+							RenderKeyCodeComboBox(inputMapping, gbButton, r, comboBoxWidth);
 							break;
 						}
 					}
@@ -1117,9 +1366,9 @@ namespace ModestGB
 		ImGui::EndGroup();
 	}
 
-	void EmulatorWindow::RenderControllerButtonComboBox(Joypad& joypad, GBButton gbButton, int row, float width)
+	void EmulatorWindow::RenderControllerButtonComboBox(InputMapping& inputMapping, GBButton gbButton, int row, float width)
 	{
-		ControllerButtonCode selectedButton = joypad.GetControllerButtonCode(gbButton);
+		ControllerButtonCode selectedButton = inputMapping.GetControllerButtonCode(gbButton);
 		ImGui::SetNextItemWidth(width);
 
 		if (ImGui::BeginCombo(("##Controller Button" + std::to_string(row)).c_str(), CONTROLLER_BUTTON_STRINGS.at(selectedButton).c_str()))
@@ -1127,7 +1376,7 @@ namespace ModestGB
 			for (const std::pair<ControllerButtonCode, std::string>& pair : CONTROLLER_BUTTON_STRINGS)
 			{
 				if (BeginSelectable(pair.second.c_str(), selectedButton == pair.first))
-					joypad.SetControllerButtonCode(gbButton, pair.first);
+					inputMapping.SetControllerButtonCode(gbButton, pair.first);
 
 				EndSelectable(selectedButton == pair.first);
 			}
@@ -1136,9 +1385,9 @@ namespace ModestGB
 		}
 	}
 
-	void EmulatorWindow::RenderKeyCodeComboBox(Joypad& joypad, GBButton gbButton, int row, float width)
+	void EmulatorWindow::RenderKeyCodeComboBox(InputMapping& inputMapping, GBButton gbButton, int row, float width)
 	{
-		KeyCode selectedKey = joypad.GetKeyCode(gbButton);
+		KeyCode selectedKey = inputMapping.GetKeyCode(gbButton);
 		ImGui::SetNextItemWidth(width);
 
 		if (ImGui::BeginCombo(("##Key Code" + std::to_string(row)).c_str(), KEYCODE_STRINGS.at(selectedKey).c_str()))
@@ -1146,7 +1395,7 @@ namespace ModestGB
 			for (const std::pair<KeyCode, std::string>& pair : KEYCODE_STRINGS)
 			{
 				if (BeginSelectable(pair.second.c_str(), selectedKey == pair.first))
-					joypad.SetKeyCode(gbButton, pair.first);
+					inputMapping.SetKeyCode(gbButton, pair.first);
 
 				EndSelectable(selectedKey == pair.first);
 			}
@@ -1155,7 +1404,7 @@ namespace ModestGB
 		}
 	}
 
-	void EmulatorWindow::RenderSavedDataSettingsWindow(Cartridge& cartridge)
+	void EmulatorWindow::RenderSavedDataSettingsWindow(const SettingsSnapshot& settings)
 	{
 		ImGui::BeginGroup();
 
@@ -1166,7 +1415,7 @@ namespace ModestGB
 			ImGui::Spacing();
 			ImGui::Spacing();
 
-			SavedDataSearchType currentSavedDataSearchType = cartridge.GetSavedDataSearchType();
+			SavedDataSearchType currentSavedDataSearchType = settings.savedDataSearchType;
 
 			ImGui::Text("Saved Data Location: ");
 			ImGui::SameLine(ImGui::GetFontSize() * 8.75f);
@@ -1182,7 +1431,7 @@ namespace ModestGB
 						currentSavedDataSearchType = pair.first;
 
 						// Update the cartridge's saved data search type.
-						cartridge.SetSavedDataSearchType(currentSavedDataSearchType);
+						settingChangedCallback({ .type = EmulatorCommandType::SetSavedDataSearchType, .savedDataSearchType = currentSavedDataSearchType });
 					}
 
 					EndSelectable(isSelected);
@@ -1190,6 +1439,17 @@ namespace ModestGB
 
 				ImGui::EndCombo();
 			}
+
+			ImGui::Spacing();
+
+			// Only applies to the next ROM that is loaded.
+			bool isRTCWallClockCatchUpEnabled = settings.isRTCWallClockCatchUpEnabled;
+			if (ImGui::Checkbox("Advance Real-Time Clock While Closed", &isRTCWallClockCatchUpEnabled))
+				settingChangedCallback({ .type = EmulatorCommandType::SetRTCWallClockCatchUpEnabled, .isEnabled = isRTCWallClockCatchUpEnabled });
+
+			bool isGlobalChecksumVerificationEnabled = settings.isGlobalChecksumVerificationEnabled;
+			if (ImGui::Checkbox("Verify ROM Global Checksum", &isGlobalChecksumVerificationEnabled))
+				settingChangedCallback({ .type = EmulatorCommandType::SetGlobalChecksumVerificationEnabled, .isEnabled = isGlobalChecksumVerificationEnabled });
 		}
 
 		ImGui::EndChild();
@@ -1353,6 +1613,24 @@ namespace ModestGB
 		pauseButtonLabel = label;
 	}
 
+	bool EmulatorWindow::IsRewindButtonHeld() const
+	{
+		return isRewindButtonHeld;
+	}
+
+	Color EmulatorWindow::GetPaletteTint(const SettingsSnapshot& settings, uint16_t paletteAddress, uint8_t colorIndex) const
+	{
+		switch (paletteAddress)
+		{
+		case GB_SPRITE_PALETTE_0_ADDRESS:
+			return settings.spritePalette0Tints[colorIndex];
+		case GB_SPRITE_PALETTE_1_ADDRESS:
+			return settings.spritePalette1Tints[colorIndex];
+		default:
+			return settings.backgroundPaletteTints[colorIndex];
+		}
+	}
+
 	ImVec4 EmulatorWindow::ConvertColorToImVec4(Color& color) const
 	{
 		float r = color.r / 255.0f;
@@ -0,0 +1,59 @@
+#include <thread>
+#include "FramePacer.hpp"
+
+namespace ModestGB
+{
+	// The OS scheduler can wake a sleeping thread late, so the sleep ends a bit before the deadline 
+	// and the rest of the time is spent yielding. SDL raises the Windows timer resolution to 1ms on 
+	// initialization, so half a millisecond covers the usual wake-up delay. The yield loop keeps a 
+	// core busy, so a wider margin costs CPU time on every frame for little gain in precision.
+	const std::chrono::steady_clock::duration SLEEP_MARGIN = std::chrono::microseconds(500);
+
+	// If the loop falls this far behind (e.g. the window was being dragged), don't try to catch up 
+	// by running frames back to back, just start counting from now.
+	const uint64_t MAX_FRAMES_BEHIND = 4;
+
+	FramePacer::FramePacer(double framesPerSecond)
+	{
+		SetFrameRate(framesPerSecond);
+	}
+
+	void FramePacer::Reset()
+	{
+		startTime = std::chrono::steady_clock::now();
+		frameCount = 0;
+	}
+
+	void FramePacer::SetFrameRate(double framesPerSecond)
+	{
+		secondsPerFrame = 1.0 / framesPerSecond;
+		Reset();
+	}
+
+	void FramePacer::WaitForNextFrame()
+	{
+		frameCount++;
+
+		std::chrono::steady_clock::time_point deadline = GetFrameDeadline(frameCount);
+		std::chrono::steady_clock::time_point currentTime = std::chrono::steady_clock::now();
+
+		if (currentTime >= deadline)
+		{
+			if (currentTime >= GetFrameDeadline(frameCount + MAX_FRAMES_BEHIND))
+				Reset();
+
+			return;
+		}
+
+		if (deadline - currentTime > SLEEP_MARGIN)
+			std::this_thread::sleep_until(deadline - SLEEP_MARGIN);
+
+		while (std::chrono::steady_clock::now() < deadline)
+			std::this_thread::yield();
+	}
+
+	std::chrono::steady_clock::time_point FramePacer::GetFrameDeadline(uint64_t frame) const
+	{
+		return startTime + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(frame * secondsPerFrame));
+	}
+}
\ No newline at end of file
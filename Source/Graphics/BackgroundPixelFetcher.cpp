@@ -76,13 +76,13 @@ namespace ModestGB
 			tileX = static_cast<uint8_t>(std::floor((scx->Read() + x) / static_cast<float>(TILE_WIDTH_IN_PIXELS))) & 0x1F;
 			tileY = static_cast<uint8_t>(std::floor((GetAdjustedY() & 255) / static_cast<float>(TILE_HEIGHT_IN_PIXELS)));
 
-			currentTileIndex = static_cast<uint8_t>(GetTileIndexFromTileMaps(vram, tileX, tileY, lcdc->Read(LCDC_BG_TILE_MAP_AREA_BIT_INDEX)));
+			currentTileIndex = static_cast<uint8_t>(GetTileIndexFromTileMaps(vram, tileX, tileY, lcdc->Read(LCDC_BG_TILE_MAP_AREA)));
 			break;
 		case BackgroundPixelFetcherMode::Window:
 			tileX = static_cast<uint8_t>(std::floor(x / static_cast<float>(TILE_WIDTH_IN_PIXELS)));
 			tileY = static_cast<uint8_t>(std::floor(y / static_cast<float>(TILE_HEIGHT_IN_PIXELS)));
 
-			currentTileIndex = static_cast<uint8_t>(GetTileIndexFromTileMaps(vram, tileX, tileY, lcdc->Read(LCDC_WINDOW_TILE_MAP_AREA_BIT_INDEX)));
+			currentTileIndex = static_cast<uint8_t>(GetTileIndexFromTileMaps(vram, tileX, tileY, lcdc->Read(LCDC_WINDOW_TILE_MAP_AREA)));
 			break;
 		}
 
@@ -95,7 +95,7 @@ namespace ModestGB
 		if (currentStateElapsedCycles < TILE_DATA_FETCH_DURATION_IN_CYCLES)
 			return;
 
-		currentLowTileData = NormalizedReadFromVRAM(vram, GetTileAddress(currentTileIndex, GetAdjustedY() , lcdc->Read(LCDC_BG_WINDOW_ADDRESSING_MODE_BIT_INDEX)));
+		currentLowTileData = NormalizedReadFromVRAM(vram, GetTileAddress(currentTileIndex, GetAdjustedY() , lcdc->Read(LCDC_BG_WINDOW_ADDRESSING_MODE)));
 
 		currentState = BackgroundPixelFetcherState::FetchingHighTileData;
 		currentStateElapsedCycles = 0;
@@ -106,7 +106,7 @@ namespace ModestGB
 		if (currentStateElapsedCycles < TILE_DATA_FETCH_DURATION_IN_CYCLES)
 			return;
 
-		currentHighTileData = NormalizedReadFromVRAM(vram, GetTileAddress(currentTileIndex, GetAdjustedY(), lcdc->Read(LCDC_BG_WINDOW_ADDRESSING_MODE_BIT_INDEX)) + 1);
+		currentHighTileData = NormalizedReadFromVRAM(vram, GetTileAddress(currentTileIndex, GetAdjustedY(), lcdc->Read(LCDC_BG_WINDOW_ADDRESSING_MODE)) + 1);
 
 		currentState = BackgroundPixelFetcherState::Sleeping;
 		currentStateElapsedCycles = 0;
@@ -148,4 +148,28 @@ namespace ModestGB
 	{
 		return currentMode == BackgroundPixelFetcherMode::Background ? y + scy->Read() : y;
 	}
+
+	void BackgroundPixelFetcher::Serialize(StateWriter& writer) const
+	{
+		PixelFetcher::Serialize(writer);
+
+		writer.Write(currentState);
+		writer.Write(currentMode);
+		writer.Write(currentStateElapsedCycles);
+		writer.Write(currentTileIndex);
+		writer.Write(currentLowTileData);
+		writer.Write(currentHighTileData);
+	}
+
+	void BackgroundPixelFetcher::Deserialize(StateReader& reader)
+	{
+		PixelFetcher::Deserialize(reader);
+
+		reader.Read(currentState);
+		reader.Read(currentMode);
+		reader.Read(currentStateElapsedCycles);
+		reader.Read(currentTileIndex);
+		reader.Read(currentLowTileData);
+		reader.Read(currentHighTileData);
+	}
 }
\ No newline at end of file
@@ -42,4 +42,20 @@ namespace ModestGB
 		sourceTransferStartAddress = 0;
 		sourceTransferEndAddress = 0;
 	}
+
+	void DMATransferRegister::Serialize(StateWriter& writer) const
+	{
+		writer.Write(isTransferPending);
+		writer.Write(data);
+		writer.Write(sourceTransferStartAddress);
+		writer.Write(sourceTransferEndAddress);
+	}
+
+	void DMATransferRegister::Deserialize(StateReader& reader)
+	{
+		reader.Read(isTransferPending);
+		reader.Read(data);
+		reader.Read(sourceTransferStartAddress);
+		reader.Read(sourceTransferEndAddress);
+	}
 }
\ No newline at end of file
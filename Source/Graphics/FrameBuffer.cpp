@@ -3,6 +3,9 @@
 
 namespace ModestGB
 {
+	const uint8_t PUBLISHED_BUFFER_INDEX_MASK = 0b11;
+	const uint8_t NEW_FRAME_FLAG = 0b100;
+
 	Framebuffer::Framebuffer() {}
 
 	Framebuffer::Framebuffer(SDL_Window* window, uint16_t width, uint16_t height)
@@ -17,12 +20,31 @@ namespace ModestGB
 		aspectRatio = width / (float)height;
 		pixelFormat = SDL_AllocFormat(SDL_GetWindowPixelFormat(window));
 		texture = SDL_CreateTexture(SDL_GetRenderer(window), SDL_PIXELFORMAT_BGRA32, SDL_TEXTUREACCESS_STREAMING, width, height);
-		pixels = std::vector<uint32_t>(width * height);
+
+		for (std::vector<uint32_t>& buffer : buffers)
+			buffer = std::vector<uint32_t>(width * height);
+
+		backBufferIndex = 0;
+		frontBufferIndex = 1;
+		publishedBufferState = 2;
 	}
 
+	void Framebuffer::Publish()
+	{
+		// Swap the back buffer with the published one. Whatever buffer was published before is either 
+		// stale (it was never uploaded) or already uploaded, so it can be reused as the new back buffer.
+		backBufferIndex = publishedBufferState.exchange(backBufferIndex | NEW_FRAME_FLAG, std::memory_order_acq_rel) & PUBLISHED_BUFFER_INDEX_MASK;
+	}
 
 	void Framebuffer::UploadData()
 	{
+		if ((publishedBufferState.load(std::memory_order_acquire) & NEW_FRAME_FLAG) == 0)
+			return;
+
+		// Take ownership of the latest frame, and give the previous front buffer back to the emulation.
+		frontBufferIndex = publishedBufferState.exchange(frontBufferIndex, std::memory_order_acq_rel) & PUBLISHED_BUFFER_INDEX_MASK;
+		const std::vector<uint32_t>& pixels = buffers[frontBufferIndex];
+
 		void* lockedPixels;
 		int pitch;
 
@@ -35,7 +57,8 @@ namespace ModestGB
 
 	void Framebuffer::Clear(const Color& color)
 	{
-		std::memset(pixels.data(), SDL_MapRGBA(pixelFormat, color.r, color.g, color.b, color.a), sizeof(uint32_t) * pixels.size());
+		std::vector<uint32_t>& pixels = buffers[backBufferIndex];
+		std::fill(pixels.begin(), pixels.end(), SDL_MapRGBA(pixelFormat, color.r, color.g, color.b, color.a));
 	}
 
 	void Framebuffer::Destroy()
@@ -52,14 +75,14 @@ namespace ModestGB
 	Color Framebuffer::GetPixel(uint16_t x, uint16_t y)
 	{
 		Color color;
-		SDL_GetRGBA(pixels[x + y * width], pixelFormat, &color.r, &color.g, &color.b, &color.a);
+		SDL_GetRGBA(buffers[backBufferIndex][x + y * width], pixelFormat, &color.r, &color.g, &color.b, &color.a);
 
 		return color;
 	}
 
 	void Framebuffer::SetPixel(uint16_t x, uint16_t y, const Color& color)
 	{
-		pixels[x + y * width] = SDL_MapRGBA(pixelFormat, color.r, color.g, color.b, color.a);
+		buffers[backBufferIndex][x + y * width] = SDL_MapRGBA(pixelFormat, color.r, color.g, color.b, color.a);
 	}
 
 	uint16_t Framebuffer::GetWidth() const
@@ -34,11 +34,11 @@ namespace ModestGB
 
 	void PPU::InitializeFramebuffer(SDL_Window* window)
 	{
-		primaryFramebuffer = Framebuffer(window, GB_SCREEN_WIDTH, GB_SCREEN_HEIGHT);
-		backgroundDebugFramebuffer = Framebuffer(window, TILE_MAP_WIDTH_IN_PIXELS, TILE_MAP_HEIGHT_IN_PIXELS);
-		windowDebugFramebuffer = Framebuffer(window, TILE_MAP_WIDTH_IN_PIXELS, TILE_MAP_HEIGHT_IN_PIXELS);
-		spriteDebugFramebuffer = Framebuffer(window, SPRITE_DEBUG_FRAMEBUFFER_WIDTH, SPRITE_DEBUG_FRAMEBUFFER_HEIGHT);
-		tileDebugFramebuffer = Framebuffer(window, TILE_DEBUG_FRAMEBUFFER_WIDTH_IN_PIXELS, TILE_DEBUG_FRAMEBUFFER_HEIGHT_IN_PIXELS);
+		primaryFramebuffer.Initialize(window, GB_SCREEN_WIDTH, GB_SCREEN_HEIGHT);
+		backgroundDebugFramebuffer.Initialize(window, TILE_MAP_WIDTH_IN_PIXELS, TILE_MAP_HEIGHT_IN_PIXELS);
+		windowDebugFramebuffer.Initialize(window, TILE_MAP_WIDTH_IN_PIXELS, TILE_MAP_HEIGHT_IN_PIXELS);
+		spriteDebugFramebuffer.Initialize(window, SPRITE_DEBUG_FRAMEBUFFER_WIDTH, SPRITE_DEBUG_FRAMEBUFFER_HEIGHT);
+		tileDebugFramebuffer.Initialize(window, TILE_DEBUG_FRAMEBUFFER_WIDTH_IN_PIXELS, TILE_DEBUG_FRAMEBUFFER_HEIGHT_IN_PIXELS);
 	}
 
 	void PPU::Reset()
@@ -50,18 +50,24 @@ namespace ModestGB
 		spritesOnCurrentScanline.clear();
 
 		dmaRegister.ClearPendingTransfer();
+		currentDMATransferState = DMATransferState::Idle;
+		currentDMATransferElapsedTime = 0;
+
+		frameSkipCounter = 0;
+		isFrameSkipRestartPending = false;
+		isCurrentFrameRendered = isRenderingEnabled && framesToSkip == 0;
 
 		primaryFramebuffer.Clear();
-		primaryFramebuffer.UploadData();
+		primaryFramebuffer.Publish();
 
 		backgroundDebugFramebuffer.Clear();
-		backgroundDebugFramebuffer.UploadData();
+		backgroundDebugFramebuffer.Publish();
 
 		spriteDebugFramebuffer.Clear(RGBA_BLACK);
-		spriteDebugFramebuffer.UploadData();
+		spriteDebugFramebuffer.Publish();
 
 		tileDebugFramebuffer.Clear(RGBA_BLACK);
-		tileDebugFramebuffer.UploadData();
+		tileDebugFramebuffer.Publish();
 	}
 
 	void PPU::WriteLCDC(uint8_t value)
@@ -109,11 +115,25 @@ namespace ModestGB
 		dmaRegister.Write(value);
 	}
 
+	void PPU::WriteBGP(uint8_t value)
+	{
+		bgp.Write(value);
+	}
+
+	void PPU::WriteOBP0(uint8_t value)
+	{
+		obp0.Write(value);
+	}
+
+	void PPU::WriteOBP1(uint8_t value)
+	{
+		obp1.Write(value);
+	}
+
 	void PPU::WriteToVRAM(uint16_t address, uint8_t value)
 	{
-		// VRAM access is blocked in mode 3, and during DMA transfer.
-		if (currentMode == Mode::LCDTransfer ||
-			currentDMATransferState == DMATransferState::InProgress)
+		// VRAM access is blocked in mode 3.
+		if (currentMode == Mode::LCDTransfer)
 			return;
 
 		vram.Write(address, value);
@@ -121,10 +141,9 @@ namespace ModestGB
 
 	void PPU::WriteToOAM(uint16_t address, uint8_t value)
 	{
-		// OAM access is blocked in modes 2 and 3, and during DMA transfer.
+		// OAM access is blocked in modes 2 and 3.
 		if (currentMode == Mode::SearchingOAM ||
-			currentMode == Mode::LCDTransfer ||
-			currentDMATransferState == DMATransferState::InProgress)
+			currentMode == Mode::LCDTransfer)
 			return;
 
 		oam.Write(address, value);
@@ -174,11 +193,25 @@ namespace ModestGB
 		return dmaRegister.Read();
 	}
 
+	uint8_t PPU::ReadBGP() const
+	{
+		return bgp.Read();
+	}
+
+	uint8_t PPU::ReadOBP0() const
+	{
+		return obp0.Read();
+	}
+
+	uint8_t PPU::ReadOBP1() const
+	{
+		return obp1.Read();
+	}
+
 	uint8_t PPU::ReadVRAM(uint16_t address) const
 	{
-		// VRAM access is blocked in mode 3, and during DMA transfer.
-		if (currentMode == Mode::LCDTransfer ||
-			currentDMATransferState == DMATransferState::InProgress)
+		// VRAM access is blocked in mode 3.
+		if (currentMode == Mode::LCDTransfer)
 			return 0xFF;
 
 		return vram.Read(address);
@@ -186,15 +219,59 @@ namespace ModestGB
 
 	uint8_t PPU::ReadOAM(uint16_t address) const
 	{
-		// OAM access is blocked in modes 2 and 3, and during DMA transfer.
+		// OAM access is blocked in modes 2 and 3.
 		if (currentMode == Mode::SearchingOAM ||
-			currentMode == Mode::LCDTransfer ||
-			currentDMATransferState == DMATransferState::InProgress)
+			currentMode == Mode::LCDTransfer)
 			return 0xFF;
 
 		return oam.Read(address);
 	}
 
+	bool PPU::IsDMATransferInProgress() const
+	{
+		// Access to the rest of the bus during the transfer is restricted by the memory map.
+		return currentDMATransferState == DMATransferState::InProgress;
+	}
+
+	void PPU::SetFrameSkip(uint32_t framesToSkip, uint32_t frameInterval)
+	{
+		if (frameInterval == 0)
+		{
+			Logger::WriteWarning("Frame skip interval must be at least 1.", PPU_MESSAGE_HEADER);
+			return;
+		}
+
+		if (framesToSkip >= frameInterval)
+		{
+			Logger::WriteWarning("At least one frame of every frame skip interval must be rendered.", PPU_MESSAGE_HEADER);
+			return;
+		}
+
+		this->framesToSkip = framesToSkip;
+		frameSkipInterval = frameInterval;
+		isFrameSkipRestartPending = true;
+	}
+
+	uint32_t PPU::GetFramesToSkip() const
+	{
+		return framesToSkip;
+	}
+
+	uint32_t PPU::GetFrameSkipInterval() const
+	{
+		return frameSkipInterval;
+	}
+
+	void PPU::SetRenderingEnabled(bool isEnabled)
+	{
+		isRenderingEnabled = isEnabled;
+	}
+
+	bool PPU::IsRenderingEnabled() const
+	{
+		return isRenderingEnabled;
+	}
+
 	void PPU::SetPaletteTint(uint16_t paletteAddress, uint8_t colorIndex, Color color)
 	{
 		if (colorIndex > 3)
@@ -244,16 +321,17 @@ namespace ModestGB
 
 	void PPU::Tick(uint32_t cycles)
 	{
+		// OAM DMA runs independently of the LCD, so it is advanced once for the whole tick.
+		UpdateDMATransferProcess(cycles);
+
 		while (cycles > 0)
 		{
-			if (!lcdc.Read(LCDC_PPU_ENABLE_BIT_INDEX))
+			if (!lcdc.Read(LCDC_PPU_ENABLE))
 			{
 				SetCurrentMode(Mode::HBlank);
 				stat.ChangeBit(STAT_LYC_FLAG_INDEX, 0);
 				ly.Write(0);
 
-				currentDMATransferState = DMATransferState::Idle;
-
 				currentScanlineX = DEFAULT_SCANLINE_X;
 				currentScanlineElapsedCycles = 0;
 
@@ -263,8 +341,6 @@ namespace ModestGB
 				return;
 			}
 
-			UpdateDMATransferProcess(cycles);
-
 			switch (currentMode)
 			{
 			case Mode::HBlank:
@@ -329,10 +405,14 @@ namespace ModestGB
 
 		Interrupts::RequestInterrupt(*memoryMap, Interrupts::InterruptType::VBlank);
 
-		// Causes the window to render the most up to date version of the framebuffer.
-		primaryFramebuffer.UploadData();
-		primaryFramebuffer.Clear();
+		// Hands the completed frame over to the window, which uploads it the next time it presents.
+		if (isCurrentFrameRendered)
+		{
+			primaryFramebuffer.Publish();
+			primaryFramebuffer.Clear();
+		}
 
+		AdvanceFrameSkipCounter();
 	}
 
 	void PPU::UpdateVBlankMode(uint32_t& cycles)
@@ -403,7 +483,7 @@ namespace ModestGB
 				Sprite sprite;
 				GetSpriteAtIndex(spriteIndex, sprite);
 
-				uint8_t spriteSize = lcdc.Read(LCDC_OBJ_SIZE_BIT_INDEX) ? MAX_SPRITE_HEIGHT_IN_PIXELS : MIN_SPRITE_HEIGHT_IN_PIXELS;
+				uint8_t spriteSize = lcdc.Read(LCDC_OBJ_SIZE) ? MAX_SPRITE_HEIGHT_IN_PIXELS : MIN_SPRITE_HEIGHT_IN_PIXELS;
 
 				// If the sprite is on the current scanline, then added it to the list.
 				if (ly.Read() >= sprite.y && ly.Read() < sprite.y + spriteSize)
@@ -434,7 +514,7 @@ namespace ModestGB
 		sprite.y = static_cast<int16_t>(NormalizedReadFromOAM(attributeAddress) - MAX_SPRITE_HEIGHT_IN_PIXELS);
 
 		// In 8x16 mode, the least significant bit of the tile index should be ignored to ensure that it points to the first/top tile of the sprite.
-		sprite.tileIndex = static_cast<uint8_t>(lcdc.Read(LCDC_OBJ_SIZE_BIT_INDEX) ? NormalizedReadFromOAM(attributeAddress + 2) & 0xFE : NormalizedReadFromOAM(attributeAddress + 2));
+		sprite.tileIndex = static_cast<uint8_t>(lcdc.Read(LCDC_OBJ_SIZE) ? NormalizedReadFromOAM(attributeAddress + 2) & 0xFE : NormalizedReadFromOAM(attributeAddress + 2));
 
 		// Flags 
 		sprite.xFlip = static_cast<bool>((flags >> 5) & 1);
@@ -467,7 +547,7 @@ namespace ModestGB
 			if (backgroundPixelFetcher.GetCurrentMode() != BackgroundPixelFetcherMode::Window &&
 				wasWXConditionTriggered &&
 				wasWYConditionTriggered &&
-				lcdc.Read(LCDC_WINDOW_ENABLE_BIT_INDEX))
+				lcdc.Read(LCDC_WINDOW_ENABLE))
 			{
 				backgroundPixelFetcher.Reset();
 				backgroundPixelFetcher.SetY(windowLineCounter);
@@ -488,7 +568,7 @@ namespace ModestGB
 			currentScanlineElapsedCycles++;
 
 			SpritePixelFetcherState prevSpritePixelFetcherState = spritePixelFetcher.GetState();
-			if (lcdc.Read(LCDC_OBJ_ENABLE_BIT_INDEX))
+			if (lcdc.Read(LCDC_OBJ_ENABLE))
 			{
 				spritePixelFetcher.SetX(currentScanlineX);
 				spritePixelFetcher.Tick();
@@ -499,9 +579,9 @@ namespace ModestGB
 				return;
 
 			Pixel selectedPixel;
-			bool isSpritePixelAvailable = spritePixelFetcher.GetPixelQueueSize() != 0 && lcdc.Read(LCDC_OBJ_ENABLE_BIT_INDEX);
+			bool isSpritePixelAvailable = spritePixelFetcher.GetPixelQueueSize() != 0 && lcdc.Read(LCDC_OBJ_ENABLE);
 
-			if (lcdc.Read(LCDC_BG_WINDOW_ENABLE_BIT_INDEX))
+			if (lcdc.Read(LCDC_BG_WINDOW_ENABLE))
 			{
 				backgroundPixelFetcher.Tick();
 
@@ -554,10 +634,43 @@ namespace ModestGB
 		}
 	}
 
+	void PPU::AdvanceFrameSkipCounter()
+	{
+		// The first [framesToSkip] frames of each interval are skipped, e.g. skipping 3 of every 4 frames renders every 4th frame.
+		// A new frame skip setting restarts the interval with the next frame.
+		if (isFrameSkipRestartPending)
+		{
+			frameSkipCounter = 0;
+			isFrameSkipRestartPending = false;
+		}
+		else
+			frameSkipCounter = (frameSkipCounter + 1) % frameSkipInterval;
+
+		isCurrentFrameRendered = isRenderingEnabled && frameSkipCounter >= framesToSkip;
+	}
+
+	uint8_t PPU::ReadPalette(uint16_t paletteAddress) const
+	{
+		switch (paletteAddress)
+		{
+		case GB_SPRITE_PALETTE_0_ADDRESS:
+			return obp0.Read();
+		case GB_SPRITE_PALETTE_1_ADDRESS:
+			return obp1.Read();
+		default:
+			return bgp.Read();
+		}
+	}
+
 	void PPU::RenderPixel(Framebuffer& framebuffer, const Pixel& pixel, uint16_t scanlineX, uint16_t scanlineY)
 	{
+		// The pixel fetchers still run on skipped frames since they determine the length of mode 3, 
+		// only the palette lookup and the write to the framebuffer are skipped.
+		if (&framebuffer == &primaryFramebuffer && !isCurrentFrameRendered)
+			return;
+
 		Color color;
-		GetColorFromColorIndex(pixel.colorIndex, memoryMap->Read(pixel.paletteAddress), color);
+		GetColorFromColorIndex(pixel.colorIndex, ReadPalette(pixel.paletteAddress), color);
 
 		// Convert color components to the 0 - 1 range so they can be 
 		// multiplied with the palette tint's components to produce the final color.
@@ -585,6 +698,93 @@ namespace ModestGB
 		framebuffer.SetPixel(scanlineX, scanlineY, color);
 	}
 
+	void PPU::Serialize(StateWriter& writer) const
+	{
+		writer.Write(lcdc.Read());
+		writer.Write(stat.Read());
+		writer.Write(scy.Read());
+		writer.Write(scx.Read());
+		writer.Write(ly.Read());
+		writer.Write(lyc.Read());
+		writer.Write(wy.Read());
+		writer.Write(wx.Read());
+		writer.Write(bgp.Read());
+		writer.Write(obp0.Read());
+		writer.Write(obp1.Read());
+		writer.Write(statInterruptLine.Read());
+		oam.Serialize(writer);
+		vram.Serialize(writer);
+		dmaRegister.Serialize(writer);
+
+		writer.Write(currentMode);
+		writer.Write(currentScanlineElapsedCycles);
+		writer.Write(currentScanlineX);
+		writer.Write(currentDMATransferState);
+		writer.Write(currentDMATransferElapsedTime);
+		writer.Write(numberOfPixelsToIgnore);
+		writer.Write(ignoredPixels);
+		writer.Write(wasWYConditionTriggered);
+		writer.Write(wasWXConditionTriggered);
+		writer.Write(windowLineCounter);
+
+		writer.Write(static_cast<uint8_t>(spritesOnCurrentScanline.size()));
+		for (const Sprite& sprite : spritesOnCurrentScanline)
+			sprite.Serialize(writer);
+
+		backgroundPixelFetcher.Serialize(writer);
+		spritePixelFetcher.Serialize(writer);
+	}
+
+	void PPU::Deserialize(StateReader& reader)
+	{
+		lcdc.Write(reader.Read<uint8_t>());
+		stat.Write(reader.Read<uint8_t>());
+		scy.Write(reader.Read<uint8_t>());
+		scx.Write(reader.Read<uint8_t>());
+		ly.Write(reader.Read<uint8_t>());
+		lyc.Write(reader.Read<uint8_t>());
+		wy.Write(reader.Read<uint8_t>());
+		wx.Write(reader.Read<uint8_t>());
+
+		// Older states kept the palettes in the generic I/O memory, the emulator restores them from there.
+		if (reader.GetVersion() >= 3)
+		{
+			bgp.Write(reader.Read<uint8_t>());
+			obp0.Write(reader.Read<uint8_t>());
+			obp1.Write(reader.Read<uint8_t>());
+		}
+
+		statInterruptLine.Write(reader.Read<uint8_t>());
+		oam.Deserialize(reader);
+		vram.Deserialize(reader);
+		dmaRegister.Deserialize(reader);
+
+		reader.Read(currentMode);
+		reader.Read(currentScanlineElapsedCycles);
+		reader.Read(currentScanlineX);
+		reader.Read(currentDMATransferState);
+		reader.Read(currentDMATransferElapsedTime);
+		reader.Read(numberOfPixelsToIgnore);
+		reader.Read(ignoredPixels);
+		reader.Read(wasWYConditionTriggered);
+		reader.Read(wasWXConditionTriggered);
+		reader.Read(windowLineCounter);
+
+		uint8_t spriteCount = reader.Read<uint8_t>();
+		if (spriteCount > MAX_SPRITES_PER_SCANLINE)
+		{
+			reader.Fail();
+			return;
+		}
+
+		spritesOnCurrentScanline.resize(spriteCount);
+		for (Sprite& sprite : spritesOnCurrentScanline)
+			sprite.Deserialize(reader);
+
+		backgroundPixelFetcher.Deserialize(reader);
+		spritePixelFetcher.Deserialize(reader);
+	}
+
 	void PPU::SetCurrentMode(Mode mode)
 	{
 		currentMode = mode;
@@ -594,8 +794,7 @@ namespace ModestGB
 		// VBlank = 01
 		// OAM Search = 10
 		// LCD Transfer = 11
-		stat.ChangeBit(0, static_cast<uint8_t>(mode) & 1);
-		stat.ChangeBit(1, static_cast<uint8_t>(mode) & 2);
+		stat.Write(STAT_MODE, static_cast<uint8_t>(mode));
 	}
 
 	void PPU::ChangeStatInterruptLineBit(uint8_t bitIndex, bool value)
@@ -626,31 +825,44 @@ namespace ModestGB
 		if (dmaRegister.IsTransferPending())
 		{
 			dmaRegister.ClearPendingTransfer();
+
+			// Writing to the DMA register during a transfer restarts it.
+			currentDMATransferState = DMATransferState::Idle;
+			currentDMATransferElapsedTime = 0;
+
+			CopyDMASourceToOAM();
 			currentDMATransferState = DMATransferState::InProgress;
 		}
 
+		// The tick that starts the transfer also counts toward its duration.
 		if (currentDMATransferState == DMATransferState::InProgress)
 		{
-			for (uint32_t i = 0; i < cycles; i++)
-			{
-				// A DMA transfer causes data to be transferred from $XX00-$XX9F to $FFE0-$FE9F (OAM).
-				// Since a DMA transfer lasts 160 cycles and also transfers 160 bytes, the elapsed DMA transfer time
-				// can be used as the offset from the source and destination addresses.
-				uint8_t sourceData = memoryMap->Read(dmaRegister.GetSourceStartAddress() + currentDMATransferElapsedTime);
-				NormalizedWriteToOAM(DMA_TRANSFER_DESTINATION_START_ADDRESS + currentDMATransferElapsedTime, sourceData);
-
-				currentDMATransferElapsedTime++;
+			currentDMATransferElapsedTime += cycles;
 
-				if (currentDMATransferElapsedTime == DMA_TRANSFER_DURATION)
-				{
-					currentDMATransferState = DMATransferState::Idle;
-					currentDMATransferElapsedTime = 0;
-					break;
-				}
+			if (currentDMATransferElapsedTime >= DMA_TRANSFER_DURATION)
+			{
+				currentDMATransferState = DMATransferState::Idle;
+				currentDMATransferElapsedTime = 0;
 			}
 		}
 	}
 
+	void PPU::CopyDMASourceToOAM()
+	{
+		// A DMA transfer causes data to be transferred from $XX00-$XX9F to $FE00-$FE9F (OAM).
+		// The whole block is copied up front: for the 160 cycles the transfer lasts, the memory map only lets 
+		// the CPU reach HRAM, so neither the source nor OAM can be observed or modified before the copy would have finished.
+		std::array<uint8_t, DMA_TRANSFER_SIZE> block;
+		uint16_t sourceAddress = dmaRegister.GetSourceStartAddress();
+
+		if (Arithmetic::IsInRange(sourceAddress, GB_VRAM_START_ADDRESS, GB_VRAM_END_ADDRESS))
+			vram.ReadBlock(Arithmetic::NormalizeAddress(sourceAddress, GB_VRAM_START_ADDRESS, GB_VRAM_END_ADDRESS), block.data(), DMA_TRANSFER_SIZE);
+		else
+			memoryMap->ReadBlock(sourceAddress, block.data(), DMA_TRANSFER_SIZE);
+
+		oam.WriteBlock(Arithmetic::NormalizeAddress(DMA_TRANSFER_DESTINATION_START_ADDRESS, GB_OAM_START_ADDRESS, GB_OAM_END_ADDRESS), block.data(), DMA_TRANSFER_SIZE);
+	}
+
 	uint8_t PPU::NormalizedReadFromOAM(uint16_t address) const
 	{
 		return oam.Read(Arithmetic::NormalizeAddress(address, GB_OAM_START_ADDRESS, GB_OAM_END_ADDRESS));
@@ -661,6 +873,15 @@ namespace ModestGB
 		oam.Write(Arithmetic::NormalizeAddress(address, GB_OAM_START_ADDRESS, GB_OAM_END_ADDRESS), value);
 	}
 
+	void PPU::UploadFramebuffers()
+	{
+		primaryFramebuffer.UploadData();
+		tileDebugFramebuffer.UploadData();
+		spriteDebugFramebuffer.UploadData();
+		backgroundDebugFramebuffer.UploadData();
+		windowDebugFramebuffer.UploadData();
+	}
+
 	const Framebuffer& PPU::GetPrimaryFramebuffer() const
 	{
 		return primaryFramebuffer;
@@ -696,7 +917,7 @@ namespace ModestGB
 			elapsedCycles = 0;
 
 			uint16_t tileIndex = GetTileIndexFromTileMaps(&vram, static_cast<uint8_t>(scanlineX / static_cast<float>(TILE_WIDTH_IN_PIXELS)), static_cast<uint8_t>(scanlineY / static_cast<float>(TILE_HEIGHT_IN_PIXELS)), useAlternateTileMapAddress);
-			uint16_t tileAddress = GetTileAddress(tileIndex, scanlineY, lcdc.Read(LCDC_BG_WINDOW_ADDRESSING_MODE_BIT_INDEX));
+			uint16_t tileAddress = GetTileAddress(tileIndex, scanlineY, lcdc.Read(LCDC_BG_WINDOW_ADDRESSING_MODE));
 
 			// For background and window pixels, the most significant bits/pixels are pushed to the queue first.
 			for (int8_t px = TILE_WIDTH_IN_PIXELS - 1; px >= 0; px--)
@@ -722,7 +943,7 @@ namespace ModestGB
 					if (scanlineY == TILE_MAP_HEIGHT_IN_PIXELS - 1)
 					{
 						scanlineY = 0;
-						framebuffer.UploadData();
+						framebuffer.Publish();
 						framebuffer.Clear();
 					}
 					else
@@ -744,7 +965,7 @@ namespace ModestGB
 		static uint8_t scanlineY = 0;
 		static uint32_t elapsedCycles = 0;
 
-		DebugDrawTileMap(cycles, backgroundDebugFramebuffer, scanlineX, scanlineY, lcdc.Read(LCDC_BG_TILE_MAP_AREA_BIT_INDEX), TileMapType::Background, elapsedCycles);
+		DebugDrawTileMap(cycles, backgroundDebugFramebuffer, scanlineX, scanlineY, lcdc.Read(LCDC_BG_TILE_MAP_AREA), TileMapType::Background, elapsedCycles);
 	}
 
 	void PPU::DebugDrawWindowTileMap(uint32_t cycles)
@@ -753,7 +974,7 @@ namespace ModestGB
 		static uint8_t scanlineY = 0;
 		static uint32_t elapsedCycles = 0;
 
-		DebugDrawTileMap(cycles, windowDebugFramebuffer, scanlineX, scanlineY, lcdc.Read(LCDC_WINDOW_TILE_MAP_AREA_BIT_INDEX), TileMapType::Window, elapsedCycles);
+		DebugDrawTileMap(cycles, windowDebugFramebuffer, scanlineX, scanlineY, lcdc.Read(LCDC_WINDOW_TILE_MAP_AREA), TileMapType::Window, elapsedCycles);
 	}
 
 	void PPU::DebugDrawSprites(uint32_t cycles)
@@ -772,7 +993,7 @@ namespace ModestGB
 			Sprite sprite;
 			GetSpriteAtIndex(spriteIndex, sprite);
 
-			uint8_t spriteSizeInTiles = lcdc.Read(LCDC_OBJ_SIZE_BIT_INDEX) + 1;
+			uint8_t spriteSizeInTiles = lcdc.Read(LCDC_OBJ_SIZE) + 1;
 			uint8_t spriteSizeInPixels = spriteSizeInTiles * MIN_SPRITE_HEIGHT_IN_PIXELS;
 
 			uint8_t tileX = static_cast<uint8_t>(spriteIndex % MAX_SPRITES_PER_SCANLINE);
@@ -812,7 +1033,7 @@ namespace ModestGB
 				if (spriteIndex >= MAX_SPRITE_COUNT)
 				{
 					spriteIndex = 0;
-					spriteDebugFramebuffer.UploadData();
+					spriteDebugFramebuffer.Publish();
 					spriteDebugFramebuffer.Clear(RGBA_BLACK);
 				}
 			}
@@ -832,7 +1053,7 @@ namespace ModestGB
 		{
 			elapsedCycles = 0;
 
-			uint8_t palette = memoryMap->Read(GB_BACKGROUND_PALETTE_ADDRESS);
+			uint8_t palette = bgp.Read();
 			uint8_t tileX = tileIndex % TILE_DEBUG_FRAMEBUFFER_WIDTH_IN_TILES;
 			uint8_t tileY = static_cast<uint8_t>(std::floor(tileIndex / static_cast<float>(TILE_DEBUG_FRAMEBUFFER_WIDTH_IN_TILES)));
 			uint8_t spacing = TILE_WIDTH_IN_PIXELS + 1;
@@ -861,7 +1082,7 @@ namespace ModestGB
 				if (tileIndex >= MAX_TILE_COUNT)
 				{
 					tileIndex = 0;
-					tileDebugFramebuffer.UploadData();
+					tileDebugFramebuffer.Publish();
 					tileDebugFramebuffer.Clear(RGBA_BLACK);
 				}
 			}
@@ -54,4 +54,33 @@ namespace ModestGB
 		lastPixelIndex = 0;
 		pixelQueueSize = 0;
 	}
+
+	void PixelFetcher::Serialize(StateWriter& writer) const
+	{
+		writer.Write(x);
+		writer.Write(y);
+
+		for (const Pixel& pixel : pixelQueue)
+			pixel.Serialize(writer);
+
+		writer.Write(frontPixelIndex);
+		writer.Write(lastPixelIndex);
+		writer.Write(pixelQueueSize);
+	}
+
+	void PixelFetcher::Deserialize(StateReader& reader)
+	{
+		reader.Read(x);
+		reader.Read(y);
+
+		for (Pixel& pixel : pixelQueue)
+			pixel.Deserialize(reader);
+
+		reader.Read(frontPixelIndex);
+		reader.Read(lastPixelIndex);
+		reader.Read(pixelQueueSize);
+
+		if (frontPixelIndex >= PIXEL_FETCHER_QUEUE_SIZE || lastPixelIndex >= PIXEL_FETCHER_QUEUE_SIZE || pixelQueueSize > PIXEL_FETCHER_QUEUE_SIZE)
+			reader.Fail();
+	}
 }
\ No newline at end of file
@@ -31,6 +31,42 @@ namespace ModestGB
 		spritesOnCurrentScanline.clear();
 	}
 
+	void SpritePixelFetcher::Serialize(StateWriter& writer) const
+	{
+		PixelFetcher::Serialize(writer);
+
+		writer.Write(currentState);
+		writer.Write(currentSpriteIndex);
+		writer.Write(currentLowTileData);
+
+		writer.Write(static_cast<uint8_t>(spritesOnCurrentScanline.size()));
+		for (const Sprite& sprite : spritesOnCurrentScanline)
+			sprite.Serialize(writer);
+	}
+
+	void SpritePixelFetcher::Deserialize(StateReader& reader)
+	{
+		PixelFetcher::Deserialize(reader);
+
+		reader.Read(currentState);
+		reader.Read(currentSpriteIndex);
+		reader.Read(currentLowTileData);
+
+		uint8_t spriteCount = reader.Read<uint8_t>();
+		if (spriteCount > MAX_SPRITES_PER_SCANLINE)
+		{
+			reader.Fail();
+			return;
+		}
+
+		spritesOnCurrentScanline.resize(spriteCount);
+		for (Sprite& sprite : spritesOnCurrentScanline)
+			sprite.Deserialize(reader);
+
+		// The current sprite is always the one at the current index, outside of the idle state (where it's reassigned anyway).
+		currentSprite = currentSpriteIndex >= 0 && currentSpriteIndex < spritesOnCurrentScanline.size() ? &spritesOnCurrentScanline[currentSpriteIndex] : nullptr;
+	}
+
 	void SpritePixelFetcher::Tick()
 	{
 		switch (currentState)
@@ -154,7 +190,7 @@ namespace ModestGB
 		uint8_t scanline = y - currentSprite->y;
 
 		// Determine the sprite's height (8 or 16).
-		uint8_t spriteHeight = lcdc->Read(LCDC_OBJ_SIZE_BIT_INDEX) ? MAX_SPRITE_HEIGHT_IN_PIXELS : MIN_SPRITE_HEIGHT_IN_PIXELS;
+		uint8_t spriteHeight = lcdc->Read(LCDC_OBJ_SIZE) ? MAX_SPRITE_HEIGHT_IN_PIXELS : MIN_SPRITE_HEIGHT_IN_PIXELS;
 
 		if (currentSprite->yFlip)
 			scanline = (spriteHeight - 1) - scanline;
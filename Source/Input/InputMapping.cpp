@@ -0,0 +1,76 @@
+#include "SDL.h"
+#include "Input/InputMapping.hpp"
+
+namespace ModestGB
+{
+	const std::map<GBButton, ButtonKeyPair> DEFAULT_INPUT_MAPPING =
+	{
+		{GBButton::RIGHT,  {ControllerButtonCode::DPAD_RIGHT, KeyCode::D}},
+		{GBButton::LEFT,   {ControllerButtonCode::DPAD_LEFT,  KeyCode::A}},
+		{GBButton::UP,     {ControllerButtonCode::DPAD_UP,    KeyCode::W}},
+		{GBButton::DOWN,   {ControllerButtonCode::DPAD_DOWN,  KeyCode::S}},
+		{GBButton::A,      {ControllerButtonCode::ACTION_0,   KeyCode::J}},
+		{GBButton::B,      {ControllerButtonCode::ACTION_1,   KeyCode::K}},
+		{GBButton::START,  {ControllerButtonCode::START,	  KeyCode::P}},
+		{GBButton::SELECT, {ControllerButtonCode::SELECT,     KeyCode::O}}
+	};
+
+	InputMapping::InputMapping()
+	{
+		LoadMapping(DEFAULT_INPUT_MAPPING);
+	}
+
+	void InputMapping::LoadMapping(const std::map<GBButton, ButtonKeyPair>& mapping)
+	{
+		this->mapping = mapping;
+	}
+
+	const std::map<GBButton, ButtonKeyPair>& InputMapping::GetMapping() const
+	{
+		return mapping;
+	}
+
+	ControllerButtonCode InputMapping::GetControllerButtonCode(GBButton button) const
+	{
+		return mapping.at(button).button;
+	}
+
+	KeyCode InputMapping::GetKeyCode(GBButton button) const
+	{
+		return mapping.at(button).key;
+	}
+
+	void InputMapping::SetControllerButtonCode(GBButton button, ControllerButtonCode buttonCode)
+	{
+		mapping[button].button = buttonCode;
+	}
+
+	void InputMapping::SetKeyCode(GBButton button, KeyCode keyCode)
+	{
+		mapping[button].key = keyCode;
+	}
+
+	std::vector<GBButton> InputMapping::GetButtonsMappedToKeyCode(KeyCode keyCode) const
+	{
+		std::vector<GBButton> buttons;
+		for (const std::pair<GBButton, ButtonKeyPair> entry : mapping)
+		{
+			if (entry.second.key == keyCode)
+				buttons.push_back(entry.first);
+		}
+
+		return buttons;
+	}
+
+	std::vector<GBButton> InputMapping::GetButtonsMappedToControllerButtonCode(ControllerButtonCode buttonCode) const
+	{
+		std::vector<GBButton> buttons;
+		for (const std::pair<GBButton, ButtonKeyPair> entry : mapping)
+		{
+			if (entry.second.button == buttonCode)
+				buttons.push_back(entry.first);
+		}
+
+		return buttons;
+	}
+}
\ No newline at end of file
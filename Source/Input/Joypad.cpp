@@ -7,18 +7,6 @@
 
 namespace ModestGB
 {
-	const std::map<GBButton, ButtonKeyPair> DEFAULT_INPUT_MAPPING =
-	{
-		{GBButton::RIGHT,  {ControllerButtonCode::DPAD_RIGHT, KeyCode::D}},
-		{GBButton::LEFT,   {ControllerButtonCode::DPAD_LEFT,  KeyCode::A}},
-		{GBButton::UP,     {ControllerButtonCode::DPAD_UP,    KeyCode::W}},
-		{GBButton::DOWN,   {ControllerButtonCode::DPAD_DOWN,  KeyCode::S}},
-		{GBButton::A,      {ControllerButtonCode::ACTION_0,   KeyCode::J}},
-		{GBButton::B,      {ControllerButtonCode::ACTION_1,   KeyCode::K}},
-		{GBButton::START,  {ControllerButtonCode::START,	  KeyCode::P}},
-		{GBButton::SELECT, {ControllerButtonCode::SELECT,     KeyCode::O}}
-	};
-
 	// Joypad Register
 	// Bit 7 - Unused
 	// Bit 6 - Unused
@@ -29,47 +17,9 @@ namespace ModestGB
 	// Bit 1 - Left or B (0 = Pressed)
 	// Bit 0 - Right or A (0 = Pressed)
 
-	Joypad::Joypad(InputManager& inputManager, Memory& memoryMap) : memoryMap(&memoryMap)
+	Joypad::Joypad(Memory& memoryMap) : memoryMap(&memoryMap)
 	{
 		ResetButtonStates();
-
-		LoadInputMapping(DEFAULT_INPUT_MAPPING);
-
-		inputManager.RegisterKeyPressedCallback(std::bind(&Joypad::OnKeyPressed, this, std::placeholders::_1));
-		inputManager.RegisterKeyReleasedCallback(std::bind(&Joypad::OnKeyReleased, this, std::placeholders::_1));
-
-		inputManager.RegisterControllerButtonPressedCallback(std::bind(&Joypad::OnControllerButtonPressed, this, std::placeholders::_1));
-		inputManager.RegisterControllerButtonReleasedCallback(std::bind(&Joypad::OnControllerButtonReleased, this, std::placeholders::_1));
-	}
-
-	void Joypad::LoadInputMapping(const std::map<GBButton, ButtonKeyPair>& mapping)
-	{
-		inputMapping = mapping;
-	}
-
-	const std::map<GBButton, ButtonKeyPair>& Joypad::GetInputMapping() const
-	{
-		return inputMapping;
-	}
-
-	ControllerButtonCode Joypad::GetControllerButtonCode(GBButton button) const
-	{
-		return inputMapping.at(button).button;
-	}
-
-	KeyCode Joypad::GetKeyCode(GBButton button) const
-	{
-		return inputMapping.at(button).key;
-	}
-
-	void Joypad::SetControllerButtonCode(GBButton button, ControllerButtonCode buttonCode)
-	{
-		inputMapping[button].button = buttonCode;
-	}
-
-	void Joypad::SetKeyCode(GBButton button, KeyCode keyCode)
-	{
-		inputMapping[button].key = keyCode;
 	}
 
 	uint8_t Joypad::Read() const
@@ -120,6 +70,25 @@ namespace ModestGB
 		isDirectionButtonsSelected = false;
 	}
 
+	void Joypad::Serialize(StateWriter& writer) const
+	{
+		for (const auto& [button, isPressed] : buttonStates)
+			writer.Write(isPressed);
+
+		writer.Write(isActionButtonsSelected);
+		writer.Write(isDirectionButtonsSelected);
+	}
+
+	void Joypad::Deserialize(StateReader& reader)
+	{
+		// Every button always has an entry, so the states are read back in the same order they were written in.
+		for (auto& [button, isPressed] : buttonStates)
+			reader.Read(isPressed);
+
+		reader.Read(isActionButtonsSelected);
+		reader.Read(isDirectionButtonsSelected);
+	}
+
 	bool Joypad::IsActionButtonsSelected() const
 	{
 		return isActionButtonsSelected;
@@ -162,48 +131,6 @@ namespace ModestGB
 		buttonStates[GBButton::SELECT] = false;
 	}
 
-	void Joypad::OnKeyPressed(KeyCode keyCode)
-	{
-		SetButtonStateWithKeyCode(keyCode, true);
-	}
-
-	void Joypad::OnKeyReleased(KeyCode keyCode)
-	{
-		SetButtonStateWithKeyCode(keyCode, false);
-	}
-
-	void Joypad::OnControllerButtonPressed(ControllerButtonCode buttonCode)
-	{
-		SetButtonStateWithControllerButtonCode(buttonCode, true);
-	}
-
-	void Joypad::OnControllerButtonReleased(ControllerButtonCode buttonCode)
-	{
-		SetButtonStateWithControllerButtonCode(buttonCode, false);
-	}
-
-	void Joypad::SetButtonStateWithKeyCode(KeyCode keyCode, bool isPressed)
-	{
-		for (const std::pair<GBButton, ButtonKeyPair> entry : inputMapping)
-		{
-			if (entry.second.key == keyCode)
-			{
-				SetButtonState(entry.first, isPressed);
-			}
-		}
-	}
-
-	void Joypad::SetButtonStateWithControllerButtonCode(ControllerButtonCode buttonCode, bool isPressed)
-	{
-		for (const std::pair<GBButton, ButtonKeyPair> entry : inputMapping)
-		{
-			if (entry.second.button == buttonCode)
-			{
-				SetButtonState(entry.first, isPressed);
-			}
-		}
-	}
-
 	void Joypad::SetButtonState(GBButton button, bool isPressed)
 	{
 		buttonStates[button] = isPressed;
@@ -236,4 +163,29 @@ namespace ModestGB
 			}
 		}
 	}
+
+	uint8_t Joypad::GetButtonStates() const
+	{
+		uint8_t states = 0;
+
+		for (const auto& [button, isPressed] : buttonStates)
+		{
+			if (isPressed)
+				states |= 1 << static_cast<uint8_t>(button);
+		}
+
+		return states;
+	}
+
+	void Joypad::SetButtonStates(uint8_t states)
+	{
+		// Only the buttons that changed go through SetButtonState, so that pressing a button requests the interrupt as usual.
+		for (auto& [button, isPressed] : buttonStates)
+		{
+			bool isButtonPressed = (states >> static_cast<uint8_t>(button)) & 1;
+
+			if (isButtonPressed != isPressed)
+				SetButtonState(button, isButtonPressed);
+		}
+	}
 }
\ No newline at end of file
@@ -0,0 +1,91 @@
+#include <fstream>
+#include <iterator>
+#include "InputMovie.hpp"
+#include "Utils/StateSerialization.hpp"
+#include "Logger.hpp"
+
+namespace ModestGB
+{
+	const std::string INPUT_MOVIE_MESSAGE_HEADER = "[MOVIE]";
+
+	bool InputMovie::SaveToFile(const std::string& path) const
+	{
+		std::vector<uint8_t> buffer;
+		StateWriter writer(buffer);
+
+		writer.Write(INPUT_MOVIE_MAGIC);
+		writer.Write(INPUT_MOVIE_VERSION);
+		writer.Write(romHash);
+		writer.Write(startsAtPowerOn);
+		writer.Write(initialExcessCycles);
+		writer.Write(static_cast<uint64_t>(initialState.size()));
+		writer.WriteBytes(initialState.data(), initialState.size());
+		writer.Write(static_cast<uint64_t>(frames.size()));
+		writer.WriteBytes(frames.data(), frames.size());
+		writer.Finish();
+
+		std::ofstream file(path, std::ios::binary);
+		file.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+
+		if (!file)
+		{
+			Logger::WriteError("Failed to write the movie to " + path, INPUT_MOVIE_MESSAGE_HEADER);
+			return false;
+		}
+
+		return true;
+	}
+
+	bool InputMovie::LoadFromFile(const std::string& path)
+	{
+		std::ifstream file(path, std::ios::binary);
+
+		if (!file.is_open())
+		{
+			Logger::WriteError("Failed to open the movie at " + path, INPUT_MOVIE_MESSAGE_HEADER);
+			return false;
+		}
+
+		std::vector<uint8_t> data = std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+		StateReader reader(data.data(), data.size());
+
+		if (reader.Read<uint32_t>() != INPUT_MOVIE_MAGIC || reader.Read<uint32_t>() != INPUT_MOVIE_VERSION)
+		{
+			Logger::WriteError("Not a movie, or a movie made by an unsupported version: " + path, INPUT_MOVIE_MESSAGE_HEADER);
+			return false;
+		}
+
+		reader.Read(romHash);
+		reader.Read(startsAtPowerOn);
+		reader.Read(initialExcessCycles);
+
+		// The sizes are checked against the size of the file before anything is allocated.
+		uint64_t initialStateSize = reader.Read<uint64_t>();
+
+		if (initialStateSize > data.size())
+			reader.Fail();
+		else
+		{
+			initialState.resize(initialStateSize);
+			reader.ReadBytes(initialState.data(), initialState.size());
+		}
+
+		uint64_t frameCount = reader.Read<uint64_t>();
+
+		if (frameCount > data.size())
+			reader.Fail();
+		else
+		{
+			frames.resize(frameCount);
+			reader.ReadBytes(frames.data(), frames.size());
+		}
+
+		if (reader.HasFailed() || !reader.IsAtEnd())
+		{
+			Logger::WriteError("The movie is corrupted: " + path, INPUT_MOVIE_MESSAGE_HEADER);
+			return false;
+		}
+
+		return true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,121 @@
+#include <map>
+#include <charconv>
+#include "LaunchOptions.hpp"
+#include "Logger.hpp"
+
+namespace ModestGB
+{
+	const std::string AUDIO_OPTION_NAME = "--audio=";
+	const std::string AUDIO_OUTPUT_OPTION_NAME = "--audio-output=";
+	const std::string REWIND_BUFFER_OPTION_NAME = "--rewind-buffer=";
+	const std::string REWIND_INTERVAL_OPTION_NAME = "--rewind-interval=";
+	const std::string RUN_AHEAD_OPTION_NAME = "--run-ahead=";
+	const std::string FRAME_SKIP_OPTION_NAME = "--frame-skip=";
+	const std::string NO_RENDER_OPTION_NAME = "--no-render";
+	const std::string ROM_OPTION_NAME = "--rom=";
+	const std::string MOVIE_OPTION_NAME = "--movie=";
+	const std::string UNCAPPED_OPTION_NAME = "--uncapped";
+
+	const std::map<std::string, AudioSinkType> AUDIO_SINK_TYPE_NAMES =
+	{
+		{ "sdl", AudioSinkType::SDL },
+		{ "null", AudioSinkType::Null },
+		{ "wav", AudioSinkType::WAVFile },
+		{ "raw", AudioSinkType::RawPCM }
+	};
+
+	const std::map<AudioSinkType, std::string> DEFAULT_AUDIO_OUTPUT_PATHS =
+	{
+		{ AudioSinkType::WAVFile, "Modest-GB.wav" },
+		{ AudioSinkType::RawPCM, "Modest-GB.pcm" }
+	};
+
+	// Leaves [result] untouched if [value] isn't a number of at least [minimum].
+	void ParseUnsignedOption(const std::string& argument, const std::string& value, uint32_t minimum, uint32_t& result)
+	{
+		uint32_t parsedValue = 0;
+		std::from_chars_result parseResult = std::from_chars(value.data(), value.data() + value.size(), parsedValue);
+
+		if (parseResult.ec != std::errc() || parseResult.ptr != value.data() + value.size() || parsedValue < minimum)
+		{
+			Logger::WriteWarning("Invalid value for command line option: " + argument);
+			return;
+		}
+
+		result = parsedValue;
+	}
+
+	// Leaves [framesToSkip] and [frameInterval] untouched if [value] isn't "N/M" with N < M, so that at least one frame of every M is drawn.
+	void ParseFrameSkipOption(const std::string& argument, const std::string& value, uint32_t& framesToSkip, uint32_t& frameInterval)
+	{
+		uint32_t parsedFramesToSkip = 0;
+		uint32_t parsedFrameInterval = 0;
+		const char* valueEnd = value.data() + value.size();
+
+		std::from_chars_result parseResult = std::from_chars(value.data(), valueEnd, parsedFramesToSkip);
+		bool isValid = parseResult.ec == std::errc() && parseResult.ptr != valueEnd && *parseResult.ptr == '/';
+
+		if (isValid)
+		{
+			parseResult = std::from_chars(parseResult.ptr + 1, valueEnd, parsedFrameInterval);
+			isValid = parseResult.ec == std::errc() && parseResult.ptr == valueEnd && parsedFramesToSkip < parsedFrameInterval;
+		}
+
+		if (!isValid)
+		{
+			Logger::WriteWarning("Invalid value for command line option: " + argument);
+			return;
+		}
+
+		framesToSkip = parsedFramesToSkip;
+		frameInterval = parsedFrameInterval;
+	}
+
+	LaunchOptions ParseLaunchOptions(int argc, char* argv[])
+	{
+		LaunchOptions options;
+
+		for (int i = 1; i < argc; i++)
+		{
+			std::string argument = argv[i];
+
+			if (argument.starts_with(AUDIO_OPTION_NAME))
+			{
+				auto it = AUDIO_SINK_TYPE_NAMES.find(argument.substr(AUDIO_OPTION_NAME.size()));
+
+				if (it != AUDIO_SINK_TYPE_NAMES.end())
+					options.audioSinkType = it->second;
+				else
+					Logger::WriteWarning("Unknown audio output: " + argument);
+			}
+			else if (argument.starts_with(AUDIO_OUTPUT_OPTION_NAME))
+				options.audioOutputPath = argument.substr(AUDIO_OUTPUT_OPTION_NAME.size());
+			else if (argument.starts_with(REWIND_BUFFER_OPTION_NAME))
+				ParseUnsignedOption(argument, argument.substr(REWIND_BUFFER_OPTION_NAME.size()), 0, options.rewindBufferSizeInMiB);
+			else if (argument.starts_with(REWIND_INTERVAL_OPTION_NAME))
+				ParseUnsignedOption(argument, argument.substr(REWIND_INTERVAL_OPTION_NAME.size()), 1, options.rewindInterval);
+			else if (argument.starts_with(RUN_AHEAD_OPTION_NAME))
+				ParseUnsignedOption(argument, argument.substr(RUN_AHEAD_OPTION_NAME.size()), 0, options.runAheadFrames);
+			else if (argument.starts_with(FRAME_SKIP_OPTION_NAME))
+				ParseFrameSkipOption(argument, argument.substr(FRAME_SKIP_OPTION_NAME.size()), options.framesToSkip, options.frameSkipInterval);
+			else if (argument == NO_RENDER_OPTION_NAME)
+				options.isRenderingDisabled = true;
+			else if (argument.starts_with(ROM_OPTION_NAME))
+				options.romPath = argument.substr(ROM_OPTION_NAME.size());
+			else if (argument.starts_with(MOVIE_OPTION_NAME))
+				options.moviePath = argument.substr(MOVIE_OPTION_NAME.size());
+			else if (argument == UNCAPPED_OPTION_NAME)
+				options.isSpeedUncapped = true;
+			else
+				Logger::WriteWarning("Unknown command line option: " + argument);
+		}
+
+		if (options.audioOutputPath.empty() && DEFAULT_AUDIO_OUTPUT_PATHS.contains(options.audioSinkType))
+			options.audioOutputPath = DEFAULT_AUDIO_OUTPUT_PATHS.at(options.audioSinkType);
+
+		if (!options.moviePath.empty() && options.romPath.empty())
+			Logger::WriteWarning("--movie is ignored without --rom.");
+
+		return options;
+	}
+}
\ No newline at end of file
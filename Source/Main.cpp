@@ -1,9 +1,10 @@
 #include <string>
 #include "Logger.hpp"
 #include "Emulator.hpp"
+#include "LaunchOptions.hpp"
 #include "Utils/Arithmetic.hpp"
 
 int main(int argc, char* argv[])
 {
-	return ModestGB::Emulator().Run();
+	return ModestGB::Emulator(ModestGB::ParseLaunchOptions(argc, argv)).Run();
 }
\ No newline at end of file
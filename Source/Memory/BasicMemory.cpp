@@ -1,4 +1,5 @@
 #include <string>
+#include <cstring>
 #include "Memory/BasicMemory.hpp"
 #include "Logger.hpp"
 
@@ -7,26 +8,49 @@ namespace ModestGB
 	BasicMemory::BasicMemory(uint32_t size)
 	{
 		this->size = size;
-		data = std::vector<uint8_t>(size);
+		data = PagedBuffer(size);
 	}
 
 	uint8_t BasicMemory::Read(uint16_t address) const
 	{
 		if (!IsAddressAvailable(address))
 		{
-			Logger::WriteWarning("[Memory] Address is out of range. Address: " + std::to_string(address) + " | Memory Size: " + std::to_string(data.size()));
+			Logger::WriteWarning("[Memory] Address is out of range. Address: " + std::to_string(address) + " | Memory Size: " + std::to_string(size));
 			return 0;
 		}
 		else
 		{
-			return data[address];
+			return data.Read(address);
 		}
 	}
 
 	void BasicMemory::Write(uint16_t address, uint8_t value)
 	{
 		if (IsAddressAvailable(address)) 
-			data[address] = value;
+			data.Write(address, value);
+	}
+
+	void BasicMemory::ReadBlock(uint16_t address, uint8_t* destination, uint16_t length) const
+	{
+		if (address + length > size)
+		{
+			Logger::WriteWarning("[Memory] Block is out of range. Address: " + std::to_string(address) + " | Length: " + std::to_string(length) + " | Memory Size: " + std::to_string(size));
+			std::memset(destination, 0, length);
+			return;
+		}
+
+		data.ReadBlock(address, destination, length);
+	}
+
+	void BasicMemory::WriteBlock(uint16_t address, const uint8_t* source, uint16_t length)
+	{
+		if (address + length > size)
+		{
+			Logger::WriteWarning("[Memory] Block is out of range. Address: " + std::to_string(address) + " | Length: " + std::to_string(length) + " | Memory Size: " + std::to_string(size));
+			return;
+		}
+
+		data.WriteBlock(address, source, length);
 	}
 
 	bool BasicMemory::IsAddressAvailable(uint16_t address) const
@@ -34,8 +58,18 @@ namespace ModestGB
 		return address < size;
 	}
 
+	void BasicMemory::Serialize(StateWriter& writer) const
+	{
+		writer.Write(data);
+	}
+
+	void BasicMemory::Deserialize(StateReader& reader)
+	{
+		reader.Read(data);
+	}
+
 	void BasicMemory::Reset()
 	{
-		std::memset(data.data(), 0, sizeof(uint8_t) * data.size());
+		data.Clear();
 	}
 }
\ No newline at end of file
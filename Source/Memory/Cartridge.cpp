@@ -1,6 +1,6 @@
 #include <cmath>
 #include <cassert>
-#include <iterator>
+#include <algorithm>
 #include <filesystem>
 #include "Logger.hpp"
 #include "Memory/Cartridge.hpp"
@@ -8,169 +8,87 @@
 #include "Memory/MBC1.hpp"
 #include "Memory/MBC3.hpp"
 #include "Memory/MBC5.hpp"
+#include "Memory/ROMIndex.hpp"
+#include "Utils/Decompression.hpp"
 
 namespace ModestGB
 {
 	const std::string CARTRIDGE_LOG_HEADER = "[CART]";
 
-	// Title - The title of the ame in upper case ASCII.
-	const uint16_t TITLE_START_ADDRESS = 0x0134;
-	const uint16_t TITLE_END_ADDRESS = 0x0143;
-
-	// CGB Flag - The upper bit of this byte is uused to enable Game Boy Color functions. 
-	// In older cartridges, this is a part of the title data.
-	const uint16_t CGB_FLAG_ADDRESS = 0x0143;
-
-	// SGB Flag - Specifies whether the game supports Super Game Boy functions. 
-	const uint16_t SGB_FLAG_ADDRESS = 0x0146;
-
-	// Cartridge Type - Indicates which Memory Bank Controller (if any) is used, and if other external hardware exists.
-	const uint16_t CARTRIDGE_TYPE_ADDRESS = 0x0147;
-
-	// ROM Size - Size of the ROM. Generally calculated as "32 KiB << ROM_SIZE_CODE".
-	const uint16_t ROM_SIZE_ADDRESS = 0x0148;
-
-	// RAM Size - Size of external RAM (if any).
-	const uint16_t RAM_SIZE_ADDRESS = 0x0149;
-
-	const uint16_t LOGO_START_ADDRESS = 0x104;
-	const uint16_t LOGO_END_ADDRESS = 0x133;
-
-	const uint16_t HEADER_SIZE_IN_BYTES = 0x143;
-
-	// Catridge header memory bank controller type codes
-
-	const uint8_t ROM_ONLY_CODE = 0x00;
-	const uint8_t MBC1_CODE = 0x01;
-	const uint8_t MBC1_RAM_CODE = 0x02;
-	const uint8_t MBC1_RAM_BATTERY_CODE = 0x03;
-	const uint8_t MBC2_CODE = 0x05;
-	const uint8_t MBC2_BATTERY_CODE = 0x06;
-	const uint8_t ROM_RAM_CODE = 0x08;
-	const uint8_t ROM_RAM_BATTERY_CODE = 0x09;
-	const uint8_t MMM01_CODE = 0x0B;
-	const uint8_t MMM01_RAM_CODE = 0x0C;
-	const uint8_t MMM01_RAM_BATTERY_CODE = 0x0D;
-	const uint8_t MBC3_TIMER_BATTERY_CODE = 0x0F;
-	const uint8_t MBC3_TIMER_RAM_BATTERY_CODE = 0x10;
-	const uint8_t MBC3_CODE = 0x11;
-	const uint8_t MBC3_RAM_CODE = 0x12;
-	const uint8_t MBC3_RAM_BATTERY_CODE = 0x13;
-	const uint8_t MBC5_CODE = 0x19;
-	const uint8_t MBC5_RAM_CODE = 0x1A;
-	const uint8_t MBC5_RAM_BATTERY_CODE = 0x1B;
-	const uint8_t MBC5_RUMBLE_CODE = 0x1C;
-	const uint8_t MBC5_RUMBLE_RAM_CODE = 0x1D;
-	const uint8_t MBC5_RUMBLE_RAM_BATTERY_CODE = 0x1E;
-	const uint8_t MBC6_CODE = 0x20;
-	const uint8_t MBC7_SENSOR_RUMBLE_RAM_BATTERY_CODE = 0x22;
-	const uint8_t HuC3_CODE = 0xFE;
-	const uint8_t HuC1_RAM_BATTERY_CODE = 0xFF;
-
-	// Catridge header RAM type codes
-
-	const uint8_t NO_RAM_CODE = 0x00; // No RAM
-	const uint8_t UNUSED_RAM_CODE = 0x01; // Unused
-	const uint8_t RAM_8KB_CODE = 0x02; // 1 bank
-	const uint8_t RAM_32KB_CODE = 0x03; // 4 banks of 8 KiB each 
-	const uint8_t RAM_128KB_CODE = 0x04; // 16 banks of 8 KiB each 
-	const uint8_t RAM_64KB_CODE = 0x05; // 8 banks of 8 KiB each
-
-	// Catridge header ROM type codes
-
-	const uint8_t ROM_32KB_CODE = 0x00; // 2 banks of 16 KiB each
-	const uint8_t ROM_64KB_CODE = 0x01; // 4 banks of 16 KiB each
-	const uint8_t ROM_128KB_CODE = 0x02; // 8 banks of 16 KiB each
-	const uint8_t ROM_256KB_CODE = 0x03; // 16 banks of 16 KiB each
-	const uint8_t ROM_512KB_CODE = 0x04; // 32 banks of 16 KiB each
-	const uint8_t ROM_1MB_CODE = 0x05; // 64 banks of 16 KiB each
-	const uint8_t ROM_2MB_CODE = 0x06; // 128 banks of 16 KiB each
-	const uint8_t ROM_4MB_CODE = 0x07; // 256 banks of 16 KiB each
-	const uint8_t ROM_8MB_CODE = 0x08; // 512 banks of 16 KiB each
-
 	// Additional addresses
 	const uint16_t OPTIONAL_8KB_RAM_START_ADDRESS = 0xA000;
 	const uint16_t OPTIONAL_8KB_RAM_END_ADDRESS = 0xBFFF;
 
-	const std::array<uint8_t, 48> LOGO_BITMAP =
+	Cartridge::~Cartridge()
 	{
-		 0xCE, 0xED, 0x66, 0x66, 0xCC, 0x0D, 0x00, 0x0B, 0x03, 0x73, 0x00, 0x83, 0x00, 0x0C, 0x00, 0x0D,
-		0x00, 0x08, 0x11, 0x1F, 0x88, 0x89, 0x00, 0x0E, 0xDC, 0xCC, 0x6E, 0xE6, 0xDD, 0xDD, 0xD9, 0x99,
-		0xBB, 0xBB, 0x67, 0x63, 0x6E, 0x0E, 0xEC, 0xCC, 0xDD, 0xDC, 0x99, 0x9F, 0xBB, 0xB9, 0x33, 0x3E
-	};
+		SaveRTC();
+	}
 
 	bool Cartridge::Load(const std::string& romFilePath)
 	{
-		std::string relativeSavedDataPath = std::filesystem::path(romFilePath).filename().replace_extension(".sav").string();
+		// The clock of the cartridge being replaced goes to its own saved data file.
+		SaveRTC();
+		UpdateSavedDataPath(romFilePath);
 
-		switch (savedDataSearchType)
-		{
-		case SavedDataSearchType::ROM_DIRECTORY:
-			// Append the relative saved data path to the ROM directory path.
-			savedDataPath = (std::filesystem::path(romFilePath).parent_path() / relativeSavedDataPath).string();
-			break;
-		case SavedDataSearchType::EMULATOR_DIRECTORY:
-		{
-			std::filesystem::path savedDataDir = std::filesystem::current_path() / "Saved-Data";
+		// Instances running the same game share its ROM, so loading it again doesn't read the file.
+		auto image = ROMCache::LoadFile(romFilePath);
 
-			if (!std::filesystem::exists(savedDataDir))
-			{
-				Logger::WriteInfo("Creating saved directory: " + savedDataDir.string());
-				std::filesystem::create_directory(savedDataDir);
-			}
+		if (image == nullptr || !Load(image))
+			return false;
 
-			// Append the relative saved data path to the saved data dir.
-			savedDataPath = (savedDataDir / relativeSavedDataPath).string();
-			break;
-		}
-		}
+		ROMIndex::Add(romFilePath, GetROMHash(), header);
+		return true;
+	}
 
-		auto file = std::ifstream(romFilePath, std::ios::binary);
+	bool Cartridge::Load(const uint8_t* data, size_t size, const std::string& romName)
+	{
+		SaveRTC();
+		UpdateSavedDataPath(romName);
 
-		if (!file.is_open())
-			return false;
+		std::vector<uint8_t> romData;
 
-		// Load the ROM file into a vector of bytes.
-		auto romData = std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+		if (Decompression::IsArchive(data, size))
+		{
+			if (!Decompression::ExtractROM(data, size, romData))
+				return false;
+		}
+		else
+		{
+			romData.assign(data, data + size);
+		}
 
-		return Load(romData);
+		return Load(ROMCache::Acquire(std::move(romData)));
 	}
 
-	bool Cartridge::Load(const std::vector<uint8_t>& romData)
+	bool Cartridge::Load(std::shared_ptr<const ROMImage> image)
 	{
-		if (romData.size() < HEADER_SIZE_IN_BYTES)
+		CartridgeHeader parsedHeader;
+
+		if (!CartridgeHeader::Parse(image->data, parsedHeader, isGlobalChecksumVerificationEnabled))
 			return false;
 
-		romTitle.clear();
-		for (uint32_t address = 0; address < romData.size(); address++)
-		{
-			if (address >= TITLE_START_ADDRESS && address <= TITLE_END_ADDRESS)
-			{
-				romTitle += (char)romData[address];
-			}
-			else if (address >= LOGO_START_ADDRESS && address <= LOGO_END_ADDRESS)
-			{
-				// If the ROM does not contain the correct bitmap data for the logo,
-				// then the ROM should be considered invalid.
-				if (LOGO_BITMAP.at(address - LOGO_START_ADDRESS) != romData[address])
-					return false;
-			}
-			else if (address == CARTRIDGE_TYPE_ADDRESS)
-			{
-				InitializeMemoryBankController(romData[address]);
-			}
-			else if (address == ROM_SIZE_ADDRESS)
-			{
-				DecodeROMSize(romData[address]);
-			}
-			else if (address == RAM_SIZE_ADDRESS)
-			{
-				InitializeRAM(romData[address]);
-			}
-		}
+		// If the ROM does not contain the correct bitmap data for the logo,
+		// then the ROM should be considered invalid.
+		if (!parsedHeader.isLogoValid)
+			return false;
+
+		if (!parsedHeader.isHeaderChecksumValid)
+			Logger::WriteWarning("The header checksum is wrong, the ROM may be corrupted.", CARTRIDGE_LOG_HEADER);
+
+		if (parsedHeader.isGlobalChecksumVerified && !parsedHeader.isGlobalChecksumValid)
+			Logger::WriteWarning("The global checksum is wrong, the ROM may be corrupted.", CARTRIDGE_LOG_HEADER);
+
+		header = parsedHeader;
+		InitializeMemoryBankController(header.cartridgeType);
+		InitializeRAM(header.GetRAMSize());
+
+		// Display the ROM size (in KiB) for debugging purposes
+		Logger::WriteInfo("Cartridge ROM available:  " + std::to_string(header.GetROMSize() / KiB) + " KiB", CARTRIDGE_LOG_HEADER);
 
-		rom = romData;
-		Logger::WriteInfo("ROM Title: " + std::string(romTitle.c_str()), CARTRIDGE_LOG_HEADER);
+		romImage = std::move(image);
+		rom = romImage->data;
+		areSavedDataWritesSuspended = false;
+		Logger::WriteInfo("ROM Title: " + std::string(header.title.c_str()), CARTRIDGE_LOG_HEADER);
 
 		// Attach ROM and RAM to the memory bank controller.
 		if (memoryBankController != nullptr)
@@ -180,10 +98,11 @@ namespace ModestGB
 				Logger::WriteInfo("Attaching RAM to MBC", CARTRIDGE_LOG_HEADER);
 				memoryBankController->AttachRAM(ram);
 				memoryBankController->SetRAMWriteCallback(std::bind(&Cartridge::OnRAMWrite, this, std::placeholders::_1, std::placeholders::_2));
+			}
 
-				// Load saved RAM data (if any), from the saved data path.
+			// Load saved RAM data and the real-time clock (if any), from the saved data path.
+			if (GetRAMSize() > 0 || hasRTC)
 				OpenSavedDataFile();
-			}
 
 			if (GetROMSize() > 0)
 			{
@@ -197,21 +116,154 @@ namespace ModestGB
 		return true;
 	}
 
+	void Cartridge::UpdateSavedDataPath(const std::string& romFilePath)
+	{
+		std::filesystem::path romFileName = std::filesystem::path(romFilePath).filename();
+
+		// "Game.gb.gz" shares its saved data with "Game.gb".
+		if (romFileName.extension() == ".gz")
+			romFileName = romFileName.stem();
+
+		std::string relativeSavedDataPath = romFileName.replace_extension(".sav").string();
+
+		switch (savedDataSearchType)
+		{
+		case SavedDataSearchType::ROM_DIRECTORY:
+			// Append the relative saved data path to the ROM directory path.
+			savedDataPath = (std::filesystem::path(romFilePath).parent_path() / relativeSavedDataPath).string();
+			break;
+		case SavedDataSearchType::EMULATOR_DIRECTORY:
+		{
+			std::filesystem::path savedDataDir = std::filesystem::current_path() / "Saved-Data";
+
+			if (!std::filesystem::exists(savedDataDir))
+			{
+				Logger::WriteInfo("Creating saved directory: " + savedDataDir.string());
+				std::filesystem::create_directory(savedDataDir);
+			}
+
+			// Append the relative saved data path to the saved data dir.
+			savedDataPath = (savedDataDir / relativeSavedDataPath).string();
+			break;
+		}
+		}
+	}
+
 	void Cartridge::Reset()
 	{
+		SaveRTC();
 		isROMLoaded = false;
+		hasRTC = false;
 
 		memoryBankController.reset();
 		memoryBankControllerType = MemoryBankControllerType::None;
 
-		ram.clear();
-		rom.clear();
-		romTitle.clear();
+		ram = PagedBuffer();
+		romImage.reset();
+		rom = {};
+		header = CartridgeHeader();
+	}
+
+	void Cartridge::Serialize(StateWriter& writer) const
+	{
+		writer.Write(header.title);
+		writer.Write(static_cast<uint32_t>(rom.size()));
+		writer.Write(header.headerChecksum);
+
+		// Stored in the order of the header, which is big-endian.
+		writer.Write(static_cast<uint8_t>(header.globalChecksum >> 8));
+		writer.Write(static_cast<uint8_t>(header.globalChecksum & 0xFF));
+
+		writer.Write(ram);
+
+		if (memoryBankController != nullptr)
+			memoryBankController->Serialize(writer);
+	}
+
+	void Cartridge::Deserialize(StateReader& reader)
+	{
+		std::string stateROMTitle;
+		reader.Read(stateROMTitle);
+		bool isSameROM = stateROMTitle == header.title && reader.Read<uint32_t>() == rom.size();
+		isSameROM &= reader.Read<uint8_t>() == header.headerChecksum;
+		isSameROM &= reader.Read<uint8_t>() == (header.globalChecksum >> 8);
+		isSameROM &= reader.Read<uint8_t>() == (header.globalChecksum & 0xFF);
+
+		bool hasReaderFailed = reader.HasFailed();
+
+		// The saved data file is only updated by later writes to the RAM. Rewriting the whole file on every 
+		// load would make restoring states (which can happen many times per second) needlessly slow. 
+		// A RAM of a different size also means the state was made with a different ROM.
+		if (isSameROM)
+			reader.Read(ram);
+
+		if (!isSameROM || reader.HasFailed())
+		{
+			if (!hasReaderFailed)
+				Logger::WriteError("The save state was made with a different ROM (" + stateROMTitle + ").", CARTRIDGE_LOG_HEADER);
+
+			reader.Fail();
+			return;
+		}
+
+		if (memoryBankController != nullptr)
+			memoryBankController->Deserialize(reader);
+	}
+
+	void Cartridge::Tick(uint32_t cycles)
+	{
+		if (hasRTC)
+			memoryBankController->Tick(cycles);
+	}
+
+	const std::string& Cartridge::GetSavedDataPath() const
+	{
+		return savedDataPath;
+	}
+
+	void Cartridge::SetSavedDataWritesSuspended(bool isSuspended)
+	{
+		areSavedDataWritesSuspended = isSuspended;
+	}
+
+	bool Cartridge::AreSavedDataWritesSuspended() const
+	{
+		return areSavedDataWritesSuspended;
+	}
+
+	void Cartridge::SetRTCWallClockCatchUpEnabled(bool isEnabled)
+	{
+		isRTCWallClockCatchUpEnabled = isEnabled;
+	}
+
+	bool Cartridge::IsRTCWallClockCatchUpEnabled() const
+	{
+		return isRTCWallClockCatchUpEnabled;
+	}
+
+	void Cartridge::SetGlobalChecksumVerificationEnabled(bool isEnabled)
+	{
+		isGlobalChecksumVerificationEnabled = isEnabled;
+	}
+
+	bool Cartridge::IsGlobalChecksumVerificationEnabled() const
+	{
+		return isGlobalChecksumVerificationEnabled;
 	}
 
 	const std::string& Cartridge::GetROMTitle() const
 	{
-		return romTitle;
+		return header.title;
+	}
+
+	const CartridgeHeader& Cartridge::GetHeader() const
+	{
+		return header;
+	}
+
+	uint64_t Cartridge::GetROMHash() const
+	{
+		return romImage != nullptr ? romImage->hash : 0;
 	}
 
 	void Cartridge::SetSavedDataSearchType(SavedDataSearchType searchType)
@@ -234,10 +286,10 @@ namespace ModestGB
 		switch (memoryBankControllerType)
 		{
 		case MemoryBankControllerType::None:
-			if (ram.size() > 0 && IsRAMAddress(address))
+			if (ram.GetSize() > 0 && IsRAMAddress(address))
 			{
 				// Normalize the address to the range [0, RAM_SIZE].
-				return ram[address - OPTIONAL_8KB_RAM_START_ADDRESS];
+				return ram.Read(address - OPTIONAL_8KB_RAM_START_ADDRESS);
 			}
 
 			return rom[address];
@@ -253,11 +305,11 @@ namespace ModestGB
 		switch (memoryBankControllerType)
 		{
 		case MemoryBankControllerType::None:
-			if (ram.size() > 0 && IsRAMAddress(address))
+			if (ram.GetSize() > 0 && IsRAMAddress(address))
 			{
 				// Normalize the address to the range [0, RAM_SIZE].
 				uint16_t normalizedAddress = address - OPTIONAL_8KB_RAM_START_ADDRESS;
-				ram[normalizedAddress] = value;
+				ram.Write(normalizedAddress, value);
 			}
 			break;
 		default:
@@ -275,7 +327,7 @@ namespace ModestGB
 
 	uint32_t Cartridge::GetRAMSize()
 	{
-		return static_cast<uint32_t>(ram.size());
+		return static_cast<uint32_t>(ram.GetSize());
 	}
 
 	MemoryBankControllerType Cartridge::GetMemoryBankControllerType()
@@ -283,40 +335,9 @@ namespace ModestGB
 		return memoryBankControllerType;
 	}
 
-	void Cartridge::DecodeROMSize(uint8_t byte)
+	void Cartridge::InitializeRAM(uint32_t ramSize)
 	{
-		// Calculation reference: https://gbdev.io/pandocs/#the-cartridge-header
-		uint32_t romSize = (32 << byte) * KiB;
-
-		// Display the ROM size (in KiB) for debugging purposes
-		uint16_t romSizeKB = static_cast<uint16_t>(romSize / (float)KiB);
-		Logger::WriteInfo("Cartridge ROM available:  " + std::to_string(romSizeKB) + " KiB", CARTRIDGE_LOG_HEADER);
-	}
-
-	void Cartridge::InitializeRAM(uint8_t byte)
-	{
-		uint32_t ramSize = 0;
-
-		switch (byte)
-		{
-		case NO_RAM_CODE:
-		case UNUSED_RAM_CODE:
-			break;
-		case RAM_8KB_CODE:
-			ramSize = 8 * KiB;
-			break;
-		case RAM_32KB_CODE:
-			ramSize = 32 * KiB;
-			break;
-		case RAM_128KB_CODE:
-			ramSize = 128 * KiB;
-			break;
-		case RAM_64KB_CODE:
-			ramSize = 64 * KiB;
-			break;
-		}
-
-		ram = std::vector<uint8_t>(ramSize);
+		ram = PagedBuffer(ramSize);
 
 		// Display the RAM size (in KiB) for debugging purposes.
 		uint16_t ramSizeKB = static_cast<uint16_t>(ramSize / (float)KiB);
@@ -325,6 +346,8 @@ namespace ModestGB
 
 	void Cartridge::InitializeMemoryBankController(uint8_t byte)
 	{
+		hasRTC = header.HasRTC();
+
 		switch (byte)
 		{
 		case ROM_ONLY_CODE:
@@ -364,7 +387,7 @@ namespace ModestGB
 		case MBC3_CODE:
 		case MBC3_RAM_CODE:
 		case MBC3_RAM_BATTERY_CODE:
-			memoryBankController = std::unique_ptr<MemoryBankController>(new MBC3());
+			memoryBankController = std::unique_ptr<MemoryBankController>(new MBC3(hasRTC));
 			memoryBankControllerType = MemoryBankControllerType::MBC3;
 			Logger::WriteInfo("Cartridge type: 'MBC3'", CARTRIDGE_LOG_HEADER);
 			break;
@@ -432,20 +455,52 @@ namespace ModestGB
 		Logger::WriteInfo("Saved data will be stored at: " + savedDataPath, CARTRIDGE_LOG_HEADER);
 
 		int count = 0;
-		while (!savedDataStream.eof() && count < ram.size())
+		while (!savedDataStream.eof() && count < ram.GetSize())
 		{
 			char byteBuffer[1];
 			savedDataStream.read(byteBuffer, 1);
-			ram[count] = static_cast<uint8_t>(byteBuffer[0]);
+			ram.Write(count, static_cast<uint8_t>(byteBuffer[0]));
 
 			count++;
 		}
 
 		savedDataStream.clear();
+
+		// The real-time clock is stored right after the RAM.
+		if (hasRTC)
+		{
+			savedDataStream.seekg(0, std::ios::end);
+			std::streamoff fileSize = savedDataStream.tellg();
+			std::vector<uint8_t> rtcData(fileSize > static_cast<std::streamoff>(ram.GetSize()) ? static_cast<size_t>(fileSize) - ram.GetSize() : 0);
+
+			savedDataStream.seekg(ram.GetSize());
+			savedDataStream.read(reinterpret_cast<char*>(rtcData.data()), rtcData.size());
+			savedDataStream.clear();
+
+			if (!rtcData.empty() && !memoryBankController->LoadRTC(rtcData, isRTCWallClockCatchUpEnabled))
+				Logger::WriteWarning("The real-time clock in the saved data file has an unknown format, it has been reset.", CARTRIDGE_LOG_HEADER);
+		}
+	}
+
+	void Cartridge::SaveRTC()
+	{
+		// The clock changes every second, so it's only written when the cartridge is unloaded.
+		if (!isROMLoaded || !hasRTC || areSavedDataWritesSuspended || !savedDataStream.is_open())
+			return;
+
+		std::vector<uint8_t> rtcData;
+		memoryBankController->SaveRTC(rtcData);
+
+		savedDataStream.seekp(ram.GetSize());
+		savedDataStream.write(reinterpret_cast<const char*>(rtcData.data()), rtcData.size());
+		savedDataStream.flush();
 	}
 
 	void Cartridge::OnRAMWrite(uint16_t address, uint8_t value)
 	{
+		if (areSavedDataWritesSuspended)
+			return;
+
 		savedDataStream.seekp(address);
 
 		char outByte = static_cast<char>(value);
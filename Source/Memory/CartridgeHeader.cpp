@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <array>
+#include "Memory/CartridgeHeader.hpp"
+#include "Utils/MemoryUtils.hpp"
+
+namespace ModestGB
+{
+	// Title - The title of the ame in upper case ASCII.
+	const uint16_t TITLE_START_ADDRESS = 0x0134;
+	const uint16_t TITLE_END_ADDRESS = 0x0143;
+
+	// CGB Flag - The upper bit of this byte is uused to enable Game Boy Color functions. 
+	// In older cartridges, this is a part of the title data.
+	const uint16_t CGB_FLAG_ADDRESS = 0x0143;
+
+	// SGB Flag - Specifies whether the game supports Super Game Boy functions. 
+	const uint16_t SGB_FLAG_ADDRESS = 0x0146;
+
+	// Cartridge Type - Indicates which Memory Bank Controller (if any) is used, and if other external hardware exists.
+	const uint16_t CARTRIDGE_TYPE_ADDRESS = 0x0147;
+
+	// ROM Size - Size of the ROM. Generally calculated as "32 KiB << ROM_SIZE_CODE".
+	const uint16_t ROM_SIZE_ADDRESS = 0x0148;
+
+	// RAM Size - Size of external RAM (if any).
+	const uint16_t RAM_SIZE_ADDRESS = 0x0149;
+
+	const uint16_t LOGO_START_ADDRESS = 0x104;
+	const uint16_t LOGO_END_ADDRESS = 0x133;
+
+	// Header Checksum - Checksum of the header bytes 0x0134 - 0x014C.
+	const uint16_t HEADER_CHECKSUM_ADDRESS = 0x014D;
+
+	// Global Checksum - 16 bit checksum of the entire ROM (excluding these two bytes).
+	const uint16_t GLOBAL_CHECKSUM_START_ADDRESS = 0x014E;
+	const uint16_t GLOBAL_CHECKSUM_END_ADDRESS = 0x014F;
+
+	const uint16_t HEADER_CHECKSUM_START_ADDRESS = TITLE_START_ADDRESS;
+	const uint16_t HEADER_CHECKSUM_END_ADDRESS = 0x014C;
+
+	const std::array<uint8_t, 48> LOGO_BITMAP =
+	{
+		 0xCE, 0xED, 0x66, 0x66, 0xCC, 0x0D, 0x00, 0x0B, 0x03, 0x73, 0x00, 0x83, 0x00, 0x0C, 0x00, 0x0D,
+		0x00, 0x08, 0x11, 0x1F, 0x88, 0x89, 0x00, 0x0E, 0xDC, 0xCC, 0x6E, 0xE6, 0xDD, 0xDD, 0xD9, 0x99,
+		0xBB, 0xBB, 0x67, 0x63, 0x6E, 0x0E, 0xEC, 0xCC, 0xDD, 0xDC, 0x99, 0x9F, 0xBB, 0xB9, 0x33, 0x3E
+	};
+
+	const uint16_t CartridgeHeader::MIN_ROM_SIZE = GLOBAL_CHECKSUM_END_ADDRESS + 1;
+
+	bool CartridgeHeader::Parse(std::span<const uint8_t> rom, CartridgeHeader& header, bool shouldVerifyGlobalChecksum)
+	{
+		header = CartridgeHeader();
+
+		if (rom.size() < MIN_ROM_SIZE)
+			return false;
+
+		header.title.assign(reinterpret_cast<const char*>(&rom[TITLE_START_ADDRESS]), TITLE_END_ADDRESS - TITLE_START_ADDRESS + 1);
+		header.cartridgeType = rom[CARTRIDGE_TYPE_ADDRESS];
+		header.romSizeCode = rom[ROM_SIZE_ADDRESS];
+		header.ramSizeCode = rom[RAM_SIZE_ADDRESS];
+		header.headerChecksum = rom[HEADER_CHECKSUM_ADDRESS];
+		header.globalChecksum = static_cast<uint16_t>((rom[GLOBAL_CHECKSUM_START_ADDRESS] << 8) | rom[GLOBAL_CHECKSUM_END_ADDRESS]);
+
+		header.isLogoValid = std::equal(LOGO_BITMAP.begin(), LOGO_BITMAP.end(), rom.begin() + LOGO_START_ADDRESS);
+
+		uint8_t computedHeaderChecksum = 0;
+		for (uint16_t address = HEADER_CHECKSUM_START_ADDRESS; address <= HEADER_CHECKSUM_END_ADDRESS; address++)
+			computedHeaderChecksum = static_cast<uint8_t>(computedHeaderChecksum - rom[address] - 1);
+
+		header.isHeaderChecksumValid = computedHeaderChecksum == header.headerChecksum;
+
+		if (shouldVerifyGlobalChecksum)
+		{
+			// The sum of every byte of the ROM except the checksum itself.
+			uint16_t computedGlobalChecksum = 0;
+			for (size_t address = 0; address < rom.size(); address++)
+			{
+				if (address != GLOBAL_CHECKSUM_START_ADDRESS && address != GLOBAL_CHECKSUM_END_ADDRESS)
+					computedGlobalChecksum += rom[address];
+			}
+
+			header.isGlobalChecksumVerified = true;
+			header.isGlobalChecksumValid = computedGlobalChecksum == header.globalChecksum;
+		}
+
+		return true;
+	}
+
+	uint32_t CartridgeHeader::GetROMSize() const
+	{
+		// Calculation reference: https://gbdev.io/pandocs/#the-cartridge-header
+		return romSizeCode <= ROM_8MB_CODE ? (32 << romSizeCode) * KiB : 0;
+	}
+
+	uint32_t CartridgeHeader::GetRAMSize() const
+	{
+		switch (ramSizeCode)
+		{
+		case RAM_8KB_CODE:
+			return 8 * KiB;
+		case RAM_32KB_CODE:
+			return 32 * KiB;
+		case RAM_128KB_CODE:
+			return 128 * KiB;
+		case RAM_64KB_CODE:
+			return 64 * KiB;
+		default:
+			return 0;
+		}
+	}
+
+	MemoryBankControllerType CartridgeHeader::GetMemoryBankControllerType() const
+	{
+		switch (cartridgeType)
+		{
+		case MBC1_CODE:
+		case MBC1_RAM_CODE:
+		case MBC1_RAM_BATTERY_CODE:
+			return MemoryBankControllerType::MBC1;
+		case MBC2_CODE:
+		case MBC2_BATTERY_CODE:
+			return MemoryBankControllerType::MBC2;
+		case MMM01_CODE:
+		case MMM01_RAM_CODE:
+		case MMM01_RAM_BATTERY_CODE:
+			return MemoryBankControllerType::MMM01;
+		case MBC3_TIMER_BATTERY_CODE:
+		case MBC3_TIMER_RAM_BATTERY_CODE:
+		case MBC3_CODE:
+		case MBC3_RAM_CODE:
+		case MBC3_RAM_BATTERY_CODE:
+			return MemoryBankControllerType::MBC3;
+		case MBC5_CODE:
+		case MBC5_RAM_CODE:
+		case MBC5_RAM_BATTERY_CODE:
+		case MBC5_RUMBLE_CODE:
+		case MBC5_RUMBLE_RAM_CODE:
+		case MBC5_RUMBLE_RAM_BATTERY_CODE:
+			return MemoryBankControllerType::MBC5;
+		case MBC6_CODE:
+			return MemoryBankControllerType::MBC6;
+		case MBC7_SENSOR_RUMBLE_RAM_BATTERY_CODE:
+			return MemoryBankControllerType::MBC7;
+		case HuC3_CODE:
+			return MemoryBankControllerType::HuC3;
+		case HuC1_RAM_BATTERY_CODE:
+			return MemoryBankControllerType::HuC1;
+		default:
+			return MemoryBankControllerType::None;
+		}
+	}
+
+	bool CartridgeHeader::HasRTC() const
+	{
+		return cartridgeType == MBC3_TIMER_BATTERY_CODE || cartridgeType == MBC3_TIMER_RAM_BATTERY_CODE;
+	}
+}
\ No newline at end of file
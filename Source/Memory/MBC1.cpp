@@ -101,12 +101,12 @@ namespace ModestGB
 	uint8_t MBC1::GetAdjustedROMBankNumber(uint8_t romBankNumber) const
 	{
 		// For 1 MiB or greater cartridges, the RAM bank number is used as the upper 2 bits of the ROM bank number.
-		if (rom->size() >= MiB)
+		if (rom.size() >= MiB)
 			romBankNumber |= (ramBankNumber << 5);
 
 		// Determine the number of bits required to address all of the ROM banks. 
 		// For example, a 256 KiB cartridge would require 4 bits to address all 16 of its banks.
-		uint8_t numBitsRequired = static_cast<uint8_t>(std::log2(rom->size() / ROM_BANK_SIZE));
+		uint8_t numBitsRequired = static_cast<uint8_t>(std::log2(rom.size() / ROM_BANK_SIZE));
 
 		uint8_t bitMask = static_cast<uint8_t>(std::pow(2, numBitsRequired) - 1);
 		return romBankNumber &= bitMask;
@@ -114,7 +114,7 @@ namespace ModestGB
 
 	bool MBC1::IsRAMBankingEnabled() const
 	{
-		return ram->size() == 32 * KiB && !isSimpleBankingModeEnabled;
+		return ram->GetSize() == 32 * KiB && !isSimpleBankingModeEnabled;
 	}
 
 	void MBC1::Reset()
@@ -127,4 +127,20 @@ namespace ModestGB
 		isSimpleBankingModeEnabled = true;
 		isRamEnabled = false;
 	}
+
+	void MBC1::Serialize(StateWriter& writer) const
+	{
+		writer.Write(isSimpleBankingModeEnabled);
+		writer.Write(isRamEnabled);
+		writer.Write(romBankNumber);
+		writer.Write(ramBankNumber);
+	}
+
+	void MBC1::Deserialize(StateReader& reader)
+	{
+		reader.Read(isSimpleBankingModeEnabled);
+		reader.Read(isRamEnabled);
+		reader.Read(romBankNumber);
+		reader.Read(ramBankNumber);
+	}
 }
\ No newline at end of file
@@ -1,10 +1,10 @@
 #include <sstream>
-#include <chrono>
 #include "Memory/MBC3.hpp"
 #include "Logger.hpp"
 #include "Utils/DataConversions.hpp"
 #include "Utils/Arithmetic.hpp"
 #include "Utils/SystemTime.hpp"
+#include "Utils/GBSpecs.hpp"
 
 namespace ModestGB
 {
@@ -35,16 +35,46 @@ namespace ModestGB
 	const uint16_t RTC_LOWER_DAY_COUNTER_REGISTER_ADDR = 0x0B;
 	const uint16_t RTC_UPPER_DAY_COUNTER_REGISTER_ADDR = 0x0C;
 
-	MBC3::MBC3()
+	// Indices of the registers in rtcRegisters, in the same order they're selected in.
+	const uint8_t RTC_SECONDS_INDEX = 0;
+	const uint8_t RTC_MINUTES_INDEX = 1;
+	const uint8_t RTC_HOURS_INDEX = 2;
+	const uint8_t RTC_LOWER_DAY_COUNTER_INDEX = 3;
+	const uint8_t RTC_UPPER_DAY_COUNTER_INDEX = 4;
+
+	// Only the bits that exist in hardware are kept.
+	const std::array<uint8_t, 5> RTC_REGISTER_MASKS = { 0x3F, 0x3F, 0x1F, 0xFF, 0xC1 };
+
+	const uint8_t RTC_DAY_COUNTER_UPPER_BIT = 0b00000001;
+	const uint8_t RTC_HALT_BIT = 0b01000000;
+	const uint8_t RTC_DAY_COUNTER_CARRY_BIT = 0b10000000;
+	const uint16_t RTC_MAX_DAY_COUNTER = 511;
+	const uint32_t SECONDS_PER_DAY = 24 * 60 * 60;
+
+	const size_t RTC_SAVED_DATA_SIZE = 48;
+	const size_t RTC_LEGACY_SAVED_DATA_SIZE = 44;
+	const size_t RTC_LATCHED_REGISTERS_OFFSET = 20;
+	const size_t RTC_TIMESTAMP_OFFSET = 40;
+
+	// The saved clock stores every value in little endian, regardless of the host.
+	void WriteLittleEndian(std::vector<uint8_t>& data, size_t offset, uint64_t value, size_t size)
+	{
+		for (size_t i = 0; i < size; i++)
+			data[offset + i] = static_cast<uint8_t>(value >> (i * 8));
+	}
+
+	uint64_t ReadLittleEndian(const std::vector<uint8_t>& data, size_t offset, size_t size)
+	{
+		uint64_t value = 0;
+
+		for (size_t i = 0; i < size; i++)
+			value |= static_cast<uint64_t>(data[offset + i]) << (i * 8);
+
+		return value;
+	}
+
+	MBC3::MBC3(bool hasRTC) : hasRTC(hasRTC)
 	{
-		rtcRegisters =
-		{
-			{ 0x08, 0 },
-			{ 0x09, 0 },
-			{ 0x0A, 0 },
-			{ 0x0B, 0 },
-			{ 0x0C, 0 },
-		};
 	}
 
 	std::string MBC3::GetName() const
@@ -65,17 +95,23 @@ namespace ModestGB
 		}
 		else if (address >= RAM_SWITCHABLE_BANK_START_ADDR && address <= RAM_SWITCHABLE_BANK_END_ADDR)
 		{
-			if (ram == nullptr || !isRAMAndRTCEnabled)
+			// Cartridges with a clock but no RAM (MBC3+TIMER+BATTERY) still map the clock registers here.
+			if (!isRAMAndRTCEnabled)
 				return 0;
 
 			if (isSimpleRAMBankingMode)
 			{
+				if (ram == nullptr)
+					return 0;
+
 				return ReadFromRAM((address - RAM_SWITCHABLE_BANK_START_ADDR) + (RAM_BANK_SIZE * ramBankNumber));
 			}
-			else
+			else if (hasRTC && Arithmetic::IsInRange(ramBankNumber, RTC_SECONDS_REGISTER_ADDR, RTC_UPPER_DAY_COUNTER_REGISTER_ADDR))
 			{
-				return rtcRegisters.at(ramBankNumber);
+				return latchedRTCRegisters[ramBankNumber - RTC_SECONDS_REGISTER_ADDR];
 			}
+
+			return 0xFF;
 		}
 
 		return 0;
@@ -90,16 +126,24 @@ namespace ModestGB
 		}
 		else if (address >= RAM_SWITCHABLE_BANK_START_ADDR && address <= RAM_SWITCHABLE_BANK_END_ADDR)
 		{
-			if (ram == nullptr || !isRAMAndRTCEnabled)
+			if (!isRAMAndRTCEnabled)
 				return;
 
 			if (isSimpleRAMBankingMode)
 			{
-				WriteToRAM((address - RAM_SWITCHABLE_BANK_START_ADDR) + (RAM_BANK_SIZE * ramBankNumber), value);
+				if (ram != nullptr)
+					WriteToRAM((address - RAM_SWITCHABLE_BANK_START_ADDR) + (RAM_BANK_SIZE * ramBankNumber), value);
 			}
-			else
+			else if (hasRTC && Arithmetic::IsInRange(ramBankNumber, RTC_SECONDS_REGISTER_ADDR, RTC_UPPER_DAY_COUNTER_REGISTER_ADDR))
 			{
-				rtcRegisters[ramBankNumber] = value;
+				// The write goes to the counter itself, and shows up in the latched copy so the game reads back what it wrote.
+				uint8_t index = ramBankNumber - RTC_SECONDS_REGISTER_ADDR;
+				rtcRegisters[index] = value & RTC_REGISTER_MASKS[index];
+				latchedRTCRegisters[index] = rtcRegisters[index];
+
+				// Writing to the seconds resets the divider that counts up to the next second.
+				if (index == RTC_SECONDS_INDEX)
+					rtcCycles = 0;
 			}
 		}
 		else if (address >= ROM_BANK_NUMBER_START_ADDR && address <= ROM_BANK_NUMBER_END_ADDR)
@@ -125,19 +169,18 @@ namespace ModestGB
 		}
 		else if (address >= LATCH_CLOCK_DATA_START_ADDR && address <= LATCH_CLOCK_DATA_END_ADDR)
 		{
-			// TODO: Day counter is not implemented.
+			// Writing $00 then $01 copies the counters to the latched registers.
 			if (value == 0)
 			{
 				isLatchingReady = true;
 			}
-			else if (value == 1)
+			else if (value == 1 && isLatchingReady)
+			{
+				latchedRTCRegisters = rtcRegisters;
+				isLatchingReady = false;
+			}
+			else
 			{
-				SystemTime::DateTime currentTime = SystemTime::GetCurrentTime();
-
-				rtcRegisters[RTC_SECONDS_REGISTER_ADDR] = currentTime.seconds;
-				rtcRegisters[RTC_MINUTES_REGISTER_ADDR] = currentTime.minutes;
-				rtcRegisters[RTC_HOURS_REGISTER_ADDR] = currentTime.hour;
-
 				isLatchingReady = false;
 			}
 		}
@@ -153,13 +196,164 @@ namespace ModestGB
 		isLatchingReady = false;
 		isSimpleRAMBankingMode = false;
 
-		rtcRegisters =
+		rtcCycles = 0;
+		rtcRegisters.fill(0);
+		latchedRTCRegisters.fill(0);
+	}
+
+	void MBC3::Serialize(StateWriter& writer) const
+	{
+		writer.Write(isRAMAndRTCEnabled);
+		writer.Write(isSimpleRAMBankingMode);
+		writer.Write(isLatchingReady);
+		writer.Write(romBankNumber);
+		writer.Write(ramBankNumber);
+		writer.Write(rtcCycles);
+		writer.Write(rtcRegisters);
+		writer.Write(latchedRTCRegisters);
+	}
+
+	void MBC3::Deserialize(StateReader& reader)
+	{
+		reader.Read(isRAMAndRTCEnabled);
+		reader.Read(isSimpleRAMBankingMode);
+		reader.Read(isLatchingReady);
+		reader.Read(romBankNumber);
+		reader.Read(ramBankNumber);
+
+		// Older states only have the registers the game last latched, which were read from the wall clock.
+		if (reader.GetVersion() < 2)
 		{
-			{ 0x08, 0 },
-			{ 0x09, 0 },
-			{ 0x0A, 0 },
-			{ 0x0B, 0 },
-			{ 0x0C, 0 },
-		};
+			reader.Read(latchedRTCRegisters);
+			rtcRegisters = latchedRTCRegisters;
+			rtcCycles = 0;
+			return;
+		}
+
+		reader.Read(rtcCycles);
+		reader.Read(rtcRegisters);
+		reader.Read(latchedRTCRegisters);
+	}
+
+	void MBC3::Tick(uint32_t cycles)
+	{
+		if (!hasRTC || IsRTCHalted())
+			return;
+
+		rtcCycles += cycles;
+
+		if (rtcCycles >= GB_CLOCK_SPEED)
+		{
+			rtcCycles -= GB_CLOCK_SPEED;
+			AdvanceRTCBySecond();
+		}
+	}
+
+	bool MBC3::IsRTCHalted() const
+	{
+		return rtcRegisters[RTC_UPPER_DAY_COUNTER_INDEX] & RTC_HALT_BIT;
+	}
+
+	void MBC3::AdvanceRTCBySecond()
+	{
+		// Each counter carries into the next one when it reaches its limit. A counter the game set past its limit 
+		// counts up to the largest value its bits can hold instead, then wraps to 0 without carrying.
+		uint8_t& seconds = rtcRegisters[RTC_SECONDS_INDEX];
+		seconds = (seconds + 1) & RTC_REGISTER_MASKS[RTC_SECONDS_INDEX];
+		if (seconds != 60)
+			return;
+
+		seconds = 0;
+		uint8_t& minutes = rtcRegisters[RTC_MINUTES_INDEX];
+		minutes = (minutes + 1) & RTC_REGISTER_MASKS[RTC_MINUTES_INDEX];
+		if (minutes != 60)
+			return;
+
+		minutes = 0;
+		uint8_t& hours = rtcRegisters[RTC_HOURS_INDEX];
+		hours = (hours + 1) & RTC_REGISTER_MASKS[RTC_HOURS_INDEX];
+		if (hours != 24)
+			return;
+
+		hours = 0;
+		uint8_t& upperDayCounter = rtcRegisters[RTC_UPPER_DAY_COUNTER_INDEX];
+		uint16_t days = (rtcRegisters[RTC_LOWER_DAY_COUNTER_INDEX] | ((upperDayCounter & RTC_DAY_COUNTER_UPPER_BIT) << 8)) + 1;
+
+		// The carry flag stays set until the game clears it.
+		if (days > RTC_MAX_DAY_COUNTER)
+		{
+			days = 0;
+			upperDayCounter |= RTC_DAY_COUNTER_CARRY_BIT;
+		}
+
+		rtcRegisters[RTC_LOWER_DAY_COUNTER_INDEX] = days & 0xFF;
+		upperDayCounter = (upperDayCounter & ~RTC_DAY_COUNTER_UPPER_BIT) | (days >> 8);
+	}
+
+	void MBC3::AdvanceRTC(uint64_t seconds)
+	{
+		// The counters the game set past their limits are stepped one second at a time until they're back in range, 
+		// which takes a few hours at most. From there, the remaining time is added in one go.
+		while (seconds > 0 && (rtcRegisters[RTC_SECONDS_INDEX] >= 60 || rtcRegisters[RTC_MINUTES_INDEX] >= 60 || rtcRegisters[RTC_HOURS_INDEX] >= 24))
+		{
+			AdvanceRTCBySecond();
+			seconds--;
+		}
+
+		uint8_t& upperDayCounter = rtcRegisters[RTC_UPPER_DAY_COUNTER_INDEX];
+		uint64_t days = rtcRegisters[RTC_LOWER_DAY_COUNTER_INDEX] | ((upperDayCounter & RTC_DAY_COUNTER_UPPER_BIT) << 8);
+		uint64_t totalSeconds = rtcRegisters[RTC_SECONDS_INDEX] + rtcRegisters[RTC_MINUTES_INDEX] * 60 + rtcRegisters[RTC_HOURS_INDEX] * 60 * 60 + days * SECONDS_PER_DAY + seconds;
+
+		days = totalSeconds / SECONDS_PER_DAY;
+		if (days > RTC_MAX_DAY_COUNTER)
+			upperDayCounter |= RTC_DAY_COUNTER_CARRY_BIT;
+
+		days %= RTC_MAX_DAY_COUNTER + 1;
+		rtcRegisters[RTC_SECONDS_INDEX] = totalSeconds % 60;
+		rtcRegisters[RTC_MINUTES_INDEX] = (totalSeconds / 60) % 60;
+		rtcRegisters[RTC_HOURS_INDEX] = (totalSeconds / (60 * 60)) % 24;
+		rtcRegisters[RTC_LOWER_DAY_COUNTER_INDEX] = days & 0xFF;
+		upperDayCounter = (upperDayCounter & ~RTC_DAY_COUNTER_UPPER_BIT) | static_cast<uint8_t>(days >> 8);
+	}
+
+	bool MBC3::HasRTC() const
+	{
+		return hasRTC;
+	}
+
+	void MBC3::SaveRTC(std::vector<uint8_t>& data) const
+	{
+		data.assign(RTC_SAVED_DATA_SIZE, 0);
+
+		for (size_t i = 0; i < rtcRegisters.size(); i++)
+		{
+			WriteLittleEndian(data, i * 4, rtcRegisters[i], 4);
+			WriteLittleEndian(data, RTC_LATCHED_REGISTERS_OFFSET + i * 4, latchedRTCRegisters[i], 4);
+		}
+
+		WriteLittleEndian(data, RTC_TIMESTAMP_OFFSET, static_cast<uint64_t>(SystemTime::GetUnixTime()), 8);
+	}
+
+	bool MBC3::LoadRTC(const std::vector<uint8_t>& data, bool shouldCatchUpWithWallClock)
+	{
+		if (data.size() != RTC_SAVED_DATA_SIZE && data.size() != RTC_LEGACY_SAVED_DATA_SIZE)
+			return false;
+
+		for (size_t i = 0; i < rtcRegisters.size(); i++)
+		{
+			rtcRegisters[i] = ReadLittleEndian(data, i * 4, 4) & RTC_REGISTER_MASKS[i];
+			latchedRTCRegisters[i] = ReadLittleEndian(data, RTC_LATCHED_REGISTERS_OFFSET + i * 4, 4) & RTC_REGISTER_MASKS[i];
+		}
+
+		rtcCycles = 0;
+
+		// The clock keeps running while the emulator is closed, unless the game halted it.
+		int64_t savedTime = static_cast<int64_t>(ReadLittleEndian(data, RTC_TIMESTAMP_OFFSET, data.size() - RTC_TIMESTAMP_OFFSET));
+		int64_t elapsedSeconds = SystemTime::GetUnixTime() - savedTime;
+
+		if (shouldCatchUpWithWallClock && !IsRTCHalted() && elapsedSeconds > 0)
+			AdvanceRTC(static_cast<uint64_t>(elapsedSeconds));
+
+		return true;
 	}
 }
\ No newline at end of file
@@ -98,4 +98,18 @@ namespace ModestGB
 		ramBankNumber = 0;
 		isRamEnabled = false;
 	}
+
+	void MBC5::Serialize(StateWriter& writer) const
+	{
+		writer.Write(isRamEnabled);
+		writer.Write(romBankNumber);
+		writer.Write(ramBankNumber);
+	}
+
+	void MBC5::Deserialize(StateReader& reader)
+	{
+		reader.Read(isRamEnabled);
+		reader.Read(romBankNumber);
+		reader.Read(ramBankNumber);
+	}
 }
\ No newline at end of file
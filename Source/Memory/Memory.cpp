@@ -25,4 +25,10 @@ namespace ModestGB
 	{
 		ChangeBit(address, bitNum, false);
 	}
+
+	void Memory::ReadBlock(uint16_t address, uint8_t* destination, uint16_t length) const
+	{
+		for (uint16_t i = 0; i < length; i++)
+			destination[i] = Read(address + i);
+	}
 }
\ No newline at end of file
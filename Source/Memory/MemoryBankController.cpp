@@ -9,23 +9,22 @@ namespace ModestGB
 	const uint16_t MemoryBankController::ROM_BANK_SIZE = 16 * KiB;
 	const uint16_t MemoryBankController::RAM_BANK_SIZE = 8 * KiB;
 
-	void MemoryBankController::AttachRAM(std::vector<uint8_t>& ram)
+	void MemoryBankController::AttachRAM(PagedBuffer& ram)
 	{
 		this->ram = &ram;
 	}
 
-	void MemoryBankController::AttachROM(std::vector<uint8_t>& rom)
+	void MemoryBankController::AttachROM(std::span<const uint8_t> rom)
 	{
-		this->rom = &rom;
+		this->rom = rom;
 	}
 
 	void MemoryBankController::Reset()
 	{
 		if (ram != nullptr)
-			ram->clear();
+			*ram = PagedBuffer();
 
-		if (rom != nullptr)
-			rom->clear();
+		rom = {};
 	}
 
 	void MemoryBankController::SetRAMWriteCallback(RAMWriteCallback callback)
@@ -33,6 +32,25 @@ namespace ModestGB
 		ramWriteCallback = callback;
 	}
 
+	void MemoryBankController::Tick(uint32_t)
+	{
+	}
+
+	bool MemoryBankController::HasRTC() const
+	{
+		return false;
+	}
+
+	void MemoryBankController::SaveRTC(std::vector<uint8_t>& data) const
+	{
+		data.clear();
+	}
+
+	bool MemoryBankController::LoadRTC(const std::vector<uint8_t>&, bool)
+	{
+		return false;
+	}
+
 	void MemoryBankController::PrintMissingROMMessage() const
 	{
 		Logger::WriteError("Attempted to access ROM data through, but no ROM is attached", GetMessageHeader());
@@ -73,13 +91,13 @@ namespace ModestGB
 			return;
 		}
 
-		if (address >= ram->size())
+		if (address >= ram->GetSize())
 		{
 			PrintInvalidRAMAccesMessage(address);
 			return;
 		}
 
-		(*ram)[address] = value;
+		ram->Write(address, value);
 
 		if (ramWriteCallback)
 			ramWriteCallback(address, value);
@@ -93,47 +111,30 @@ namespace ModestGB
 			return false;
 		}
 
-		if (address >= ram->size())
+		if (address >= ram->GetSize())
 		{
 			PrintInvalidRAMAccesMessage(address);
 			return false;
 		}
 
-		return (*ram)[address];
-	}
-
-	void MemoryBankController::WriteToROM(uint32_t address, uint8_t value)
-	{
-		if (rom == nullptr)
-		{
-			PrintMissingROMMessage();
-			return;
-		}
-
-		if (address >= rom->size())
-		{
-			PrintInvalidROMAccessMessage(address);
-			return;
-		}
-
-		(*rom)[address] = value;
+		return ram->Read(address);
 	}
 
 	uint8_t MemoryBankController::ReadFromROM(uint32_t address) const
 	{
-		if (rom == nullptr)
+		if (rom.empty())
 		{
 			PrintMissingROMMessage();
 			return 0;
 		}
 
-		if (address >= rom->size())
+		if (address >= rom.size())
 		{
 			PrintInvalidROMAccessMessage(address);
 			return 0;
 		}
 
-		return (*rom)[address];
+		return rom[address];
 	}
 
 	std::string MemoryBankController::GetMessageHeader() const
@@ -8,8 +8,18 @@ namespace ModestGB
 {
 	const std::string MEMORY_MAP_LOG_HEADER = "[Memory Map]";
 
+	// What the DMG returns for the unusable region between OAM and the I/O registers.
+	const uint8_t UNUSABLE_MEMORY_READ_VALUE = 0x00;
+
+	// Unmapped I/O addresses, and the unused bits of the mapped ones, read as 1.
+	const uint8_t UNMAPPED_IO_READ_VALUE = 0xFF;
+	const uint8_t SERIAL_TRANSFER_CONTROL_UNUSED_BITS = 0x7E;
+
 	uint8_t MemoryMap::Read(uint16_t address) const
 	{
+		if (ppu->IsDMATransferInProgress() && !IsAccessibleDuringDMATransfer(address))
+			return 0xFF;
+
 		if (Arithmetic::IsInRange(address, GB_IO_REGISTERS_START_ADDRESS, GB_IO_REGISTERS_END_ADDRESS))
 		{
 			return ReadIO(address);
@@ -32,7 +42,8 @@ namespace ModestGB
 		}
 		else if (Arithmetic::IsInRange(address, GB_ECHO_RAM_START_ADDRESS, GB_ECHO_RAM_END_ADDRESS))
 		{
-			return echoRam->Read(Arithmetic::NormalizeAddress(address, GB_ECHO_RAM_START_ADDRESS, GB_ECHO_RAM_END_ADDRESS));
+			// Echo RAM is a mirror of the first 7.5 KiB of WRAM.
+			return wram->Read(address - GB_ECHO_RAM_START_ADDRESS);
 		}
 		else if (address == GB_INTERRUPT_ENABLE_ADDRESS)
 		{
@@ -52,7 +63,7 @@ namespace ModestGB
 		}
 		else if (Arithmetic::IsInRange(address, GB_UNUSABLE_MEMORY_START_ADDRESS, GB_UNUSABLE_MEMORY_END_ADDRESS))
 		{
-			return restrictedMemory->Read(Arithmetic::NormalizeAddress(address, GB_UNUSABLE_MEMORY_START_ADDRESS, GB_UNUSABLE_MEMORY_END_ADDRESS));
+			return UNUSABLE_MEMORY_READ_VALUE;
 		}
 		else
 		{
@@ -63,6 +74,9 @@ namespace ModestGB
 
 	void MemoryMap::Write(uint16_t address, uint8_t value)
 	{
+		if (ppu->IsDMATransferInProgress() && !IsAccessibleDuringDMATransfer(address))
+			return;
+
 		if (Arithmetic::IsInRange(address, GB_IO_REGISTERS_START_ADDRESS, GB_IO_REGISTERS_END_ADDRESS))
 		{
 			WriteIO(address, value);
@@ -86,7 +100,7 @@ namespace ModestGB
 		}
 		else if (Arithmetic::IsInRange(address, GB_ECHO_RAM_START_ADDRESS, GB_ECHO_RAM_END_ADDRESS))
 		{
-			echoRam->Write(Arithmetic::NormalizeAddress(address, GB_ECHO_RAM_START_ADDRESS, GB_ECHO_RAM_END_ADDRESS), value);
+			wram->Write(address - GB_ECHO_RAM_START_ADDRESS, value);
 		}
 		else if (address == GB_INTERRUPT_ENABLE_ADDRESS)
 		{
@@ -106,7 +120,7 @@ namespace ModestGB
 		}
 		else if (Arithmetic::IsInRange(address, GB_UNUSABLE_MEMORY_START_ADDRESS, GB_UNUSABLE_MEMORY_END_ADDRESS))
 		{
-			restrictedMemory->Write(Arithmetic::NormalizeAddress(address, GB_UNUSABLE_MEMORY_START_ADDRESS, GB_UNUSABLE_MEMORY_END_ADDRESS), value);
+			// Writes to the unusable region are ignored.
 		}
 		else
 		{
@@ -114,6 +128,42 @@ namespace ModestGB
 		}
 	}
 
+	void MemoryMap::ReadBlock(uint16_t address, uint8_t* destination, uint16_t length) const
+	{
+		uint16_t endAddress = address + length - 1;
+
+		// Blocks that lie entirely within plain RAM are copied straight from the backing memory, 
+		// anything else (e.g. banked cartridge memory) goes through the regular read path byte by byte.
+		if (Arithmetic::IsInRange(address, GB_WORK_RAM_START_ADDRESS, GB_WORK_RAM_END_ADDRESS) &&
+			Arithmetic::IsInRange(endAddress, GB_WORK_RAM_START_ADDRESS, GB_WORK_RAM_END_ADDRESS))
+		{
+			wram->ReadBlock(Arithmetic::NormalizeAddress(address, GB_WORK_RAM_START_ADDRESS, GB_WORK_RAM_END_ADDRESS), destination, length);
+		}
+		else if (Arithmetic::IsInRange(address, GB_ECHO_RAM_START_ADDRESS, GB_ECHO_RAM_END_ADDRESS) &&
+			Arithmetic::IsInRange(endAddress, GB_ECHO_RAM_START_ADDRESS, GB_ECHO_RAM_END_ADDRESS))
+		{
+			wram->ReadBlock(address - GB_ECHO_RAM_START_ADDRESS, destination, length);
+		}
+		else if (Arithmetic::IsInRange(address, GB_HIGH_RAM_START_ADDRESS, GB_HIGH_RAM_END_ADDRESS) &&
+			Arithmetic::IsInRange(endAddress, GB_HIGH_RAM_START_ADDRESS, GB_HIGH_RAM_END_ADDRESS))
+		{
+			hram->ReadBlock(Arithmetic::NormalizeAddress(address, GB_HIGH_RAM_START_ADDRESS, GB_HIGH_RAM_END_ADDRESS), destination, length);
+		}
+		else
+		{
+			Memory::ReadBlock(address, destination, length);
+		}
+	}
+
+	bool MemoryMap::IsAccessibleDuringDMATransfer(uint16_t address) const
+	{
+		// While an OAM DMA transfer is in progress, the CPU can only reach HRAM. The I/O registers and IE are 
+		// left accessible since the other components (and the DMA register itself) talk to each other through them.
+		return Arithmetic::IsInRange(address, GB_HIGH_RAM_START_ADDRESS, GB_HIGH_RAM_END_ADDRESS) ||
+			Arithmetic::IsInRange(address, GB_IO_REGISTERS_START_ADDRESS, GB_IO_REGISTERS_END_ADDRESS) ||
+			address == GB_INTERRUPT_ENABLE_ADDRESS;
+	}
+
 	void MemoryMap::Reset()
 	{
 		ppu->WriteLY(0);
@@ -150,7 +200,7 @@ namespace ModestGB
 		Write(0xFF42, 0x00);
 		Write(0xFF43, 0x00);
 		Write(0xFF45, 0x00);
-		Write(0xFF46, 0xFF);
+		// $FF46 (DMA) is skipped, writing to it would start an OAM DMA transfer and lock the CPU out of the bus.
 		Write(0xFF47, 0xFC);
 		Write(0xFF48, 0xFF);
 		Write(0xFF49, 0xFF);
@@ -202,16 +252,6 @@ namespace ModestGB
 		this->hram = hram;
 	}
 
-	void MemoryMap::AttachEchoRAM(BasicMemory* echoRam)
-	{
-		this->echoRam = echoRam;
-	}
-
-	void MemoryMap::AttachGenericIO(BasicMemory* ioRegisters)
-	{
-		this->ioRegisters = ioRegisters;
-	}
-
 	void MemoryMap::AttachInterruptEnableRegister(Register8* interruptEnableRegister)
 	{
 		this->interruptEnableRegister = interruptEnableRegister;
@@ -227,17 +267,26 @@ namespace ModestGB
 		this->joypad = joypad;
 	}
 
-	void MemoryMap::AttachRestrictedMemory(BasicMemory* restrictedMem)
+	void MemoryMap::AttachSerialRegisters(Register8* dataRegister, Register8* controlRegister)
 	{
-		restrictedMemory = restrictedMem;
+		serialTransferDataRegister = dataRegister;
+		serialTransferControlRegister = controlRegister;
 	}
 
 	uint8_t MemoryMap::ReadIO(uint16_t address) const
 	{
+		// The APU only runs when its state is observed, so bring it up to date before any of its registers is accessed.
+		if (address >= GB_NR10_ADDRESS && address <= GB_WAVE_PATTERN_RAM_END_ADDRESS)
+			apu->CatchUp();
+
 		switch (address)
 		{
 		case GB_JOYP_ADDRESS:
 			return joypad->Read();
+		case GB_SERIAL_TRANSFER_DATA_ADDRESS:
+			return serialTransferDataRegister->Read();
+		case GB_SERIAL_TRANSFER_CONTROL_ADDRESS:
+			return serialTransferControlRegister->Read() | SERIAL_TRANSFER_CONTROL_UNUSED_BITS;
 		case GB_DIV_ADDRESS:
 			return timer->GetDividerRegister();
 		case GB_TIMA_ADDRESS:
@@ -266,6 +315,12 @@ namespace ModestGB
 			return ppu->ReadWY();
 		case GB_WX_ADDRESS:
 			return ppu->ReadWX();
+		case GB_BACKGROUND_PALETTE_ADDRESS:
+			return ppu->ReadBGP();
+		case GB_SPRITE_PALETTE_0_ADDRESS:
+			return ppu->ReadOBP0();
+		case GB_SPRITE_PALETTE_1_ADDRESS:
+			return ppu->ReadOBP1();
 		case GB_NR10_ADDRESS:
 			return apu->ReadNR10();
 		case GB_NR11_ADDRESS:
@@ -315,20 +370,28 @@ namespace ModestGB
 			}
 			else
 			{
-				// Read from generic I/O memory.
-				return ioRegisters->Read(Arithmetic::NormalizeAddress(address, GB_IO_REGISTERS_START_ADDRESS, GB_IO_REGISTERS_END_ADDRESS));
+				return UNMAPPED_IO_READ_VALUE;
 			}
 		}
 	}
 
 	void MemoryMap::WriteIO(uint16_t address, uint8_t value)
 	{
+		if (address >= GB_NR10_ADDRESS && address <= GB_WAVE_PATTERN_RAM_END_ADDRESS)
+			apu->CatchUp();
+
 		switch (address)
 		{
 		case GB_JOYP_ADDRESS:
 			// The upper 2 bits and the lower 4 bits are read-only.
 			joypad->Write(WriteWithReadOnlyBits(joypad->Read(), value, 0b00110000));
 			break;
+		case GB_SERIAL_TRANSFER_DATA_ADDRESS:
+			serialTransferDataRegister->Write(value);
+			break;
+		case GB_SERIAL_TRANSFER_CONTROL_ADDRESS:
+			serialTransferControlRegister->Write(value & ~SERIAL_TRANSFER_CONTROL_UNUSED_BITS);
+			break;
 		case GB_DIV_ADDRESS:
 			timer->WriteToDividerRegister(value);
 			break;
@@ -372,6 +435,15 @@ namespace ModestGB
 		case GB_WX_ADDRESS:
 			ppu->WriteWX(value);
 			break;
+		case GB_BACKGROUND_PALETTE_ADDRESS:
+			ppu->WriteBGP(value);
+			break;
+		case GB_SPRITE_PALETTE_0_ADDRESS:
+			ppu->WriteOBP0(value);
+			break;
+		case GB_SPRITE_PALETTE_1_ADDRESS:
+			ppu->WriteOBP1(value);
+			break;
 		case GB_NR10_ADDRESS:
 			apu->WriteToNR10(value);
 			break;
@@ -436,15 +508,11 @@ namespace ModestGB
 			apu->WriteToNR52(value);
 			break;
 		default:
+			// Writes to unmapped I/O addresses are ignored.
 			if (address >= GB_WAVE_PATTERN_RAM_START_ADDRESS && address <= GB_WAVE_PATTERN_RAM_END_ADDRESS)
 			{
 				apu->WriteToWavePatternRAM(address, value);
 			}
-			else
-			{
-				// Write to generic I/O memory.
-				ioRegisters->Write(Arithmetic::NormalizeAddress(address, GB_IO_REGISTERS_START_ADDRESS, GB_IO_REGISTERS_END_ADDRESS), value);
-			}
 			break;
 		}
 	}
@@ -0,0 +1,55 @@
+#include <algorithm>
+#include <cstring>
+#include "Memory/PagedBuffer.hpp"
+
+namespace ModestGB
+{
+	PagedBuffer::PagedBuffer(size_t size) : size(size), pages((size + PAGE_SIZE - 1) / PAGE_SIZE, GetZeroPage())
+	{
+	}
+
+	size_t PagedBuffer::GetSize() const
+	{
+		return size;
+	}
+
+	void PagedBuffer::ReadBlock(size_t address, uint8_t* destination, size_t length) const
+	{
+		while (length > 0)
+		{
+			size_t offset = address % PAGE_SIZE;
+			size_t chunkLength = std::min(length, PAGE_SIZE - offset);
+			std::memcpy(destination, pages[address / PAGE_SIZE]->data() + offset, chunkLength);
+
+			address += chunkLength;
+			destination += chunkLength;
+			length -= chunkLength;
+		}
+	}
+
+	void PagedBuffer::WriteBlock(size_t address, const uint8_t* source, size_t length)
+	{
+		while (length > 0)
+		{
+			size_t offset = address % PAGE_SIZE;
+			size_t chunkLength = std::min(length, PAGE_SIZE - offset);
+			std::memcpy(GetWritablePage(address / PAGE_SIZE).data() + offset, source, chunkLength);
+
+			address += chunkLength;
+			source += chunkLength;
+			length -= chunkLength;
+		}
+	}
+
+	void PagedBuffer::Clear()
+	{
+		std::fill(pages.begin(), pages.end(), GetZeroPage());
+	}
+
+	const std::shared_ptr<PagedBuffer::Page>& PagedBuffer::GetZeroPage()
+	{
+		// Never written to, since it's always shared with this reference.
+		static const std::shared_ptr<Page> zeroPage = std::make_shared<Page>();
+		return zeroPage;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,104 @@
+#include <fstream>
+#include <iterator>
+#include "Memory/ROMCache.hpp"
+#include "Utils/Hashing.hpp"
+#include "Utils/Decompression.hpp"
+
+namespace ModestGB
+{
+	std::mutex ROMCache::cacheMutex;
+	std::unordered_map<uint64_t, std::weak_ptr<const ROMImage>> ROMCache::imagesByHash;
+	std::unordered_map<std::string, ROMCache::FileEntry> ROMCache::imagesByFilePath;
+
+	std::shared_ptr<const ROMImage> ROMCache::LoadFile(const std::string& filePath)
+	{
+		// Without the size and modification time there is no telling whether the file changed, so it is always read.
+		FileStamp stamp;
+		bool canBeMatchedByFile = FileStamp::Get(filePath, stamp);
+
+		if (canBeMatchedByFile)
+		{
+			std::lock_guard<std::mutex> lock(cacheMutex);
+			auto entry = imagesByFilePath.find(stamp.canonicalPath);
+
+			if (entry != imagesByFilePath.end() && entry->second.stamp == stamp)
+			{
+				if (auto image = entry->second.image.lock())
+					return image;
+			}
+		}
+
+		auto file = std::ifstream(filePath, std::ios::binary);
+
+		if (!file.is_open())
+			return nullptr;
+
+		// Reading and hashing a large ROM takes a while, so it is done without holding the lock.
+		auto data = std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+		// Archives are decompressed in memory, the ROM is never written to disk.
+		if (Decompression::IsArchive(data.data(), data.size()))
+		{
+			std::vector<uint8_t> romData;
+
+			if (!Decompression::ExtractROM(data.data(), data.size(), romData))
+				return nullptr;
+
+			data = std::move(romData);
+		}
+
+		uint64_t hash = Hashing::ComputeFNV1a(data.data(), data.size());
+
+		std::lock_guard<std::mutex> lock(cacheMutex);
+		auto image = AcquireLocked(std::move(data), hash);
+
+		if (canBeMatchedByFile)
+			imagesByFilePath[stamp.canonicalPath] = FileEntry{ stamp, image };
+
+		return image;
+	}
+
+	std::shared_ptr<const ROMImage> ROMCache::Acquire(std::vector<uint8_t>&& data)
+	{
+		uint64_t hash = Hashing::ComputeFNV1a(data.data(), data.size());
+
+		std::lock_guard<std::mutex> lock(cacheMutex);
+		return AcquireLocked(std::move(data), hash);
+	}
+
+	std::shared_ptr<const ROMImage> ROMCache::AcquireLocked(std::vector<uint8_t>&& data, uint64_t hash)
+	{
+		auto entry = imagesByHash.find(hash);
+		bool isHashTaken = false;
+
+		if (entry != imagesByHash.end())
+		{
+			// A hash collision between two different ROMs is very unlikely, but would make a game run with the 
+			// wrong ROM, so the content is compared too. A colliding ROM simply isn't shared.
+			if (auto image = entry->second.lock(); image != nullptr)
+			{
+				if (image->data == data)
+					return image;
+
+				isHashTaken = true;
+			}
+		}
+
+		RemoveExpiredEntries();
+
+		auto image = std::make_shared<ROMImage>();
+		image->data = std::move(data);
+		image->hash = hash;
+
+		if (!isHashTaken)
+			imagesByHash[hash] = image;
+
+		return image;
+	}
+
+	void ROMCache::RemoveExpiredEntries()
+	{
+		std::erase_if(imagesByHash, [](const auto& entry) { return entry.second.expired(); });
+		std::erase_if(imagesByFilePath, [](const auto& entry) { return entry.second.image.expired(); });
+	}
+}
\ No newline at end of file
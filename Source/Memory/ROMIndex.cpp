@@ -0,0 +1,92 @@
+#include <fstream>
+#include <vector>
+#include "Memory/ROMIndex.hpp"
+#include "Utils/Decompression.hpp"
+
+namespace ModestGB
+{
+	std::mutex ROMIndex::indexMutex;
+	std::unordered_map<std::string, ROMIndexEntry> ROMIndex::entriesByFilePath;
+	std::unordered_map<uint64_t, ROMIndexEntry> ROMIndex::entriesByHash;
+
+	bool ROMIndex::Scan(const std::string& filePath, ROMIndexEntry& entry)
+	{
+		FileStamp stamp;
+
+		if (!FileStamp::Get(filePath, stamp))
+			return false;
+
+		{
+			std::lock_guard<std::mutex> lock(indexMutex);
+			auto indexedEntry = entriesByFilePath.find(stamp.canonicalPath);
+
+			if (indexedEntry != entriesByFilePath.end() && indexedEntry->second.stamp == stamp)
+			{
+				entry = indexedEntry->second;
+				return true;
+			}
+		}
+
+		auto file = std::ifstream(filePath, std::ios::binary);
+
+		if (!file.is_open())
+			return false;
+
+		std::vector<uint8_t> headerData(CartridgeHeader::MIN_ROM_SIZE);
+		file.read(reinterpret_cast<char*>(headerData.data()), headerData.size());
+		headerData.resize(static_cast<size_t>(file.gcount()));
+
+		// The start of an archive isn't a cartridge header, so the ROM is extracted to read the real one.
+		if (Decompression::IsArchive(headerData.data(), headerData.size()))
+		{
+			file.clear();
+			file.seekg(0, std::ios::end);
+			std::vector<uint8_t> archive(static_cast<size_t>(file.tellg()));
+			file.seekg(0, std::ios::beg);
+			file.read(reinterpret_cast<char*>(archive.data()), archive.size());
+
+			if (!file || !Decompression::ExtractROM(archive.data(), archive.size(), headerData))
+				return false;
+		}
+
+		ROMIndexEntry scannedEntry;
+		scannedEntry.stamp = stamp;
+
+		if (!CartridgeHeader::Parse(headerData, scannedEntry.header, false))
+			return false;
+
+		std::lock_guard<std::mutex> lock(indexMutex);
+		entriesByFilePath[stamp.canonicalPath] = scannedEntry;
+		entry = scannedEntry;
+
+		return true;
+	}
+
+	void ROMIndex::Add(const std::string& filePath, uint64_t romHash, const CartridgeHeader& header)
+	{
+		ROMIndexEntry loadedEntry;
+		loadedEntry.header = header;
+		loadedEntry.romHash = romHash;
+
+		// The ROM is still indexed by its hash if the file can't be queried (e.g. it was deleted since).
+		bool hasStamp = FileStamp::Get(filePath, loadedEntry.stamp);
+
+		std::lock_guard<std::mutex> lock(indexMutex);
+		entriesByHash[romHash] = loadedEntry;
+
+		if (hasStamp)
+			entriesByFilePath[loadedEntry.stamp.canonicalPath] = loadedEntry;
+	}
+
+	bool ROMIndex::FindByHash(uint64_t romHash, ROMIndexEntry& entry)
+	{
+		std::lock_guard<std::mutex> lock(indexMutex);
+		auto indexedEntry = entriesByHash.find(romHash);
+
+		if (indexedEntry == entriesByHash.end())
+			return false;
+
+		entry = indexedEntry->second;
+		return true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,198 @@
+#include "RewindBuffer.hpp"
+#include "Utils/DeltaCompression.hpp"
+#include "Logger.hpp"
+
+namespace ModestGB
+{
+	const std::string REWIND_MESSAGE_HEADER = "[REWIND]";
+
+	RewindBuffer::~RewindBuffer()
+	{
+		Stop();
+	}
+
+	void RewindBuffer::Start(size_t capacity)
+	{
+		Stop();
+
+		storage.assign(capacity, 0);
+		ClearHistory();
+
+		shouldStop = false;
+		compressionThread = std::thread(&RewindBuffer::RunCompression, this);
+	}
+
+	void RewindBuffer::Stop()
+	{
+		if (!compressionThread.joinable())
+			return;
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			shouldStop = true;
+		}
+
+		condition.notify_all();
+		compressionThread.join();
+	}
+
+	bool RewindBuffer::IsStarted() const
+	{
+		return compressionThread.joinable();
+	}
+
+	void RewindBuffer::Clear()
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		condition.wait(lock, [this] { return !isCompressing; });
+
+		isStatePending = false;
+		ClearHistory();
+	}
+
+	void RewindBuffer::Push(std::vector<uint8_t>& state)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			std::swap(state, pendingState);
+			isStatePending = true;
+		}
+
+		condition.notify_all();
+	}
+
+	bool RewindBuffer::Pop(std::vector<uint8_t>& state)
+	{
+		// The state that was just pushed is the most recent one, so it has to be compressed first.
+		std::unique_lock<std::mutex> lock(mutex);
+		condition.wait(lock, [this] { return !isStatePending && !isCompressing; });
+
+		if (!hasLatestState)
+			return false;
+
+		state.assign(latestState.begin(), latestState.end());
+
+		if (!deltas.empty())
+		{
+			Delta delta = deltas.back();
+			deltas.pop_back();
+			storedDeltaSize -= delta.size;
+
+			// The newest delta is always the last one that was written, so its space can be reused right away.
+			writeOffset = delta.offset;
+
+			if (!DeltaCompression::ApplyXORDelta(storage.data() + delta.offset, delta.size, latestState, delta.stateSize))
+			{
+				Logger::WriteError("The rewind history is corrupted and has been cleared.", REWIND_MESSAGE_HEADER);
+				ClearHistory();
+			}
+		}
+
+		RefreshStatistics();
+		return true;
+	}
+
+	uint32_t RewindBuffer::GetStateCount() const
+	{
+		return stateCount;
+	}
+
+	size_t RewindBuffer::GetUsedCapacity() const
+	{
+		return usedCapacity;
+	}
+
+	size_t RewindBuffer::GetCapacity() const
+	{
+		return storage.size();
+	}
+
+	void RewindBuffer::RunCompression()
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+
+		while (true)
+		{
+			condition.wait(lock, [this] { return isStatePending || shouldStop; });
+
+			if (shouldStop)
+				return;
+
+			std::swap(workingState, pendingState);
+			isStatePending = false;
+			isCompressing = true;
+
+			// The emulation thread can push the next state while this one is being compressed.
+			lock.unlock();
+			AddState(workingState);
+			lock.lock();
+
+			isCompressing = false;
+			condition.notify_all();
+		}
+	}
+
+	void RewindBuffer::AddState(std::vector<uint8_t>& state)
+	{
+		if (hasLatestState)
+		{
+			// The delta goes from the new state back to the previous one.
+			DeltaCompression::EncodeXORDelta(state.data(), state.size(), latestState.data(), latestState.size(), compressedState);
+			StoreDelta(compressedState, latestState.size());
+		}
+
+		std::swap(latestState, state);
+		hasLatestState = true;
+		RefreshStatistics();
+	}
+
+	void RewindBuffer::StoreDelta(const std::vector<uint8_t>& delta, size_t stateSize)
+	{
+		// Without this delta, none of the older states can be reached anymore.
+		if (delta.size() > storage.size())
+		{
+			deltas.clear();
+			storedDeltaSize = 0;
+			writeOffset = 0;
+			return;
+		}
+
+		if (writeOffset + delta.size() > storage.size())
+		{
+			// The deltas between the write offset and the end of the storage are the oldest ones.
+			while (!deltas.empty() && deltas.front().offset >= writeOffset)
+				DropOldestDelta();
+
+			writeOffset = 0;
+		}
+
+		while (!deltas.empty() && deltas.front().offset < writeOffset + delta.size() && deltas.front().offset + deltas.front().size > writeOffset)
+			DropOldestDelta();
+
+		std::copy(delta.begin(), delta.end(), storage.begin() + writeOffset);
+		deltas.push_back({ .offset = writeOffset, .size = delta.size(), .stateSize = stateSize });
+		storedDeltaSize += delta.size();
+		writeOffset += delta.size();
+	}
+
+	void RewindBuffer::DropOldestDelta()
+	{
+		storedDeltaSize -= deltas.front().size;
+		deltas.pop_front();
+	}
+
+	void RewindBuffer::ClearHistory()
+	{
+		deltas.clear();
+		storedDeltaSize = 0;
+		writeOffset = 0;
+		hasLatestState = false;
+		RefreshStatistics();
+	}
+
+	void RewindBuffer::RefreshStatistics()
+	{
+		stateCount = static_cast<uint32_t>(deltas.size()) + (hasLatestState ? 1 : 0);
+		usedCapacity = storedDeltaSize;
+	}
+}
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "Utils/Interrupts.hpp"
 #include "Logger.hpp"
 #include "Utils/GBSpecs.hpp"
+#include "Utils/BitField.hpp"
 
 namespace ModestGB
 {
@@ -34,6 +35,10 @@ namespace ModestGB
 	// FF06: TIMA - Timer Counter (R/W)
 	// FF07: TAC - Timer Control (R/W)
 
+	// TAC Fields
+	constexpr BitField<2> TAC_TIMER_ENABLE{};
+	constexpr BitField<0, 1> TAC_CLOCK_SELECT{};
+
 	Timer::Timer(Memory& memoryMap) : memoryMap(memoryMap)
 	{
 
@@ -87,7 +92,7 @@ namespace ModestGB
 
 	uint8_t Timer::GetTimerControlRegister() const
 	{
-		return (isEnabled << 2) | static_cast<uint8_t>(currentTimerControlMode);
+		return TAC_TIMER_ENABLE.Set(0, isEnabled) | TAC_CLOCK_SELECT.Set(0, static_cast<uint8_t>(currentTimerControlMode));
 	}
 
 	void Timer::WriteToTimerCounter(uint8_t value)
@@ -117,8 +122,8 @@ namespace ModestGB
 	{
 		bool wasPreviouslyEnabled = isEnabled;
 
-		isEnabled = (value & 0b100) >> 2;
-		currentTimerControlMode = static_cast<TimerControlMode>(value & 0b11);
+		isEnabled = TAC_TIMER_ENABLE.Get(value);
+		currentTimerControlMode = static_cast<TimerControlMode>(TAC_CLOCK_SELECT.Get(value));
 
 		// If the timer was previously enabled, the bit designated as the "timer control bit" is 1,
 		// and the timer is no longer enabled, then the timer counter should be incremented.
@@ -140,6 +145,30 @@ namespace ModestGB
 		currentTimerControlMode = TimerControlMode::TIMER_CONTROL_MODE_1024;
 	}
 
+	void Timer::Serialize(StateWriter& writer) const
+	{
+		writer.Write(internalCounter);
+		writer.Write(timerCounter);
+		writer.Write(timerModulo);
+		writer.Write(GetTimerControlRegister());
+		writer.Write(overflowCounter);
+		writer.Write(wasCounterReloaded);
+	}
+
+	void Timer::Deserialize(StateReader& reader)
+	{
+		reader.Read(internalCounter);
+		reader.Read(timerCounter);
+		reader.Read(timerModulo);
+
+		uint8_t timerControlRegister = reader.Read<uint8_t>();
+		isEnabled = TAC_TIMER_ENABLE.Get(timerControlRegister);
+		currentTimerControlMode = static_cast<TimerControlMode>(TAC_CLOCK_SELECT.Get(timerControlRegister));
+
+		reader.Read(overflowCounter);
+		reader.Read(wasCounterReloaded);
+	}
+
 	bool Timer::GetCurrentTimerControlBit() const
 	{
 		// Returns the bit in the internal counter that is responsible for determining when to increment the timer counter (TIMA).
@@ -1,7 +1,6 @@
 #include <limits>
 #include <cstdint>
 #include <algorithm>
-#include <cmath>
 #include "Utils/Arithmetic.hpp"
 
 namespace ModestGB::Arithmetic
@@ -13,7 +12,7 @@ namespace ModestGB::Arithmetic
 
 	uint32_t ModestGB::Arithmetic::GetBits(uint32_t data, uint8_t start, uint8_t end)
 	{
-		return (data >> start) & static_cast<uint32_t>(std::pow(2, (end - start) + 1) - 1);
+		return (data >> start) & ((2u << (end - start)) - 1);
 	}
 
 	bool ModestGB::Arithmetic::Is8BitOverflow(int num)
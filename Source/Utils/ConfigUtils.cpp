@@ -9,6 +9,7 @@
 namespace ModestGB::Config
 {
 	const std::string MAIN_WINDOW_MAXIMIZED_NODE_NAME = "Maximized";
+	const std::string VSYNC_NODE_NAME = "VSync";
 	const std::string CPU_WINDOW_CONFIG_NODE_NAME = "CPU Debug Window Open";
 	const std::string TILES_WINDOW_CONFIG_NODE_NAME = "Tiles Debug Window Open";
 	const std::string BACKGROUND_MAP_WINDOW_CONFIG_NODE_NAME = "Background Map Debug Window Open";
@@ -31,6 +32,8 @@ namespace ModestGB::Config
 	const std::string KEYCODE_NODE_NAME = "Key";
 	const std::string CONTROLLER_NODE_NAME = "Controller";
 	const std::string SAVED_DATA_NODE_NAME = "Saved Data Location";
+	const std::string RTC_WALL_CLOCK_CATCH_UP_NODE_NAME = "Real-Time Clock Catch-Up";
+	const std::string GLOBAL_CHECKSUM_VERIFICATION_NODE_NAME = "Verify Global Checksum";
 
 	const std::map<SavedDataSearchType, std::string> SAVED_DATA_LOCATION_STRINGS =
 	{
@@ -96,7 +99,10 @@ namespace ModestGB::Config
 	{
 		node[MUTED_NODE_NAME] = apu.IsMuted();
 		node[VOLUME_NODE_NAME] = apu.GetMasterVolume();
-		node[OUTPUT_DEVICE_NODE_NAME] = apu.GetCurrentOutputDeviceName();
+
+		// Only audio devices can be selected again on the next launch (e.g. not the file the audio is recorded to).
+		if (!apu.GetAllOutputDeviceNames().empty())
+			node[OUTPUT_DEVICE_NODE_NAME] = apu.GetCurrentOutputDeviceName();
 	}
 
 	bool LoadAudioConfiguration(YAML::Node& node, APU& apu)
@@ -105,7 +111,9 @@ namespace ModestGB::Config
 		{
 			apu.Mute(node[MUTED_NODE_NAME].as<bool>());
 			apu.SetMasterVolume(node[VOLUME_NODE_NAME].as<float>());
-			apu.SetOutputDevice(node[OUTPUT_DEVICE_NODE_NAME].as<std::string>());
+
+			if (node[OUTPUT_DEVICE_NODE_NAME])
+				apu.SetOutputDevice(node[OUTPUT_DEVICE_NODE_NAME].as<std::string>());
 		}
 		catch (std::exception e)
 		{
@@ -116,11 +124,9 @@ namespace ModestGB::Config
 		return true;
 	}
 
-	void SaveJoypadConfiguration(YAML::Node& node, const Joypad& joypad, const InputManager& inputManager)
+	void SaveJoypadConfiguration(YAML::Node& node, const InputMapping& inputMapping, const InputManager& inputManager)
 	{
-		std::map<GBButton, ButtonKeyPair> inputMapping = joypad.GetInputMapping();
-
-		for (const std::pair<GBButton, ButtonKeyPair>& pair : inputMapping)
+		for (const std::pair<GBButton, ButtonKeyPair>& pair : inputMapping.GetMapping())
 		{
 			node[JOYPAD_NODE_NAME][GBBUTTON_STRINGS.at(pair.first)][CONTROLLER_BUTTON_NODE_NAME] = CONTROLLER_BUTTON_STRINGS.at(pair.second.button);
 			node[JOYPAD_NODE_NAME][GBBUTTON_STRINGS.at(pair.first)][KEYCODE_NODE_NAME] = KEYCODE_STRINGS.at(pair.second.key);
@@ -129,7 +135,7 @@ namespace ModestGB::Config
 		node[CONTROLLER_NODE_NAME] = inputManager.GetCurrentControllerName();
 	}
 
-	bool LoadJoypadConfiguration(YAML::Node& node, Joypad& joypad, InputManager& inputManager)
+	bool LoadJoypadConfiguration(YAML::Node& node, InputMapping& inputMapping, InputManager& inputManager)
 	{
 		try
 		{
@@ -144,7 +150,7 @@ namespace ModestGB::Config
 				{
 					if (controllerNodeValue == ctrlPair.second)
 					{
-						joypad.SetControllerButtonCode(pair.first, ctrlPair.first);
+						inputMapping.SetControllerButtonCode(pair.first, ctrlPair.first);
 						break;
 					}
 				}
@@ -156,7 +162,7 @@ namespace ModestGB::Config
 				{
 					if (keyNodeValue == keyPair.second)
 					{
-						joypad.SetKeyCode(pair.first, keyPair.first);
+						inputMapping.SetKeyCode(pair.first, keyPair.first);
 						break;
 					}
 				}
@@ -174,12 +180,20 @@ namespace ModestGB::Config
 	void SaveCartridgeConfiguration(YAML::Node& node, const Cartridge& cartridge)
 	{
 		node[SAVED_DATA_NODE_NAME] = SAVED_DATA_LOCATION_STRINGS.at(cartridge.GetSavedDataSearchType());
+		node[RTC_WALL_CLOCK_CATCH_UP_NODE_NAME] = cartridge.IsRTCWallClockCatchUpEnabled();
+		node[GLOBAL_CHECKSUM_VERIFICATION_NODE_NAME] = cartridge.IsGlobalChecksumVerificationEnabled();
 	}
 
 	bool LoadCartridgeConfiguration(YAML::Node& node, Cartridge& cartridge)
 	{
 		try
 		{
+			if (node[RTC_WALL_CLOCK_CATCH_UP_NODE_NAME])
+				cartridge.SetRTCWallClockCatchUpEnabled(node[RTC_WALL_CLOCK_CATCH_UP_NODE_NAME].as<bool>());
+
+			if (node[GLOBAL_CHECKSUM_VERIFICATION_NODE_NAME])
+				cartridge.SetGlobalChecksumVerificationEnabled(node[GLOBAL_CHECKSUM_VERIFICATION_NODE_NAME].as<bool>());
+
 			auto nodeValue = node[SAVED_DATA_NODE_NAME].as<std::string>();
 
 			// Find the SavedDataSearchType whose string representation matches the value retrieved from the yaml node.
@@ -217,6 +231,7 @@ namespace ModestGB::Config
 		node[VIDEO_REGISTERS_WINDOW_CONFIG_NODE_NAME] = window.shouldRenderVideoRegistersDebugWindow;
 		node[JOYPAD_WINDOW_CONFIG_NODE_NAME] = window.shouldRenderJoypadDebugWindow;
 		node[LOG_WINDOW_AUTO_SCROLL_CONFIG_NODE_NAME] = window.shouldAutoScrollLogsToBottom;
+		node[VSYNC_NODE_NAME] = window.IsVSyncEnabled();
 	}
 
 	bool LoadWindowConfiguration(YAML::Node node, EmulatorWindow& window)
@@ -236,6 +251,10 @@ namespace ModestGB::Config
 			window.shouldRenderVideoRegistersDebugWindow = node[VIDEO_REGISTERS_WINDOW_CONFIG_NODE_NAME].as<bool>();
 			window.shouldRenderJoypadDebugWindow = node[JOYPAD_WINDOW_CONFIG_NODE_NAME].as<bool>();
 			window.shouldAutoScrollLogsToBottom = node[LOG_WINDOW_AUTO_SCROLL_CONFIG_NODE_NAME].as<bool>();
+
+			// Configuration files written before vsync could be toggled don't have this node.
+			if (node[VSYNC_NODE_NAME])
+				window.SetVSyncEnabled(node[VSYNC_NODE_NAME].as<bool>());
 		}
 		catch (std::exception e)
 		{
@@ -246,7 +265,7 @@ namespace ModestGB::Config
 		return true;
 	}
 
-	bool Config::SaveConfiguration(const std::string& configFilePath, EmulatorWindow& window, const APU& apu, const PPU& ppu, const Joypad& joypad, const InputManager& inputManager, const Cartridge& cartridge)
+	bool Config::SaveConfiguration(const std::string& configFilePath, EmulatorWindow& window, const APU& apu, const PPU& ppu, const InputMapping& inputMapping, const InputManager& inputManager, const Cartridge& cartridge)
 	{
 		YAML::Node node;
 
@@ -254,7 +273,7 @@ namespace ModestGB::Config
 		SaveCartridgeConfiguration(node, cartridge);
 		SaveWindowConfiguration(node, window);
 		SaveVideoConfiguration(node, ppu);
-		SaveJoypadConfiguration(node, joypad, inputManager);
+		SaveJoypadConfiguration(node, inputMapping, inputManager);
 
 		auto stream = std::ofstream(configFilePath);
 
@@ -265,7 +284,7 @@ namespace ModestGB::Config
 		return true;
 	}
 
-	bool Config::LoadConfiguration(const std::string& configFilePath, EmulatorWindow& window, APU& apu, PPU& ppu, Joypad& joypad, InputManager& inputManager, Cartridge& cartridge)
+	bool Config::LoadConfiguration(const std::string& configFilePath, EmulatorWindow& window, APU& apu, PPU& ppu, InputMapping& inputMapping, InputManager& inputManager, Cartridge& cartridge)
 	{
 		if (!std::filesystem::exists(configFilePath))
 			return false;
@@ -288,7 +307,7 @@ namespace ModestGB::Config
 		if (!LoadVideoConfiguration(node, ppu))
 			success = false;
 
-		if (!LoadJoypadConfiguration(node, joypad, inputManager))
+		if (!LoadJoypadConfiguration(node, inputMapping, inputManager))
 			success = false;
 
 		return success;
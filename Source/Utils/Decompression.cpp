@@ -0,0 +1,605 @@
+#include <array>
+#include <cctype>
+#include <string>
+#include <algorithm>
+#include "Utils/Decompression.hpp"
+#include "Utils/Hashing.hpp"
+#include "Utils/MemoryUtils.hpp"
+#include "Logger.hpp"
+
+namespace ModestGB::Decompression
+{
+	const std::string DECOMPRESSION_LOG_HEADER = "[Decompression]";
+
+	// The largest ROM a Game Boy cartridge can hold (MBC5).
+	const size_t MAX_ROM_SIZE = 8 * MiB;
+
+	const uint8_t MAX_CODE_LENGTH = 15;
+	const uint16_t MAX_LITERAL_LENGTH_CODES = 286;
+	const uint16_t MAX_DISTANCE_CODES = 30;
+	const uint16_t END_OF_BLOCK_SYMBOL = 256;
+
+	// Codes up to this length are decoded with a single table lookup, longer ones (which are rare) bit by bit.
+	const uint8_t FAST_LOOKUP_BITS = 9;
+
+	const std::array<uint16_t, 29> LENGTH_BASES = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+	const std::array<uint8_t, 29> LENGTH_EXTRA_BITS = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+	const std::array<uint16_t, 30> DISTANCE_BASES = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+	const std::array<uint8_t, 30> DISTANCE_EXTRA_BITS = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+	// The order in which the lengths of the code length code are stored in a dynamic block.
+	const std::array<uint8_t, 19> CODE_LENGTH_ORDER = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+	const uint8_t GZIP_ID1 = 0x1F;
+	const uint8_t GZIP_ID2 = 0x8B;
+	const uint8_t GZIP_DEFLATE_METHOD = 8;
+	const uint8_t GZIP_HEADER_SIZE = 10;
+	const uint8_t GZIP_TRAILER_SIZE = 8;
+	const uint8_t GZIP_FLAG_HEADER_CRC = 0x02;
+	const uint8_t GZIP_FLAG_EXTRA = 0x04;
+	const uint8_t GZIP_FLAG_NAME = 0x08;
+	const uint8_t GZIP_FLAG_COMMENT = 0x10;
+
+	const uint32_t ZIP_LOCAL_HEADER_SIGNATURE = 0x04034B50;
+	const uint32_t ZIP_CENTRAL_HEADER_SIGNATURE = 0x02014B50;
+	const uint32_t ZIP_END_OF_CENTRAL_DIRECTORY_SIGNATURE = 0x06054B50;
+	const uint8_t ZIP_LOCAL_HEADER_SIZE = 30;
+	const uint8_t ZIP_CENTRAL_HEADER_SIZE = 46;
+	const uint8_t ZIP_END_OF_CENTRAL_DIRECTORY_SIZE = 22;
+	const uint16_t ZIP_MAX_COMMENT_SIZE = 0xFFFF;
+	const uint16_t ZIP_FLAG_ENCRYPTED = 0x0001;
+	const uint16_t ZIP_STORED_METHOD = 0;
+	const uint16_t ZIP_DEFLATE_METHOD = 8;
+
+	const std::array<std::string, 3> ROM_FILE_EXTENSIONS = { ".gb", ".gbc", ".rom" };
+
+	// Reads the input least significant bit first, as DEFLATE packs it. Reading past the end yields 
+	// zeros and marks the reader as failed, so the decoder only has to check once per symbol.
+	class BitReader
+	{
+	public:
+		BitReader(const uint8_t* input, size_t inputSize) : input(input), inputSize(inputSize)
+		{
+		}
+
+		uint32_t PeekBits(uint8_t count)
+		{
+			Refill(count);
+			return static_cast<uint32_t>(bitBuffer & ((1ull << count) - 1));
+		}
+
+		void ConsumeBits(uint8_t count)
+		{
+			Refill(count);
+			bitBuffer >>= count;
+			bitCount -= count;
+		}
+
+		uint32_t ReadBits(uint8_t count)
+		{
+			uint32_t value = PeekBits(count);
+			ConsumeBits(count);
+			return value;
+		}
+
+		// Stored blocks start at the next byte boundary.
+		void AlignToByte()
+		{
+			ConsumeBits(bitCount % 8);
+		}
+
+		bool HasFailed() const
+		{
+			return paddedBitCount > bitCount;
+		}
+
+	private:
+		const uint8_t* input;
+		size_t inputSize;
+		size_t position = 0;
+		uint64_t bitBuffer = 0;
+		uint32_t bitCount = 0;
+
+		// Zero bits added past the end of the input. The reader fails once any of them is consumed.
+		uint32_t paddedBitCount = 0;
+
+		void Refill(uint8_t requiredBitCount)
+		{
+			while (bitCount < requiredBitCount)
+			{
+				uint64_t byte = 0;
+
+				if (position < inputSize)
+					byte = input[position++];
+				else
+					paddedBitCount += 8;
+
+				bitBuffer |= byte << bitCount;
+				bitCount += 8;
+			}
+		}
+	};
+
+	// A canonical Huffman code, built from the code length of each symbol.
+	class HuffmanTable
+	{
+	public:
+		// Fails if the lengths describe more codes than fit in 15 bits. Incomplete codes are allowed, 
+		// decoding one of the missing codes fails instead.
+		bool Build(const uint8_t* codeLengths, uint16_t symbolCount)
+		{
+			lengthCounts.fill(0);
+			fastLookup.fill(0);
+
+			for (uint16_t symbol = 0; symbol < symbolCount; symbol++)
+				lengthCounts[codeLengths[symbol]]++;
+
+			lengthCounts[0] = 0;
+
+			int32_t remainingCodes = 1;
+			for (uint8_t length = 1; length <= MAX_CODE_LENGTH; length++)
+			{
+				remainingCodes = (remainingCodes << 1) - lengthCounts[length];
+
+				if (remainingCodes < 0)
+					return false;
+			}
+
+			// Sort the symbols by code length, then by value, which is the order of their codes.
+			std::array<uint16_t, MAX_CODE_LENGTH + 1> offsets{};
+			for (uint8_t length = 1; length < MAX_CODE_LENGTH; length++)
+				offsets[length + 1] = offsets[length] + lengthCounts[length];
+
+			for (uint16_t symbol = 0; symbol < symbolCount; symbol++)
+			{
+				if (codeLengths[symbol] != 0)
+					sortedSymbols[offsets[codeLengths[symbol]]++] = symbol;
+			}
+
+			// The codes are stored most significant bit first, so the lookup is indexed by the reversed code, 
+			// and every entry whose low bits match a short code points to that code.
+			uint16_t code = 0;
+			uint16_t index = 0;
+			for (uint8_t length = 1; length <= FAST_LOOKUP_BITS; length++)
+			{
+				for (uint16_t i = 0; i < lengthCounts[length]; i++, index++, code++)
+				{
+					uint16_t reversedCode = ReverseBits(code, length);
+
+					for (uint16_t entry = reversedCode; entry < fastLookup.size(); entry += 1 << length)
+						fastLookup[entry] = static_cast<uint16_t>((sortedSymbols[index] << 4) | length);
+				}
+
+				code <<= 1;
+			}
+
+			return true;
+		}
+
+		// Returns -1 if the code is invalid.
+		int32_t Decode(BitReader& reader) const
+		{
+			uint16_t entry = fastLookup[reader.PeekBits(FAST_LOOKUP_BITS)];
+
+			if (entry != 0)
+			{
+				reader.ConsumeBits(entry & 0x0F);
+				return entry >> 4;
+			}
+
+			// Walk down the code one bit at a time. At each length, the codes of that length are the 
+			// [count] values that follow [first], with [index] the position of the first one in sortedSymbols.
+			int32_t code = 0;
+			int32_t first = 0;
+			int32_t index = 0;
+			for (uint8_t length = 1; length <= MAX_CODE_LENGTH; length++)
+			{
+				code |= reader.ReadBits(1);
+				int32_t count = lengthCounts[length];
+
+				if (code - first < count)
+					return sortedSymbols[index + (code - first)];
+
+				index += count;
+				first = (first + count) << 1;
+				code <<= 1;
+			}
+
+			return -1;
+		}
+
+	private:
+		std::array<uint16_t, MAX_CODE_LENGTH + 1> lengthCounts{};
+		std::array<uint16_t, MAX_LITERAL_LENGTH_CODES + 2> sortedSymbols{};
+
+		// Symbol in the upper 12 bits, code length in the lower 4 bits. Zero for codes longer than FAST_LOOKUP_BITS.
+		std::array<uint16_t, 1 << FAST_LOOKUP_BITS> fastLookup{};
+
+		static uint16_t ReverseBits(uint16_t value, uint8_t count)
+		{
+			uint16_t result = 0;
+			for (uint8_t i = 0; i < count; i++)
+			{
+				result = static_cast<uint16_t>((result << 1) | (value & 1));
+				value >>= 1;
+			}
+
+			return result;
+		}
+	};
+
+	bool InflateStoredBlock(BitReader& reader, std::vector<uint8_t>& output, size_t maxOutputSize)
+	{
+		reader.AlignToByte();
+		uint16_t length = static_cast<uint16_t>(reader.ReadBits(16));
+		uint16_t complement = static_cast<uint16_t>(reader.ReadBits(16));
+
+		if (reader.HasFailed() || length != static_cast<uint16_t>(~complement) || output.size() + length > maxOutputSize)
+			return false;
+
+		for (uint16_t i = 0; i < length; i++)
+			output.push_back(static_cast<uint8_t>(reader.ReadBits(8)));
+
+		return !reader.HasFailed();
+	}
+
+	bool InflateCompressedBlock(BitReader& reader, const HuffmanTable& literalLengthTable, const HuffmanTable& distanceTable, std::vector<uint8_t>& output, size_t maxOutputSize)
+	{
+		while (true)
+		{
+			int32_t symbol = literalLengthTable.Decode(reader);
+
+			if (symbol < 0 || reader.HasFailed())
+				return false;
+
+			if (symbol < END_OF_BLOCK_SYMBOL)
+			{
+				if (output.size() >= maxOutputSize)
+					return false;
+
+				output.push_back(static_cast<uint8_t>(symbol));
+				continue;
+			}
+
+			if (symbol == END_OF_BLOCK_SYMBOL)
+				return true;
+
+			uint16_t lengthIndex = static_cast<uint16_t>(symbol - END_OF_BLOCK_SYMBOL - 1);
+			if (lengthIndex >= LENGTH_BASES.size())
+				return false;
+
+			size_t length = LENGTH_BASES[lengthIndex] + reader.ReadBits(LENGTH_EXTRA_BITS[lengthIndex]);
+			int32_t distanceIndex = distanceTable.Decode(reader);
+
+			if (distanceIndex < 0 || distanceIndex >= static_cast<int32_t>(DISTANCE_BASES.size()))
+				return false;
+
+			size_t distance = DISTANCE_BASES[distanceIndex] + reader.ReadBits(DISTANCE_EXTRA_BITS[distanceIndex]);
+
+			if (reader.HasFailed() || distance > output.size() || output.size() + length > maxOutputSize)
+				return false;
+
+			// The copy may overlap the bytes it produces (e.g. a run of a single byte), so it goes one byte at a time.
+			size_t source = output.size() - distance;
+			for (size_t i = 0; i < length; i++)
+				output.push_back(output[source + i]);
+		}
+	}
+
+	bool ReadDynamicTables(BitReader& reader, HuffmanTable& literalLengthTable, HuffmanTable& distanceTable)
+	{
+		uint16_t literalLengthCodeCount = static_cast<uint16_t>(reader.ReadBits(5) + 257);
+		uint16_t distanceCodeCount = static_cast<uint16_t>(reader.ReadBits(5) + 1);
+		uint8_t codeLengthCodeCount = static_cast<uint8_t>(reader.ReadBits(4) + 4);
+
+		if (literalLengthCodeCount > MAX_LITERAL_LENGTH_CODES || distanceCodeCount > MAX_DISTANCE_CODES)
+			return false;
+
+		std::array<uint8_t, CODE_LENGTH_ORDER.size()> codeLengthCodeLengths{};
+		for (uint8_t i = 0; i < codeLengthCodeCount; i++)
+			codeLengthCodeLengths[CODE_LENGTH_ORDER[i]] = static_cast<uint8_t>(reader.ReadBits(3));
+
+		HuffmanTable codeLengthTable;
+		if (!codeLengthTable.Build(codeLengthCodeLengths.data(), static_cast<uint16_t>(codeLengthCodeLengths.size())))
+			return false;
+
+		// The literal/length and distance code lengths are a single sequence, so a repeat can cross from one to the other.
+		std::array<uint8_t, MAX_LITERAL_LENGTH_CODES + MAX_DISTANCE_CODES> codeLengths{};
+		uint16_t totalCodeCount = literalLengthCodeCount + distanceCodeCount;
+		uint16_t index = 0;
+
+		while (index < totalCodeCount)
+		{
+			int32_t symbol = codeLengthTable.Decode(reader);
+
+			if (symbol < 0 || reader.HasFailed())
+				return false;
+
+			if (symbol < 16)
+			{
+				codeLengths[index++] = static_cast<uint8_t>(symbol);
+				continue;
+			}
+
+			uint8_t repeatedLength = 0;
+			uint32_t repeatCount = 0;
+
+			if (symbol == 16)
+			{
+				// Repeats the previous length 3 - 6 times.
+				if (index == 0)
+					return false;
+
+				repeatedLength = codeLengths[index - 1];
+				repeatCount = 3 + reader.ReadBits(2);
+			}
+			else if (symbol == 17)
+			{
+				repeatCount = 3 + reader.ReadBits(3);
+			}
+			else
+			{
+				repeatCount = 11 + reader.ReadBits(7);
+			}
+
+			if (index + repeatCount > totalCodeCount)
+				return false;
+
+			while (repeatCount-- > 0)
+				codeLengths[index++] = repeatedLength;
+		}
+
+		// A block without an end of block code could never end.
+		if (codeLengths[END_OF_BLOCK_SYMBOL] == 0)
+			return false;
+
+		return literalLengthTable.Build(codeLengths.data(), literalLengthCodeCount) &&
+			distanceTable.Build(codeLengths.data() + literalLengthCodeCount, distanceCodeCount);
+	}
+
+	void BuildFixedTables(HuffmanTable& literalLengthTable, HuffmanTable& distanceTable)
+	{
+		std::array<uint8_t, MAX_LITERAL_LENGTH_CODES + 2> literalLengthCodeLengths{};
+		std::fill(literalLengthCodeLengths.begin(), literalLengthCodeLengths.begin() + 144, 8);
+		std::fill(literalLengthCodeLengths.begin() + 144, literalLengthCodeLengths.begin() + 256, 9);
+		std::fill(literalLengthCodeLengths.begin() + 256, literalLengthCodeLengths.begin() + 280, 7);
+		std::fill(literalLengthCodeLengths.begin() + 280, literalLengthCodeLengths.end(), 8);
+		literalLengthTable.Build(literalLengthCodeLengths.data(), static_cast<uint16_t>(literalLengthCodeLengths.size()));
+
+		std::array<uint8_t, MAX_DISTANCE_CODES> distanceCodeLengths;
+		distanceCodeLengths.fill(5);
+		distanceTable.Build(distanceCodeLengths.data(), static_cast<uint16_t>(distanceCodeLengths.size()));
+	}
+
+	bool Inflate(const uint8_t* input, size_t inputSize, std::vector<uint8_t>& output, size_t maxOutputSize)
+	{
+		output.clear();
+
+		BitReader reader(input, inputSize);
+		HuffmanTable literalLengthTable;
+		HuffmanTable distanceTable;
+		bool isFinalBlock = false;
+
+		while (!isFinalBlock)
+		{
+			isFinalBlock = reader.ReadBits(1) == 1;
+			uint32_t blockType = reader.ReadBits(2);
+			bool isBlockValid = false;
+
+			switch (blockType)
+			{
+			case 0:
+				isBlockValid = InflateStoredBlock(reader, output, maxOutputSize);
+				break;
+			case 1:
+				BuildFixedTables(literalLengthTable, distanceTable);
+				isBlockValid = InflateCompressedBlock(reader, literalLengthTable, distanceTable, output, maxOutputSize);
+				break;
+			case 2:
+				isBlockValid = ReadDynamicTables(reader, literalLengthTable, distanceTable) &&
+					InflateCompressedBlock(reader, literalLengthTable, distanceTable, output, maxOutputSize);
+				break;
+			}
+
+			if (!isBlockValid || reader.HasFailed())
+				return false;
+		}
+
+		return true;
+	}
+
+	uint16_t ReadLittleEndian16(const uint8_t* data)
+	{
+		return static_cast<uint16_t>(data[0] | (data[1] << 8));
+	}
+
+	uint32_t ReadLittleEndian32(const uint8_t* data)
+	{
+		return static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) | (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+	}
+
+	bool IsGzip(const uint8_t* data, size_t size)
+	{
+		return size >= 2 && data[0] == GZIP_ID1 && data[1] == GZIP_ID2;
+	}
+
+	bool IsZip(const uint8_t* data, size_t size)
+	{
+		return size >= 4 && ReadLittleEndian32(data) == ZIP_LOCAL_HEADER_SIGNATURE;
+	}
+
+	bool IsArchive(const uint8_t* data, size_t size)
+	{
+		return IsGzip(data, size) || IsZip(data, size);
+	}
+
+	bool ExtractFromGzip(const uint8_t* archive, size_t archiveSize, std::vector<uint8_t>& rom)
+	{
+		if (archiveSize < GZIP_HEADER_SIZE + GZIP_TRAILER_SIZE || archive[2] != GZIP_DEFLATE_METHOD)
+			return false;
+
+		uint8_t flags = archive[3];
+		size_t position = GZIP_HEADER_SIZE;
+		size_t dataEnd = archiveSize - GZIP_TRAILER_SIZE;
+
+		if ((flags & GZIP_FLAG_EXTRA) != 0)
+		{
+			if (position + 2 > dataEnd)
+				return false;
+
+			position += 2 + ReadLittleEndian16(archive + position);
+		}
+
+		// The original file name and the comment are zero-terminated.
+		for (uint8_t stringFlag : { GZIP_FLAG_NAME, GZIP_FLAG_COMMENT })
+		{
+			if ((flags & stringFlag) == 0)
+				continue;
+
+			while (position < dataEnd && archive[position] != 0)
+				position++;
+
+			position++;
+		}
+
+		if ((flags & GZIP_FLAG_HEADER_CRC) != 0)
+			position += 2;
+
+		if (position > dataEnd)
+			return false;
+
+		// Only the first member of the file is read, which is all gzip produces for a single file.
+		uint32_t expectedCRC = ReadLittleEndian32(archive + dataEnd);
+		uint32_t expectedSize = ReadLittleEndian32(archive + dataEnd + 4);
+
+		if (expectedSize > MAX_ROM_SIZE)
+			return false;
+
+		rom.reserve(expectedSize);
+		if (!Inflate(archive + position, dataEnd - position, rom, MAX_ROM_SIZE))
+			return false;
+
+		return rom.size() == expectedSize && Hashing::ComputeCRC32(rom.data(), rom.size()) == expectedCRC;
+	}
+
+	bool HasROMFileExtension(const std::string& fileName)
+	{
+		std::string lowerCaseFileName = fileName;
+		std::transform(lowerCaseFileName.begin(), lowerCaseFileName.end(), lowerCaseFileName.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+		return std::any_of(ROM_FILE_EXTENSIONS.begin(), ROM_FILE_EXTENSIONS.end(), [&lowerCaseFileName](const std::string& extension)
+			{
+				return lowerCaseFileName.size() > extension.size() && lowerCaseFileName.ends_with(extension);
+			});
+	}
+
+	bool ExtractFromZip(const uint8_t* archive, size_t archiveSize, std::vector<uint8_t>& rom)
+	{
+		// The end of central directory record is at the very end, unless the archive has a comment.
+		if (archiveSize < ZIP_END_OF_CENTRAL_DIRECTORY_SIZE)
+			return false;
+
+		size_t endOfCentralDirectory = archiveSize - ZIP_END_OF_CENTRAL_DIRECTORY_SIZE;
+		size_t searchLimit = endOfCentralDirectory > ZIP_MAX_COMMENT_SIZE ? endOfCentralDirectory - ZIP_MAX_COMMENT_SIZE : 0;
+
+		while (ReadLittleEndian32(archive + endOfCentralDirectory) != ZIP_END_OF_CENTRAL_DIRECTORY_SIGNATURE)
+		{
+			if (endOfCentralDirectory == searchLimit)
+				return false;
+
+			endOfCentralDirectory--;
+		}
+
+		uint16_t entryCount = ReadLittleEndian16(archive + endOfCentralDirectory + 10);
+		size_t position = ReadLittleEndian32(archive + endOfCentralDirectory + 16);
+
+		// Pick the first ROM in the archive, or the first file if none of them has a ROM extension.
+		const uint8_t* selectedEntry = nullptr;
+		for (uint16_t i = 0; i < entryCount; i++)
+		{
+			if (position + ZIP_CENTRAL_HEADER_SIZE > endOfCentralDirectory || ReadLittleEndian32(archive + position) != ZIP_CENTRAL_HEADER_SIGNATURE)
+				return false;
+
+			const uint8_t* entry = archive + position;
+			uint16_t nameLength = ReadLittleEndian16(entry + 28);
+			size_t entrySize = ZIP_CENTRAL_HEADER_SIZE + nameLength + ReadLittleEndian16(entry + 30) + ReadLittleEndian16(entry + 32);
+
+			if (position + entrySize > endOfCentralDirectory)
+				return false;
+
+			std::string name(reinterpret_cast<const char*>(entry + ZIP_CENTRAL_HEADER_SIZE), nameLength);
+			bool isDirectory = !name.empty() && name.back() == '/';
+
+			if (!isDirectory && (selectedEntry == nullptr || HasROMFileExtension(name)))
+			{
+				selectedEntry = entry;
+
+				if (HasROMFileExtension(name))
+					break;
+			}
+
+			position += entrySize;
+		}
+
+		if (selectedEntry == nullptr)
+			return false;
+
+		uint16_t flags = ReadLittleEndian16(selectedEntry + 8);
+		uint16_t method = ReadLittleEndian16(selectedEntry + 10);
+		uint32_t expectedCRC = ReadLittleEndian32(selectedEntry + 16);
+		uint32_t compressedSize = ReadLittleEndian32(selectedEntry + 20);
+		uint32_t uncompressedSize = ReadLittleEndian32(selectedEntry + 24);
+		size_t localHeader = ReadLittleEndian32(selectedEntry + 42);
+
+		if ((flags & ZIP_FLAG_ENCRYPTED) != 0)
+		{
+			Logger::WriteError("Encrypted zip archives are not supported.", DECOMPRESSION_LOG_HEADER);
+			return false;
+		}
+
+		if (uncompressedSize > MAX_ROM_SIZE || localHeader + ZIP_LOCAL_HEADER_SIZE > archiveSize || ReadLittleEndian32(archive + localHeader) != ZIP_LOCAL_HEADER_SIGNATURE)
+			return false;
+
+		// The local header can have a different extra field than the central one, so the data offset is taken from it.
+		size_t dataStart = localHeader + ZIP_LOCAL_HEADER_SIZE + ReadLittleEndian16(archive + localHeader + 26) + ReadLittleEndian16(archive + localHeader + 28);
+
+		if (dataStart + compressedSize > archiveSize)
+			return false;
+
+		switch (method)
+		{
+		case ZIP_STORED_METHOD:
+			rom.assign(archive + dataStart, archive + dataStart + compressedSize);
+			break;
+		case ZIP_DEFLATE_METHOD:
+			rom.reserve(uncompressedSize);
+			if (!Inflate(archive + dataStart, compressedSize, rom, MAX_ROM_SIZE))
+				return false;
+			break;
+		default:
+			Logger::WriteError("Unsupported zip compression method: " + std::to_string(method), DECOMPRESSION_LOG_HEADER);
+			return false;
+		}
+
+		return rom.size() == uncompressedSize && Hashing::ComputeCRC32(rom.data(), rom.size()) == expectedCRC;
+	}
+
+	bool ExtractROM(const uint8_t* archive, size_t archiveSize, std::vector<uint8_t>& rom)
+	{
+		rom.clear();
+		bool isExtracted = false;
+
+		if (IsGzip(archive, archiveSize))
+			isExtracted = ExtractFromGzip(archive, archiveSize, rom);
+		else if (IsZip(archive, archiveSize))
+			isExtracted = ExtractFromZip(archive, archiveSize, rom);
+
+		if (!isExtracted)
+		{
+			Logger::WriteError("Failed to extract the ROM from the archive, it is either corrupted or not supported.", DECOMPRESSION_LOG_HEADER);
+			rom.clear();
+		}
+
+		return isExtracted;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include <algorithm>
+#include <cstring>
+#include "Utils/DeltaCompression.hpp"
+
+namespace ModestGB::DeltaCompression
+{
+	// Short gaps of unchanged bytes are cheaper to store as part of the changed bytes than as a new run (which costs at least 2 bytes).
+	const size_t MIN_UNCHANGED_RUN_LENGTH = 4;
+
+	void WriteVariableLengthInteger(std::vector<uint8_t>& output, size_t value)
+	{
+		while (value >= 0x80)
+		{
+			output.push_back(static_cast<uint8_t>(value | 0x80));
+			value >>= 7;
+		}
+
+		output.push_back(static_cast<uint8_t>(value));
+	}
+
+	bool ReadVariableLengthInteger(const uint8_t* input, size_t inputSize, size_t& position, size_t& value)
+	{
+		value = 0;
+
+		for (uint8_t shift = 0; shift < 64; shift += 7)
+		{
+			if (position >= inputSize)
+				return false;
+
+			uint8_t data = input[position++];
+			value |= static_cast<size_t>(data & 0x7F) << shift;
+
+			if ((data & 0x80) == 0)
+				return true;
+		}
+
+		return false;
+	}
+
+	void EncodeXORDelta(const uint8_t* current, size_t currentSize, const uint8_t* previous, size_t previousSize, std::vector<uint8_t>& delta)
+	{
+		size_t length = std::max(currentSize, previousSize);
+		size_t commonSize = std::min(currentSize, previousSize);
+		size_t position = 0;
+
+		auto getXORByte = [&](size_t index)
+		{
+			return static_cast<uint8_t>((index < currentSize ? current[index] : 0) ^ (index < previousSize ? previous[index] : 0));
+		};
+
+		delta.clear();
+
+		while (position < length)
+		{
+			size_t unchangedStart = position;
+
+			// Most of the state doesn't change between two snapshots, so unchanged bytes are skipped 8 at a time first.
+			while (position + 8 <= commonSize && std::memcmp(current + position, previous + position, 8) == 0)
+				position += 8;
+
+			while (position < length && getXORByte(position) == 0)
+				position++;
+
+			size_t changedStart = position;
+			size_t unchangedCount = 0;
+
+			while (position < length && unchangedCount < MIN_UNCHANGED_RUN_LENGTH)
+			{
+				unchangedCount = getXORByte(position) == 0 ? unchangedCount + 1 : 0;
+				position++;
+			}
+
+			// The unchanged bytes that ended the run are part of the next one.
+			position -= unchangedCount;
+
+			WriteVariableLengthInteger(delta, changedStart - unchangedStart);
+			WriteVariableLengthInteger(delta, position - changedStart);
+
+			for (size_t i = changedStart; i < position; i++)
+				delta.push_back(getXORByte(i));
+		}
+	}
+
+	bool ApplyXORDelta(const uint8_t* delta, size_t deltaSize, std::vector<uint8_t>& state, size_t resultSize)
+	{
+		size_t length = std::max(state.size(), resultSize);
+		size_t readPosition = 0;
+		size_t position = 0;
+
+		state.resize(length, 0);
+
+		while (readPosition < deltaSize)
+		{
+			size_t unchangedCount = 0;
+			size_t changedCount = 0;
+
+			if (!ReadVariableLengthInteger(delta, deltaSize, readPosition, unchangedCount) || !ReadVariableLengthInteger(delta, deltaSize, readPosition, changedCount))
+				return false;
+
+			if (unchangedCount > length - position || changedCount > length - position - unchangedCount || changedCount > deltaSize - readPosition)
+				return false;
+
+			position += unchangedCount;
+
+			for (size_t i = 0; i < changedCount; i++)
+				state[position + i] ^= delta[readPosition + i];
+
+			position += changedCount;
+			readPosition += changedCount;
+		}
+
+		state.resize(resultSize);
+		return true;
+	}
+}
\ No newline at end of file
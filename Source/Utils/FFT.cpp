@@ -0,0 +1,64 @@
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <numbers>
+#include "Utils/FFT.hpp"
+
+namespace ModestGB::FFT
+{
+	// Anything quieter than this is clamped, so silence doesn't produce -infinity.
+	const float MIN_MAGNITUDE_DB = -120.0f;
+
+	void ComputeMagnitudeSpectrum(const std::vector<float>& samples, std::vector<float>& magnitudes)
+	{
+		size_t size = samples.size();
+		std::vector<std::complex<float>> bins(size);
+
+		// Windowing keeps the signal from leaking into every bin, since it's unlikely to contain a whole number of periods.
+		for (size_t i = 0; i < size; i++)
+		{
+			float window = 0.5f - 0.5f * std::cos(2 * std::numbers::pi_v<float> * i / size);
+			bins[i] = samples[i] * window;
+		}
+
+		// Iterative radix-2 FFT. Bit-reverse the input first, so that each pass can be done in place.
+		for (size_t i = 1, j = 0; i < size; i++)
+		{
+			size_t bit = size >> 1;
+			for (; j & bit; bit >>= 1)
+				j ^= bit;
+
+			j ^= bit;
+
+			if (i < j)
+				std::swap(bins[i], bins[j]);
+		}
+
+		for (size_t length = 2; length <= size; length <<= 1)
+		{
+			std::complex<float> rootOfUnity = std::polar(1.0f, -2 * std::numbers::pi_v<float> / length);
+
+			for (size_t start = 0; start < size; start += length)
+			{
+				std::complex<float> twiddle = 1;
+
+				for (size_t k = 0; k < length / 2; k++)
+				{
+					std::complex<float> even = bins[start + k];
+					std::complex<float> odd = bins[start + k + length / 2] * twiddle;
+					bins[start + k] = even + odd;
+					bins[start + k + length / 2] = even - odd;
+					twiddle *= rootOfUnity;
+				}
+			}
+		}
+
+		// The Hann window halves the amplitude, hence the 4 instead of 2.
+		magnitudes.resize(size / 2);
+		for (size_t i = 0; i < size / 2; i++)
+		{
+			float magnitude = std::abs(bins[i]) * 4 / size;
+			magnitudes[i] = std::max(20 * std::log10(magnitude), MIN_MAGNITUDE_DB);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,19 @@
+#include <filesystem>
+#include "Utils/FileStamp.hpp"
+
+namespace ModestGB
+{
+	bool FileStamp::Get(const std::string& filePath, FileStamp& stamp)
+	{
+		std::error_code error;
+		stamp.canonicalPath = std::filesystem::weakly_canonical(filePath, error).string();
+
+		if (!error)
+			stamp.size = std::filesystem::file_size(filePath, error);
+
+		if (!error)
+			stamp.lastWriteTime = std::filesystem::last_write_time(filePath, error).time_since_epoch().count();
+
+		return !error;
+	}
+}
\ No newline at end of file
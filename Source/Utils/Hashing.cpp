@@ -0,0 +1,51 @@
+#include <array>
+#include "Utils/Hashing.hpp"
+
+namespace ModestGB::Hashing
+{
+	const uint64_t FNV1A_OFFSET_BASIS = 0xCBF29CE484222325;
+	const uint64_t FNV1A_PRIME = 0x100000001B3;
+
+	// The reversed form of the polynomial, since the CRC is computed least significant bit first.
+	const uint32_t CRC32_POLYNOMIAL = 0xEDB88320;
+
+	// The CRC of every possible byte, so the CRC is updated a whole byte at a time.
+	const std::array<uint32_t, 256> CRC32_TABLE = []()
+	{
+		std::array<uint32_t, 256> table{};
+
+		for (uint32_t byte = 0; byte < table.size(); byte++)
+		{
+			uint32_t crc = byte;
+			for (uint8_t bit = 0; bit < 8; bit++)
+				crc = (crc & 1) != 0 ? (crc >> 1) ^ CRC32_POLYNOMIAL : crc >> 1;
+
+			table[byte] = crc;
+		}
+
+		return table;
+	}();
+
+	uint64_t ComputeFNV1a(const uint8_t* data, size_t size)
+	{
+		uint64_t hash = FNV1A_OFFSET_BASIS;
+
+		for (size_t i = 0; i < size; i++)
+		{
+			hash ^= data[i];
+			hash *= FNV1A_PRIME;
+		}
+
+		return hash;
+	}
+
+	uint32_t ComputeCRC32(const uint8_t* data, size_t size)
+	{
+		uint32_t crc = 0xFFFFFFFF;
+
+		for (size_t i = 0; i < size; i++)
+			crc = CRC32_TABLE[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+
+		return ~crc;
+	}
+}
\ No newline at end of file
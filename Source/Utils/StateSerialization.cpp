@@ -0,0 +1,183 @@
+#include "Utils/StateSerialization.hpp"
+#include "Logger.hpp"
+
+namespace ModestGB
+{
+	const std::string SAVE_STATE_MESSAGE_HEADER = "[SAVE STATE]";
+
+	StateWriter::StateWriter(std::vector<uint8_t>& buffer) : buffer(&buffer)
+	{
+	}
+
+	StateWriter::StateWriter(MachineSnapshot& snapshot) : buffer(&snapshot.state), sharedMemories(&snapshot.memories)
+	{
+		// Clearing keeps the capacity, so a reused snapshot doesn't allocate either.
+		sharedMemories->clear();
+	}
+
+	void StateWriter::WriteHeader()
+	{
+		Write(SAVE_STATE_MAGIC);
+		Write(SAVE_STATE_VERSION);
+
+		// The payload size is filled in by Finish().
+		Write(static_cast<uint64_t>(0));
+		payloadStart = position;
+	}
+
+	void StateWriter::Finish()
+	{
+		if (payloadStart != 0)
+		{
+			uint64_t payloadSize = position - payloadStart;
+			std::memcpy(buffer->data() + payloadStart - sizeof(uint64_t), &payloadSize, sizeof(uint64_t));
+		}
+
+		buffer->resize(position);
+	}
+
+	size_t StateWriter::GetSize() const
+	{
+		return position;
+	}
+
+	void StateWriter::Write(const std::string& value)
+	{
+		Write(static_cast<uint32_t>(value.size()));
+		WriteBytes(value.data(), value.size());
+	}
+
+	void StateWriter::Write(const PagedBuffer& memory)
+	{
+		Write(static_cast<uint32_t>(memory.GetSize()));
+
+		if (sharedMemories != nullptr)
+		{
+			sharedMemories->push_back(memory);
+			return;
+		}
+
+		if (position + memory.GetSize() > buffer->size())
+			buffer->resize(std::max(buffer->size() * 2, position + memory.GetSize()));
+
+		memory.ReadBlock(0, buffer->data() + position, memory.GetSize());
+		position += memory.GetSize();
+	}
+
+	StateReader::StateReader(const uint8_t* data, size_t size) : data(data), size(size)
+	{
+	}
+
+	StateReader::StateReader(const MachineSnapshot& snapshot) : data(snapshot.state.data()), size(snapshot.state.size()), sharedMemories(&snapshot.memories)
+	{
+	}
+
+	bool StateReader::ReadHeader()
+	{
+		uint32_t magic = Read<uint32_t>();
+		version = Read<uint32_t>();
+		uint64_t payloadSize = Read<uint64_t>();
+
+		if (hasFailed || magic != SAVE_STATE_MAGIC)
+		{
+			Logger::WriteError("The data is not a save state.", SAVE_STATE_MESSAGE_HEADER);
+			Fail();
+			return false;
+		}
+
+		if (version < MIN_SUPPORTED_SAVE_STATE_VERSION || version > SAVE_STATE_VERSION)
+		{
+			Logger::WriteError("Unsupported save state version: " + std::to_string(version), SAVE_STATE_MESSAGE_HEADER);
+			Fail();
+			return false;
+		}
+
+		// Checking the size up front means a truncated state is rejected before anything is overwritten.
+		if (payloadSize != size - position)
+		{
+			Logger::WriteError("The save state is incomplete.", SAVE_STATE_MESSAGE_HEADER);
+			Fail();
+			return false;
+		}
+
+		return true;
+	}
+
+	uint32_t StateReader::GetVersion() const
+	{
+		return version;
+	}
+
+	bool StateReader::HasFailed() const
+	{
+		return hasFailed;
+	}
+
+	bool StateReader::IsAtEnd() const
+	{
+		return position == size;
+	}
+
+	void StateReader::Fail()
+	{
+		hasFailed = true;
+	}
+
+	void StateReader::Read(std::string& value)
+	{
+		uint32_t length = Read<uint32_t>();
+
+		if (hasFailed || position + length > size)
+		{
+			hasFailed = true;
+			value.clear();
+			return;
+		}
+
+		value.assign(reinterpret_cast<const char*>(data + position), length);
+		position += length;
+	}
+
+	void StateReader::Skip(size_t length)
+	{
+		if (hasFailed || position + length > size)
+		{
+			hasFailed = true;
+			return;
+		}
+
+		position += length;
+	}
+
+	void StateReader::Read(PagedBuffer& memory)
+	{
+		uint32_t memorySize = Read<uint32_t>();
+
+		if (hasFailed || memorySize != memory.GetSize())
+		{
+			hasFailed = true;
+			return;
+		}
+
+		if (sharedMemories != nullptr)
+		{
+			if (sharedMemoryIndex >= sharedMemories->size() || (*sharedMemories)[sharedMemoryIndex].GetSize() != memorySize)
+			{
+				hasFailed = true;
+				return;
+			}
+
+			memory = (*sharedMemories)[sharedMemoryIndex++];
+			return;
+		}
+
+		if (position + memorySize > size)
+		{
+			hasFailed = true;
+			return;
+		}
+
+		memory.WriteBlock(0, data + position, memorySize);
+		position += memorySize;
+	}
+}
\ No newline at end of file
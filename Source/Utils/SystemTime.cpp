@@ -1,11 +1,12 @@
 #include <ctime>
 #include <locale>
 #include <chrono>
+#include <algorithm>
 #include "Utils/SystemTime.hpp"
 
 namespace ModestGB::SystemTime
 {
-	DateTime ModestGB::SystemTime::GetCurrentTime()
+	DateTime GetCurrentTime()
 	{
 		std::time_t rawTime = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
 		std::tm dateTime{};
@@ -13,7 +14,7 @@ namespace ModestGB::SystemTime
 		// Some compilers complain about localtime() being unsafe due to thread-safety issues, 
 		// so depending on the platform, use the respective safe alternative.
 #if defined(__unix__)
-		localtime_r(&rawTime, &dateTime)
+		localtime_r(&rawTime, &dateTime);
 #elif defined(_MSC_VER)
 		localtime_s(&dateTime, &rawTime);
 #else
@@ -30,4 +31,9 @@ namespace ModestGB::SystemTime
 			.year = dateTime.tm_year + 1900
 		};
 	}
+
+	int64_t GetUnixTime()
+	{
+		return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+	}
 }
\ No newline at end of file